@@ -0,0 +1,103 @@
+#include <GameLib/GameParameters.h>
+#include <GameLib/IGameEventHandler.h>
+#include <GameLib/Physics.h>
+#include <GameLib/ResourceLoader.h>
+#include <GameLib/ShipBuilder.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+//
+// Compares the cost of whole ship steps with the explicit solver against
+// those with the position-based one, on the bundled ships.
+//
+// Also reports the average strain of the springs once the ship has settled
+// in the water, which tells how rigid each solver keeps the structure at
+// the specified stiffness adjustment.
+//
+// Expects the Data and Ships directories in the working directory.
+//
+
+static float CalculateAverageStrain(Physics::Ship const & ship)
+{
+    auto const & points = ship.GetPoints();
+    auto const & springs = ship.GetSprings();
+
+    float totalStrain = 0.0f;
+    size_t springCount = 0;
+    for (auto springIndex : springs)
+    {
+        if (!springs.IsDeleted(springIndex))
+        {
+            float const length = (springs.GetPointAPosition(springIndex, points) - springs.GetPointBPosition(springIndex, points)).length();
+            totalStrain += std::abs(length - springs.GetRestLength(springIndex)) / springs.GetRestLength(springIndex);
+            ++springCount;
+        }
+    }
+
+    return springCount > 0 ? totalStrain / static_cast<float>(springCount) : 0.0f;
+}
+
+static void MechanicalDynamics(
+    benchmark::State & state,
+    std::string const & shipFileName,
+    bool usePositionBasedMechanicalSolver,
+    float stiffnessAdjustment)
+{
+    // The number of steps after which ships are afloat and at rest
+    static constexpr int SettlingStepsCount = 250;
+
+    ResourceLoader resourceLoader;
+    MaterialDatabase materials = resourceLoader.LoadMaterials();
+    ShipDefinition shipDefinition = resourceLoader.LoadShipDefinition(std::filesystem::path("Ships") / shipFileName);
+
+    GameParameters gameParameters;
+    gameParameters.UsePositionBasedMechanicalSolver = usePositionBasedMechanicalSolver;
+    gameParameters.StiffnessAdjustment = stiffnessAdjustment;
+
+    auto gameEventHandler = std::make_shared<IGameEventHandler>();
+
+    Physics::World world(
+        gameEventHandler,
+        gameParameters);
+
+    VisitSequenceNumber visitSequenceNumber = 1u;
+
+    auto ship = ShipBuilder::Create(
+        0,
+        world,
+        gameEventHandler,
+        shipDefinition,
+        materials,
+        gameParameters,
+        visitSequenceNumber);
+
+    // Let the ship settle on its solver
+    for (int s = 0; s < SettlingStepsCount; ++s)
+    {
+        ship->Update(++visitSequenceNumber, gameParameters);
+    }
+
+    float const averageStrain = CalculateAverageStrain(*ship);
+
+    for (auto _ : state)
+    {
+        ship->Update(++visitSequenceNumber, gameParameters);
+    }
+
+    state.counters["Points"] = static_cast<double>(ship->GetPoints().GetElementCount());
+    state.counters["AverageStrain"] = static_cast<double>(averageStrain);
+}
+
+BENCHMARK_CAPTURE(MechanicalDynamics, Explicit_CarnivalDream, std::string("Carnival Dream.shp"), false, 1.0f);
+BENCHMARK_CAPTURE(MechanicalDynamics, PositionBased_CarnivalDream, std::string("Carnival Dream.shp"), true, 1.0f);
+BENCHMARK_CAPTURE(MechanicalDynamics, Explicit_Stiff_CarnivalDream, std::string("Carnival Dream.shp"), false, GameParameters::MaxStiffnessAdjustment);
+BENCHMARK_CAPTURE(MechanicalDynamics, PositionBased_Stiff_CarnivalDream, std::string("Carnival Dream.shp"), true, GameParameters::MaxPositionBasedStiffnessAdjustment);
+BENCHMARK_CAPTURE(MechanicalDynamics, Explicit_ContainerShip, std::string("Container Ship.shp"), false, 1.0f);
+BENCHMARK_CAPTURE(MechanicalDynamics, PositionBased_ContainerShip, std::string("Container Ship.shp"), true, 1.0f);
+BENCHMARK_CAPTURE(MechanicalDynamics, Explicit_RMSTitanic, std::string("RMS Titanic.shp"), false, 1.0f);
+BENCHMARK_CAPTURE(MechanicalDynamics, PositionBased_RMSTitanic, std::string("RMS Titanic.shp"), true, 1.0f);
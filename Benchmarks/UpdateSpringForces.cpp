@@ -1,5 +1,6 @@
 #include "Utils.h"
 
+#include <GameLib/Algorithms.h>
 #include <GameLib/SysSpecifics.h>
 
 // TODO: move to GameLib's LibSimdPp.h
@@ -264,3 +265,36 @@ static void UpdateSpringForces_LibSimdPpAndIntrinsics(benchmark::State& state)
 }
 BENCHMARK(UpdateSpringForces_LibSimdPpAndIntrinsics);
 
+
+static void UpdateSpringForces_Algorithms(benchmark::State& state)
+{
+    auto const size = MakeSize(SampleSize);
+
+    std::vector<vec2f> pointsPosition;
+    std::vector<vec2f> pointsVelocity;
+    std::vector<vec2f> pointsForce;
+    std::vector<SpringEndpoints> springsEndpoints;
+    std::vector<float> springsStiffnessCoefficient;
+    std::vector<float> springsDamperCoefficient;
+    std::vector<float> springsRestLength;
+
+    MakeGraph2(size, pointsPosition, pointsVelocity, pointsForce,
+        springsEndpoints, springsStiffnessCoefficient, springsDamperCoefficient, springsRestLength);
+
+    for (auto _ : state)
+    {
+        Algorithms::UpdateSpringForces(
+            0,
+            static_cast<ElementIndex>(springsEndpoints.size()),
+            reinterpret_cast<ElementIndex const *>(springsEndpoints.data()),
+            springsRestLength.data(),
+            springsStiffnessCoefficient.data(),
+            springsDamperCoefficient.data(),
+            pointsPosition.data(),
+            pointsVelocity.data(),
+            pointsForce.data());
+    }
+
+    benchmark::DoNotOptimize(pointsForce);
+}
+BENCHMARK(UpdateSpringForces_Algorithms);
@@ -23,6 +23,18 @@ public:
         , BottomLeft(bottomLeft)
     {}
 
+    void ExtendTo(vec2f const & point)
+    {
+        if (point.x > TopRight.x)
+            TopRight.x = point.x;
+        if (point.y > TopRight.y)
+            TopRight.y = point.y;
+        if (point.x < BottomLeft.x)
+            BottomLeft.x = point.x;
+        if (point.y < BottomLeft.y)
+            BottomLeft.y = point.y;
+    }
+
     void ExtendTo(AABB const & other)
     {
         if (other.TopRight.x > TopRight.x)
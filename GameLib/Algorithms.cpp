@@ -0,0 +1,1930 @@
+/***************************************************************************************
+* Original Author:      agent
+* Created:              2026-10-17
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "Algorithms.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace Algorithms {
+
+namespace /* anonymous */ {
+
+    /*
+     * Applies the forces calculated for a packet of springs to their endpoints.
+     *
+     * This must be done one spring at a time, as springs in the same packet
+     * might share endpoints.
+     */
+    template<size_t PacketSize>
+    inline void ScatterSpringForces(
+        ElementIndex springStart,
+        ElementIndex const * restrict springEndpointsBuffer,
+        float const * restrict fX,
+        float const * restrict fY,
+        vec2f * restrict pointForceBuffer)
+    {
+        for (size_t i = 0; i < PacketSize; ++i)
+        {
+            ElementIndex const pointAIndex = springEndpointsBuffer[(springStart + i) * 2];
+            ElementIndex const pointBIndex = springEndpointsBuffer[(springStart + i) * 2 + 1];
+
+            pointForceBuffer[pointAIndex].x += fX[i];
+            pointForceBuffer[pointAIndex].y += fY[i];
+            pointForceBuffer[pointBIndex].x -= fX[i];
+            pointForceBuffer[pointBIndex].y -= fY[i];
+        }
+    }
+
+    /*
+     * Calculates and stores the geometry of a single spring, returning its length.
+     */
+    inline float CalculateSingleSpringGeometry(
+        ElementIndex springIndex,
+        ElementIndex const * restrict springEndpointsBuffer,
+        vec2f const * restrict pointPositionBuffer,
+        float * restrict springLengthBuffer,
+        vec2f * restrict springNormalizedVectorBuffer,
+        MathQuality mathQuality)
+    {
+        vec2f const displacement =
+            pointPositionBuffer[springEndpointsBuffer[springIndex * 2 + 1]]
+            - pointPositionBuffer[springEndpointsBuffer[springIndex * 2]];
+
+        if (mathQuality == MathQuality::Fast)
+        {
+            // Zero-length springs get a zero normalized vector, as 0 * 1/sqrt(min) = 0
+            float const displacementSquareLength = displacement.squareLength();
+            float const inverseDisplacementLength = FastInverseSqrt(std::max(displacementSquareLength, std::numeric_limits<float>::min()));
+
+            float const displacementLength = displacementSquareLength * inverseDisplacementLength;
+            springLengthBuffer[springIndex] = displacementLength;
+            springNormalizedVectorBuffer[springIndex] = displacement * inverseDisplacementLength;
+
+            return displacementLength;
+        }
+        else
+        {
+            float const displacementLength = displacement.length();
+
+            springLengthBuffer[springIndex] = displacementLength;
+            springNormalizedVectorBuffer[springIndex] = displacement.normalise(displacementLength);
+
+            return displacementLength;
+        }
+    }
+
+    /*
+     * Calculates and stores the geometry of a packet of four springs, returning their lengths.
+     */
+    inline __m128 CalculateSpringGeometryPacket_SSE2(
+        ElementIndex springStart,
+        ElementIndex const * restrict springEndpointsBuffer,
+        vec2f const * restrict pointPositionBuffer,
+        float * restrict springLengthBuffer,
+        float * restrict normalizedVectorBuffer,
+        MathQuality mathQuality)
+    {
+        ElementIndex const * restrict const endpoints = &(springEndpointsBuffer[springStart * 2]);
+
+        //
+        // Load positions - no gather in SSE, hence two floats at a time
+        //
+
+#define LOAD_VEC2F(buffer, index) \
+    _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(&(buffer[index]))))
+
+        __m128 const s0s1_pA_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[0]), LOAD_VEC2F(pointPositionBuffer, endpoints[2])); // x0,y0,x1,y1
+        __m128 const s2s3_pA_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[4]), LOAD_VEC2F(pointPositionBuffer, endpoints[6])); // x2,y2,x3,y3
+        __m128 const s0s1_pB_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[1]), LOAD_VEC2F(pointPositionBuffer, endpoints[3]));
+        __m128 const s2s3_pB_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[5]), LOAD_VEC2F(pointPositionBuffer, endpoints[7]));
+
+#undef LOAD_VEC2F
+
+        __m128 const s0s1_deltaPos = _mm_sub_ps(s0s1_pB_pos, s0s1_pA_pos);
+        __m128 const s2s3_deltaPos = _mm_sub_ps(s2s3_pB_pos, s2s3_pA_pos);
+        __m128 const deltaPosX = _mm_shuffle_ps(s0s1_deltaPos, s2s3_deltaPos, _MM_SHUFFLE(2, 0, 2, 0)); // x0,x1,x2,x3
+        __m128 const deltaPosY = _mm_shuffle_ps(s0s1_deltaPos, s2s3_deltaPos, _MM_SHUFFLE(3, 1, 3, 1)); // y0,y1,y2,y3
+
+        // Normalized spring vector; zero for zero-length springs
+        __m128 const springSquareLength = _mm_add_ps(_mm_mul_ps(deltaPosX, deltaPosX), _mm_mul_ps(deltaPosY, deltaPosY));
+        __m128 springLength;
+        __m128 springDirX;
+        __m128 springDirY;
+        if (mathQuality == MathQuality::Fast)
+        {
+            // 0 * 1/sqrt(min) = 0
+            __m128 const inverseSpringLength = FastInverseSqrt(_mm_max_ps(springSquareLength, _mm_set1_ps(std::numeric_limits<float>::min())));
+            springLength = _mm_mul_ps(springSquareLength, inverseSpringLength);
+            springDirX = _mm_mul_ps(deltaPosX, inverseSpringLength);
+            springDirY = _mm_mul_ps(deltaPosY, inverseSpringLength);
+        }
+        else
+        {
+            springLength = _mm_sqrt_ps(springSquareLength);
+            __m128 const validMask = _mm_cmpgt_ps(springLength, _mm_setzero_ps());
+            springDirX = _mm_and_ps(_mm_div_ps(deltaPosX, springLength), validMask);
+            springDirY = _mm_and_ps(_mm_div_ps(deltaPosY, springLength), validMask);
+        }
+
+        //
+        // Store, re-interleaving the normalized vectors
+        //
+
+        _mm_storeu_ps(&(springLengthBuffer[springStart]), springLength);
+        _mm_storeu_ps(&(normalizedVectorBuffer[springStart * 2]), _mm_unpacklo_ps(springDirX, springDirY)); // x0,y0,x1,y1
+        _mm_storeu_ps(&(normalizedVectorBuffer[springStart * 2 + 4]), _mm_unpackhi_ps(springDirX, springDirY)); // x2,y2,x3,y3
+
+        return springLength;
+    }
+
+    /*
+     * Calculates and stores the geometry of a packet of eight springs, returning their lengths.
+     */
+    TARGET_AVX2
+    inline __m256 CalculateSpringGeometryPacket_AVX2(
+        ElementIndex springStart,
+        ElementIndex const * restrict springEndpointsBuffer,
+        float const * restrict positionBuffer,
+        float * restrict springLengthBuffer,
+        float * restrict normalizedVectorBuffer,
+        MathQuality mathQuality)
+    {
+        // Moves the A's in the low lane and the B's in the high lane
+        __m256i const DeinterleaveEndpoints = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+        //
+        // Load endpoint indices, and turn them into float offsets
+        //
+
+        __m256i const endpoints0 = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&(springEndpointsBuffer[springStart * 2]))),
+            DeinterleaveEndpoints); // A0..A3,B0..B3
+        __m256i const endpoints1 = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&(springEndpointsBuffer[springStart * 2 + 8]))),
+            DeinterleaveEndpoints); // A4..A7,B4..B7
+
+        __m256i const pointAIndex = _mm256_permute2x128_si256(endpoints0, endpoints1, 0x20);
+        __m256i const pointBIndex = _mm256_permute2x128_si256(endpoints0, endpoints1, 0x31);
+        __m256i const pointAOffset = _mm256_add_epi32(pointAIndex, pointAIndex); // Two floats per vec2f
+        __m256i const pointBOffset = _mm256_add_epi32(pointBIndex, pointBIndex);
+
+        //
+        // Gather positions
+        //
+
+        __m256 const deltaPosX = _mm256_sub_ps(
+            _mm256_i32gather_ps(positionBuffer, pointBOffset, 4),
+            _mm256_i32gather_ps(positionBuffer, pointAOffset, 4));
+        __m256 const deltaPosY = _mm256_sub_ps(
+            _mm256_i32gather_ps(positionBuffer + 1, pointBOffset, 4),
+            _mm256_i32gather_ps(positionBuffer + 1, pointAOffset, 4));
+
+        // Normalized spring vector; zero for zero-length springs
+        __m256 const springSquareLength = _mm256_add_ps(_mm256_mul_ps(deltaPosX, deltaPosX), _mm256_mul_ps(deltaPosY, deltaPosY));
+        __m256 springLength;
+        __m256 springDirX;
+        __m256 springDirY;
+        if (mathQuality == MathQuality::Fast)
+        {
+            // 0 * 1/sqrt(min) = 0
+            __m256 const inverseSpringLength = FastInverseSqrt(_mm256_max_ps(springSquareLength, _mm256_set1_ps(std::numeric_limits<float>::min())));
+            springLength = _mm256_mul_ps(springSquareLength, inverseSpringLength);
+            springDirX = _mm256_mul_ps(deltaPosX, inverseSpringLength);
+            springDirY = _mm256_mul_ps(deltaPosY, inverseSpringLength);
+        }
+        else
+        {
+            springLength = _mm256_sqrt_ps(springSquareLength);
+            __m256 const validMask = _mm256_cmp_ps(springLength, _mm256_setzero_ps(), _CMP_GT_OQ);
+            springDirX = _mm256_and_ps(_mm256_div_ps(deltaPosX, springLength), validMask);
+            springDirY = _mm256_and_ps(_mm256_div_ps(deltaPosY, springLength), validMask);
+        }
+
+        //
+        // Store, re-interleaving the normalized vectors
+        //
+
+        __m256 const lo = _mm256_unpacklo_ps(springDirX, springDirY); // x0,y0,x1,y1,x4,y4,x5,y5
+        __m256 const hi = _mm256_unpackhi_ps(springDirX, springDirY); // x2,y2,x3,y3,x6,y6,x7,y7
+
+        _mm256_storeu_ps(&(springLengthBuffer[springStart]), springLength);
+        _mm256_storeu_ps(&(normalizedVectorBuffer[springStart * 2]), _mm256_permute2f128_ps(lo, hi, 0x20)); // x0,y0,..,x3,y3
+        _mm256_storeu_ps(&(normalizedVectorBuffer[springStart * 2 + 8]), _mm256_permute2f128_ps(lo, hi, 0x31)); // x4,y4,..,x7,y7
+
+        return springLength;
+    }
+
+    /*
+     * Appends to the index buffer the springs of a packet whose bit is set in the mask.
+     */
+    template<size_t PacketSize>
+    inline void AppendSpringIndices(
+        ElementIndex springStart,
+        int springMask,
+        ElementIndex * restrict springIndices,
+        ElementCount & springCount)
+    {
+        for (size_t i = 0; i < PacketSize; ++i)
+        {
+            if (0 != (springMask & (1 << i)))
+            {
+                springIndices[springCount++] = springStart + static_cast<ElementIndex>(i);
+            }
+        }
+    }
+}
+
+void UpdateSpringForces(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer)
+{
+    UpdateSpringForces(
+        GetInstructionSet(),
+        springStart,
+        springEnd,
+        springEndpointsBuffer,
+        springRestLengthBuffer,
+        springStiffnessCoefficientBuffer,
+        springDampingCoefficientBuffer,
+        pointPositionBuffer,
+        pointVelocityBuffer,
+        pointForceBuffer);
+}
+
+void UpdateSpringForces(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer)
+{
+    switch (instructionSet)
+    {
+        case InstructionSet::AVX512:
+        {
+            UpdateSpringForces_AVX512(
+                springStart, springEnd,
+                springEndpointsBuffer, springRestLengthBuffer, springStiffnessCoefficientBuffer, springDampingCoefficientBuffer,
+                pointPositionBuffer, pointVelocityBuffer, pointForceBuffer);
+
+            break;
+        }
+
+        case InstructionSet::AVX2:
+        {
+            UpdateSpringForces_AVX2(
+                springStart, springEnd,
+                springEndpointsBuffer, springRestLengthBuffer, springStiffnessCoefficientBuffer, springDampingCoefficientBuffer,
+                pointPositionBuffer, pointVelocityBuffer, pointForceBuffer);
+
+            break;
+        }
+
+        case InstructionSet::SSE2:
+        {
+            UpdateSpringForces_SSE2(
+                springStart, springEnd,
+                springEndpointsBuffer, springRestLengthBuffer, springStiffnessCoefficientBuffer, springDampingCoefficientBuffer,
+                pointPositionBuffer, pointVelocityBuffer, pointForceBuffer);
+
+            break;
+        }
+
+        case InstructionSet::Scalar:
+        {
+            UpdateSpringForces_Naive(
+                springStart, springEnd,
+                springEndpointsBuffer, springRestLengthBuffer, springStiffnessCoefficientBuffer, springDampingCoefficientBuffer,
+                pointPositionBuffer, pointVelocityBuffer, pointForceBuffer);
+
+            break;
+        }
+    }
+}
+
+void UpdateSpringForces_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer)
+{
+    for (ElementIndex springIndex = springStart; springIndex < springEnd; ++springIndex)
+    {
+        auto const pointAIndex = springEndpointsBuffer[springIndex * 2];
+        auto const pointBIndex = springEndpointsBuffer[springIndex * 2 + 1];
+
+        vec2f const displacement = pointPositionBuffer[pointBIndex] - pointPositionBuffer[pointAIndex];
+        float const displacementLength = displacement.length();
+        vec2f const springDir = displacement.normalise(displacementLength);
+
+        //
+        // 1. Hooke's law
+        //
+
+        // Calculate spring force on point A
+        vec2f const fSpringA =
+            springDir
+            * (displacementLength - springRestLengthBuffer[springIndex])
+            * springStiffnessCoefficientBuffer[springIndex];
+
+
+        //
+        // 2. Damper forces
+        //
+        // Damp the velocities of the two points, as if the points were also connected by a damper
+        // along the same direction as the spring
+        //
+
+        // Calculate damp force on point A
+        vec2f const relVelocity = pointVelocityBuffer[pointBIndex] - pointVelocityBuffer[pointAIndex];
+        vec2f const fDampA =
+            springDir
+            * relVelocity.dot(springDir)
+            * springDampingCoefficientBuffer[springIndex];
+
+
+        //
+        // Apply forces
+        //
+
+        pointForceBuffer[pointAIndex] += fSpringA + fDampA;
+        pointForceBuffer[pointBIndex] -= fSpringA + fDampA;
+    }
+}
+
+void UpdateSpringForces_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer)
+{
+    static constexpr size_t PacketSize = 4;
+
+    __m128 const Zero = _mm_setzero_ps();
+
+    alignas(16) float fX[PacketSize];
+    alignas(16) float fY[PacketSize];
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        ElementIndex const * restrict const endpoints = &(springEndpointsBuffer[s * 2]);
+
+        //
+        // Load positions and velocities - no gather in SSE, hence two floats at a time
+        //
+
+#define LOAD_VEC2F(buffer, index) \
+    _mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(&(buffer[index]))))
+
+        __m128 const s0s1_pA_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[0]), LOAD_VEC2F(pointPositionBuffer, endpoints[2])); // x0,y0,x1,y1
+        __m128 const s2s3_pA_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[4]), LOAD_VEC2F(pointPositionBuffer, endpoints[6])); // x2,y2,x3,y3
+        __m128 const s0s1_pB_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[1]), LOAD_VEC2F(pointPositionBuffer, endpoints[3]));
+        __m128 const s2s3_pB_pos = _mm_movelh_ps(LOAD_VEC2F(pointPositionBuffer, endpoints[5]), LOAD_VEC2F(pointPositionBuffer, endpoints[7]));
+
+        __m128 const s0s1_pA_vel = _mm_movelh_ps(LOAD_VEC2F(pointVelocityBuffer, endpoints[0]), LOAD_VEC2F(pointVelocityBuffer, endpoints[2]));
+        __m128 const s2s3_pA_vel = _mm_movelh_ps(LOAD_VEC2F(pointVelocityBuffer, endpoints[4]), LOAD_VEC2F(pointVelocityBuffer, endpoints[6]));
+        __m128 const s0s1_pB_vel = _mm_movelh_ps(LOAD_VEC2F(pointVelocityBuffer, endpoints[1]), LOAD_VEC2F(pointVelocityBuffer, endpoints[3]));
+        __m128 const s2s3_pB_vel = _mm_movelh_ps(LOAD_VEC2F(pointVelocityBuffer, endpoints[5]), LOAD_VEC2F(pointVelocityBuffer, endpoints[7]));
+
+#undef LOAD_VEC2F
+
+        __m128 const s0s1_deltaPos = _mm_sub_ps(s0s1_pB_pos, s0s1_pA_pos);
+        __m128 const s2s3_deltaPos = _mm_sub_ps(s2s3_pB_pos, s2s3_pA_pos);
+        __m128 const deltaPosX = _mm_shuffle_ps(s0s1_deltaPos, s2s3_deltaPos, _MM_SHUFFLE(2, 0, 2, 0)); // x0,x1,x2,x3
+        __m128 const deltaPosY = _mm_shuffle_ps(s0s1_deltaPos, s2s3_deltaPos, _MM_SHUFFLE(3, 1, 3, 1)); // y0,y1,y2,y3
+
+        __m128 const s0s1_deltaVel = _mm_sub_ps(s0s1_pB_vel, s0s1_pA_vel);
+        __m128 const s2s3_deltaVel = _mm_sub_ps(s2s3_pB_vel, s2s3_pA_vel);
+        __m128 const deltaVelX = _mm_shuffle_ps(s0s1_deltaVel, s2s3_deltaVel, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 const deltaVelY = _mm_shuffle_ps(s0s1_deltaVel, s2s3_deltaVel, _MM_SHUFFLE(3, 1, 3, 1));
+
+        // Normalized spring vector; zero for zero-length springs
+        __m128 const springLength = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(deltaPosX, deltaPosX), _mm_mul_ps(deltaPosY, deltaPosY)));
+        __m128 const validMask = _mm_cmpgt_ps(springLength, Zero);
+        __m128 const springDirX = _mm_and_ps(_mm_div_ps(deltaPosX, springLength), validMask);
+        __m128 const springDirY = _mm_and_ps(_mm_div_ps(deltaPosY, springLength), validMask);
+
+        //
+        // 1. Hooke's law
+        //
+
+        __m128 const fSpring = _mm_mul_ps(
+            _mm_sub_ps(springLength, _mm_loadu_ps(&(springRestLengthBuffer[s]))),
+            _mm_loadu_ps(&(springStiffnessCoefficientBuffer[s])));
+
+        //
+        // 2. Damper forces
+        //
+
+        __m128 const fDamp = _mm_mul_ps(
+            _mm_add_ps(_mm_mul_ps(deltaVelX, springDirX), _mm_mul_ps(deltaVelY, springDirY)),
+            _mm_loadu_ps(&(springDampingCoefficientBuffer[s])));
+
+        //
+        // Apply forces
+        //
+
+        __m128 const fS = _mm_add_ps(fSpring, fDamp);
+        _mm_store_ps(fX, _mm_mul_ps(springDirX, fS));
+        _mm_store_ps(fY, _mm_mul_ps(springDirY, fS));
+
+        ScatterSpringForces<PacketSize>(s, springEndpointsBuffer, fX, fY, pointForceBuffer);
+    }
+
+    // Remainder
+    UpdateSpringForces_Naive(
+        s, springEnd,
+        springEndpointsBuffer, springRestLengthBuffer, springStiffnessCoefficientBuffer, springDampingCoefficientBuffer,
+        pointPositionBuffer, pointVelocityBuffer, pointForceBuffer);
+}
+
+TARGET_AVX2
+void UpdateSpringForces_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer)
+{
+    static constexpr size_t PacketSize = 8;
+
+    __m256 const Zero = _mm256_setzero_ps();
+
+    // Moves the A's in the low lane and the B's in the high lane
+    __m256i const DeinterleaveEndpoints = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    float const * restrict const positionBuffer = reinterpret_cast<float const *>(pointPositionBuffer);
+    float const * restrict const velocityBuffer = reinterpret_cast<float const *>(pointVelocityBuffer);
+
+    alignas(32) float fX[PacketSize];
+    alignas(32) float fY[PacketSize];
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        //
+        // Load endpoint indices, and turn them into float offsets
+        //
+
+        __m256i const endpoints0 = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&(springEndpointsBuffer[s * 2]))),
+            DeinterleaveEndpoints); // A0..A3,B0..B3
+        __m256i const endpoints1 = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&(springEndpointsBuffer[s * 2 + PacketSize]))),
+            DeinterleaveEndpoints); // A4..A7,B4..B7
+
+        __m256i const pointAIndex = _mm256_permute2x128_si256(endpoints0, endpoints1, 0x20);
+        __m256i const pointBIndex = _mm256_permute2x128_si256(endpoints0, endpoints1, 0x31);
+        __m256i const pointAOffset = _mm256_add_epi32(pointAIndex, pointAIndex); // Two floats per vec2f
+        __m256i const pointBOffset = _mm256_add_epi32(pointBIndex, pointBIndex);
+
+        //
+        // Gather positions and velocities
+        //
+
+        __m256 const deltaPosX = _mm256_sub_ps(
+            _mm256_i32gather_ps(positionBuffer, pointBOffset, 4),
+            _mm256_i32gather_ps(positionBuffer, pointAOffset, 4));
+        __m256 const deltaPosY = _mm256_sub_ps(
+            _mm256_i32gather_ps(positionBuffer + 1, pointBOffset, 4),
+            _mm256_i32gather_ps(positionBuffer + 1, pointAOffset, 4));
+
+        __m256 const deltaVelX = _mm256_sub_ps(
+            _mm256_i32gather_ps(velocityBuffer, pointBOffset, 4),
+            _mm256_i32gather_ps(velocityBuffer, pointAOffset, 4));
+        __m256 const deltaVelY = _mm256_sub_ps(
+            _mm256_i32gather_ps(velocityBuffer + 1, pointBOffset, 4),
+            _mm256_i32gather_ps(velocityBuffer + 1, pointAOffset, 4));
+
+        // Normalized spring vector; zero for zero-length springs
+        __m256 const springLength = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(deltaPosX, deltaPosX), _mm256_mul_ps(deltaPosY, deltaPosY)));
+        __m256 const validMask = _mm256_cmp_ps(springLength, Zero, _CMP_GT_OQ);
+        __m256 const springDirX = _mm256_and_ps(_mm256_div_ps(deltaPosX, springLength), validMask);
+        __m256 const springDirY = _mm256_and_ps(_mm256_div_ps(deltaPosY, springLength), validMask);
+
+        //
+        // 1. Hooke's law
+        //
+
+        __m256 const fSpring = _mm256_mul_ps(
+            _mm256_sub_ps(springLength, _mm256_loadu_ps(&(springRestLengthBuffer[s]))),
+            _mm256_loadu_ps(&(springStiffnessCoefficientBuffer[s])));
+
+        //
+        // 2. Damper forces
+        //
+
+        __m256 const fDamp = _mm256_mul_ps(
+            _mm256_add_ps(_mm256_mul_ps(deltaVelX, springDirX), _mm256_mul_ps(deltaVelY, springDirY)),
+            _mm256_loadu_ps(&(springDampingCoefficientBuffer[s])));
+
+        //
+        // Apply forces
+        //
+
+        __m256 const fS = _mm256_add_ps(fSpring, fDamp);
+        _mm256_store_ps(fX, _mm256_mul_ps(springDirX, fS));
+        _mm256_store_ps(fY, _mm256_mul_ps(springDirY, fS));
+
+        ScatterSpringForces<PacketSize>(s, springEndpointsBuffer, fX, fY, pointForceBuffer);
+    }
+
+    // Remainder
+    UpdateSpringForces_Naive(
+        s, springEnd,
+        springEndpointsBuffer, springRestLengthBuffer, springStiffnessCoefficientBuffer, springDampingCoefficientBuffer,
+        pointPositionBuffer, pointVelocityBuffer, pointForceBuffer);
+}
+
+TARGET_AVX512
+void UpdateSpringForces_AVX512(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer)
+{
+    static constexpr size_t PacketSize = 16;
+
+    __m512 const Zero = _mm512_setzero_ps();
+
+    // Picks the A's (even) and the B's (odd) out of two registers of interleaved endpoints
+    __m512i const SelectA = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    __m512i const SelectB = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+
+    float const * restrict const positionBuffer = reinterpret_cast<float const *>(pointPositionBuffer);
+    float const * restrict const velocityBuffer = reinterpret_cast<float const *>(pointVelocityBuffer);
+
+    alignas(64) float fX[PacketSize];
+    alignas(64) float fY[PacketSize];
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        //
+        // Load endpoint indices, and turn them into float offsets
+        //
+
+        __m512i const endpoints0 = _mm512_loadu_si512(&(springEndpointsBuffer[s * 2]));
+        __m512i const endpoints1 = _mm512_loadu_si512(&(springEndpointsBuffer[s * 2 + PacketSize]));
+
+        __m512i const pointAIndex = _mm512_permutex2var_epi32(endpoints0, SelectA, endpoints1);
+        __m512i const pointBIndex = _mm512_permutex2var_epi32(endpoints0, SelectB, endpoints1);
+        __m512i const pointAOffset = _mm512_add_epi32(pointAIndex, pointAIndex); // Two floats per vec2f
+        __m512i const pointBOffset = _mm512_add_epi32(pointBIndex, pointBIndex);
+
+        //
+        // Gather positions and velocities
+        //
+
+        __m512 const deltaPosX = _mm512_sub_ps(
+            _mm512_i32gather_ps(pointBOffset, positionBuffer, 4),
+            _mm512_i32gather_ps(pointAOffset, positionBuffer, 4));
+        __m512 const deltaPosY = _mm512_sub_ps(
+            _mm512_i32gather_ps(pointBOffset, positionBuffer + 1, 4),
+            _mm512_i32gather_ps(pointAOffset, positionBuffer + 1, 4));
+
+        __m512 const deltaVelX = _mm512_sub_ps(
+            _mm512_i32gather_ps(pointBOffset, velocityBuffer, 4),
+            _mm512_i32gather_ps(pointAOffset, velocityBuffer, 4));
+        __m512 const deltaVelY = _mm512_sub_ps(
+            _mm512_i32gather_ps(pointBOffset, velocityBuffer + 1, 4),
+            _mm512_i32gather_ps(pointAOffset, velocityBuffer + 1, 4));
+
+        // Normalized spring vector; zero for zero-length springs
+        __m512 const springLength = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(deltaPosX, deltaPosX), _mm512_mul_ps(deltaPosY, deltaPosY)));
+        __mmask16 const validMask = _mm512_cmp_ps_mask(springLength, Zero, _CMP_GT_OQ);
+        __m512 const springDirX = _mm512_maskz_div_ps(validMask, deltaPosX, springLength);
+        __m512 const springDirY = _mm512_maskz_div_ps(validMask, deltaPosY, springLength);
+
+        //
+        // 1. Hooke's law
+        //
+
+        __m512 const fSpring = _mm512_mul_ps(
+            _mm512_sub_ps(springLength, _mm512_loadu_ps(&(springRestLengthBuffer[s]))),
+            _mm512_loadu_ps(&(springStiffnessCoefficientBuffer[s])));
+
+        //
+        // 2. Damper forces
+        //
+
+        __m512 const fDamp = _mm512_mul_ps(
+            _mm512_add_ps(_mm512_mul_ps(deltaVelX, springDirX), _mm512_mul_ps(deltaVelY, springDirY)),
+            _mm512_loadu_ps(&(springDampingCoefficientBuffer[s])));
+
+        //
+        // Apply forces
+        //
+
+        __m512 const fS = _mm512_add_ps(fSpring, fDamp);
+        _mm512_store_ps(fX, _mm512_mul_ps(springDirX, fS));
+        _mm512_store_ps(fY, _mm512_mul_ps(springDirY, fS));
+
+        ScatterSpringForces<PacketSize>(s, springEndpointsBuffer, fX, fY, pointForceBuffer);
+    }
+
+    // Remainder
+    UpdateSpringForces_Naive(
+        s, springEnd,
+        springEndpointsBuffer, springRestLengthBuffer, springStiffnessCoefficientBuffer, springDampingCoefficientBuffer,
+        pointPositionBuffer, pointVelocityBuffer, pointForceBuffer);
+}
+
+void CalculateSpringGeometry(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality)
+{
+    CalculateSpringGeometry(
+        GetInstructionSet(),
+        springStart,
+        springEnd,
+        springEndpointsBuffer,
+        pointPositionBuffer,
+        springLengthBuffer,
+        springNormalizedVectorBuffer,
+        mathQuality);
+}
+
+void CalculateSpringGeometry(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality)
+{
+    switch (instructionSet)
+    {
+        // Nothing to gain from wider packets, as we're bound by the gathers
+        case InstructionSet::AVX512:
+        case InstructionSet::AVX2:
+        {
+            CalculateSpringGeometry_AVX2(springStart, springEnd, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer, mathQuality);
+            break;
+        }
+
+        case InstructionSet::SSE2:
+        {
+            CalculateSpringGeometry_SSE2(springStart, springEnd, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer, mathQuality);
+            break;
+        }
+
+        case InstructionSet::Scalar:
+        {
+            CalculateSpringGeometry_Naive(springStart, springEnd, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer, mathQuality);
+            break;
+        }
+    }
+}
+
+void CalculateSpringGeometry_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality)
+{
+    for (ElementIndex springIndex = springStart; springIndex < springEnd; ++springIndex)
+    {
+        CalculateSingleSpringGeometry(springIndex, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer, mathQuality);
+    }
+}
+
+void CalculateSpringGeometry_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 4;
+
+    float * restrict const normalizedVectorBuffer = reinterpret_cast<float *>(springNormalizedVectorBuffer);
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        CalculateSpringGeometryPacket_SSE2(s, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, normalizedVectorBuffer, mathQuality);
+    }
+
+    // Remainder
+    CalculateSpringGeometry_Naive(s, springEnd, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer, mathQuality);
+}
+
+TARGET_AVX2
+void CalculateSpringGeometry_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 8;
+
+    float const * restrict const positionBuffer = reinterpret_cast<float const *>(pointPositionBuffer);
+    float * restrict const normalizedVectorBuffer = reinterpret_cast<float *>(springNormalizedVectorBuffer);
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        CalculateSpringGeometryPacket_AVX2(s, springEndpointsBuffer, positionBuffer, springLengthBuffer, normalizedVectorBuffer, mathQuality);
+    }
+
+    // Remainder
+    CalculateSpringGeometry_Naive(s, springEnd, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer, mathQuality);
+}
+
+void CalculateSpringGeometryAndStrains(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality)
+{
+    CalculateSpringGeometryAndStrains(
+        GetInstructionSet(),
+        springStart,
+        springEnd,
+        springEndpointsBuffer,
+        springRestLengthBuffer,
+        springStrengthBuffer,
+        springIsDeletedBuffer,
+        strengthAdjustment,
+        pointPositionBuffer,
+        springLengthBuffer,
+        springNormalizedVectorBuffer,
+        brokenSpringIndices,
+        brokenSpringCount,
+        stressedSpringIndices,
+        stressedSpringCount,
+        maxRelativeStrain,
+        mathQuality);
+}
+
+void CalculateSpringGeometryAndStrains(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality)
+{
+    switch (instructionSet)
+    {
+        // Nothing to gain from wider packets, as we're bound by the gathers
+        case InstructionSet::AVX512:
+        case InstructionSet::AVX2:
+        {
+            CalculateSpringGeometryAndStrains_AVX2(
+                springStart, springEnd,
+                springEndpointsBuffer, springRestLengthBuffer, springStrengthBuffer, springIsDeletedBuffer, strengthAdjustment,
+                pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer,
+                brokenSpringIndices, brokenSpringCount, stressedSpringIndices, stressedSpringCount, maxRelativeStrain,
+                mathQuality);
+            break;
+        }
+
+        case InstructionSet::SSE2:
+        {
+            CalculateSpringGeometryAndStrains_SSE2(
+                springStart, springEnd,
+                springEndpointsBuffer, springRestLengthBuffer, springStrengthBuffer, springIsDeletedBuffer, strengthAdjustment,
+                pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer,
+                brokenSpringIndices, brokenSpringCount, stressedSpringIndices, stressedSpringCount, maxRelativeStrain,
+                mathQuality);
+            break;
+        }
+
+        case InstructionSet::Scalar:
+        {
+            CalculateSpringGeometryAndStrains_Naive(
+                springStart, springEnd,
+                springEndpointsBuffer, springRestLengthBuffer, springStrengthBuffer, springIsDeletedBuffer, strengthAdjustment,
+                pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer,
+                brokenSpringIndices, brokenSpringCount, stressedSpringIndices, stressedSpringCount, maxRelativeStrain,
+                mathQuality);
+            break;
+        }
+    }
+}
+
+void CalculateSpringGeometryAndStrains_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality)
+{
+    for (ElementIndex springIndex = springStart; springIndex < springEnd; ++springIndex)
+    {
+        float const springLength = CalculateSingleSpringGeometry(springIndex, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer, mathQuality);
+
+        // Deleted springs neither break nor stress
+        if (!springIsDeletedBuffer[springIndex])
+        {
+            // Calculate strain
+            float const strain = std::fabs(springRestLengthBuffer[springIndex] - springLength) / springRestLengthBuffer[springIndex];
+
+            // Check against strength
+            float const effectiveStrength = strengthAdjustment * springStrengthBuffer[springIndex];
+            maxRelativeStrain = std::max(maxRelativeStrain, strain / effectiveStrength);
+            if (strain > effectiveStrength)
+            {
+                brokenSpringIndices[brokenSpringCount++] = springIndex;
+            }
+            else if (strain > 0.5f * effectiveStrength)
+            {
+                stressedSpringIndices[stressedSpringCount++] = springIndex;
+            }
+        }
+    }
+}
+
+void CalculateSpringGeometryAndStrains_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 4;
+
+    __m128 const Half = _mm_set1_ps(0.5f);
+    __m128 const AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 const StrengthAdjustment = _mm_set1_ps(strengthAdjustment);
+    __m128i const LaneBits = _mm_setr_epi32(1, 2, 4, 8);
+
+    float * restrict const normalizedVectorBuffer = reinterpret_cast<float *>(springNormalizedVectorBuffer);
+
+    __m128 maxRelativeStrains = _mm_setzero_ps();
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        __m128 const springLength = CalculateSpringGeometryPacket_SSE2(s, springEndpointsBuffer, pointPositionBuffer, springLengthBuffer, normalizedVectorBuffer, mathQuality);
+
+        // One bit and one lane mask for the springs that are not deleted
+        std::int32_t isDeleted;
+        std::memcpy(&isDeleted, &(springIsDeletedBuffer[s]), sizeof(isDeleted));
+        int const liveMask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_cvtsi32_si128(isDeleted), _mm_setzero_si128())) & 0x0f;
+        __m128 const liveLanes = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(liveMask), LaneBits), LaneBits));
+
+        // Calculate strain
+        __m128 const restLength = _mm_loadu_ps(&(springRestLengthBuffer[s]));
+        __m128 const strain = _mm_div_ps(_mm_and_ps(_mm_sub_ps(restLength, springLength), AbsMask), restLength);
+
+        // Check against strength
+        __m128 const effectiveStrength = _mm_mul_ps(StrengthAdjustment, _mm_loadu_ps(&(springStrengthBuffer[s])));
+        maxRelativeStrains = _mm_max_ps(maxRelativeStrains, _mm_and_ps(_mm_div_ps(strain, effectiveStrength), liveLanes));
+
+        int const brokenMask = _mm_movemask_ps(_mm_cmpgt_ps(strain, effectiveStrength)) & liveMask;
+        int const stressedMask = _mm_movemask_ps(_mm_cmpgt_ps(strain, _mm_mul_ps(Half, effectiveStrength))) & liveMask & ~brokenMask;
+
+        // Rare, hence we don't mind the branches
+        if (0 != brokenMask)
+            AppendSpringIndices<PacketSize>(s, brokenMask, brokenSpringIndices, brokenSpringCount);
+        if (0 != stressedMask)
+            AppendSpringIndices<PacketSize>(s, stressedMask, stressedSpringIndices, stressedSpringCount);
+    }
+
+    alignas(16) float packetMaxRelativeStrains[PacketSize];
+    _mm_store_ps(packetMaxRelativeStrains, maxRelativeStrains);
+    for (float const packetMaxRelativeStrain : packetMaxRelativeStrains)
+        maxRelativeStrain = std::max(maxRelativeStrain, packetMaxRelativeStrain);
+
+    // Remainder
+    CalculateSpringGeometryAndStrains_Naive(
+        s, springEnd,
+        springEndpointsBuffer, springRestLengthBuffer, springStrengthBuffer, springIsDeletedBuffer, strengthAdjustment,
+        pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer,
+        brokenSpringIndices, brokenSpringCount, stressedSpringIndices, stressedSpringCount, maxRelativeStrain,
+        mathQuality);
+}
+
+TARGET_AVX2
+void CalculateSpringGeometryAndStrains_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 8;
+
+    __m256 const Half = _mm256_set1_ps(0.5f);
+    __m256 const AbsMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 const StrengthAdjustment = _mm256_set1_ps(strengthAdjustment);
+    __m256i const LaneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+
+    float const * restrict const positionBuffer = reinterpret_cast<float const *>(pointPositionBuffer);
+    float * restrict const normalizedVectorBuffer = reinterpret_cast<float *>(springNormalizedVectorBuffer);
+
+    __m256 maxRelativeStrains = _mm256_setzero_ps();
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        __m256 const springLength = CalculateSpringGeometryPacket_AVX2(s, springEndpointsBuffer, positionBuffer, springLengthBuffer, normalizedVectorBuffer, mathQuality);
+
+        // One bit and one lane mask for the springs that are not deleted
+        __m128i const isDeleted = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(&(springIsDeletedBuffer[s])));
+        int const liveMask = _mm_movemask_epi8(_mm_cmpeq_epi8(isDeleted, _mm_setzero_si128())) & 0xff;
+        __m256 const liveLanes = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(liveMask), LaneBits), LaneBits));
+
+        // Calculate strain
+        __m256 const restLength = _mm256_loadu_ps(&(springRestLengthBuffer[s]));
+        __m256 const strain = _mm256_div_ps(_mm256_and_ps(_mm256_sub_ps(restLength, springLength), AbsMask), restLength);
+
+        // Check against strength
+        __m256 const effectiveStrength = _mm256_mul_ps(StrengthAdjustment, _mm256_loadu_ps(&(springStrengthBuffer[s])));
+        maxRelativeStrains = _mm256_max_ps(maxRelativeStrains, _mm256_and_ps(_mm256_div_ps(strain, effectiveStrength), liveLanes));
+
+        int const brokenMask = _mm256_movemask_ps(_mm256_cmp_ps(strain, effectiveStrength, _CMP_GT_OQ)) & liveMask;
+        int const stressedMask = _mm256_movemask_ps(_mm256_cmp_ps(strain, _mm256_mul_ps(Half, effectiveStrength), _CMP_GT_OQ)) & liveMask & ~brokenMask;
+
+        // Rare, hence we don't mind the branches
+        if (0 != brokenMask)
+            AppendSpringIndices<PacketSize>(s, brokenMask, brokenSpringIndices, brokenSpringCount);
+        if (0 != stressedMask)
+            AppendSpringIndices<PacketSize>(s, stressedMask, stressedSpringIndices, stressedSpringCount);
+    }
+
+    alignas(32) float packetMaxRelativeStrains[PacketSize];
+    _mm256_store_ps(packetMaxRelativeStrains, maxRelativeStrains);
+    for (float const packetMaxRelativeStrain : packetMaxRelativeStrains)
+        maxRelativeStrain = std::max(maxRelativeStrain, packetMaxRelativeStrain);
+
+    // Remainder
+    CalculateSpringGeometryAndStrains_Naive(
+        s, springEnd,
+        springEndpointsBuffer, springRestLengthBuffer, springStrengthBuffer, springIsDeletedBuffer, strengthAdjustment,
+        pointPositionBuffer, springLengthBuffer, springNormalizedVectorBuffer,
+        brokenSpringIndices, brokenSpringCount, stressedSpringIndices, stressedSpringCount, maxRelativeStrain,
+        mathQuality);
+}
+
+void CalculateSpringOutboundWaterVelocities(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality)
+{
+    CalculateSpringOutboundWaterVelocities(
+        GetInstructionSet(),
+        springStart,
+        springEnd,
+        springEndpointsBuffer,
+        springNormalizedVectorBuffer,
+        pointPositionBuffer,
+        pointWaterBuffer,
+        pointWaterVelocityBuffer,
+        waterCrazyness,
+        gravityMagnitude,
+        springOutboundWaterVelocityAToBBuffer,
+        springOutboundWaterVelocityBToABuffer,
+        mathQuality);
+}
+
+void CalculateSpringOutboundWaterVelocities(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality)
+{
+    switch (instructionSet)
+    {
+        // Nothing to gain from wider packets, as we're bound by the gathers
+        case InstructionSet::AVX512:
+        case InstructionSet::AVX2:
+        {
+            CalculateSpringOutboundWaterVelocities_AVX2(
+                springStart, springEnd,
+                springEndpointsBuffer, springNormalizedVectorBuffer,
+                pointPositionBuffer, pointWaterBuffer, pointWaterVelocityBuffer,
+                waterCrazyness, gravityMagnitude,
+                springOutboundWaterVelocityAToBBuffer, springOutboundWaterVelocityBToABuffer,
+                mathQuality);
+
+            break;
+        }
+
+        case InstructionSet::SSE2:
+        {
+            CalculateSpringOutboundWaterVelocities_SSE2(
+                springStart, springEnd,
+                springEndpointsBuffer, springNormalizedVectorBuffer,
+                pointPositionBuffer, pointWaterBuffer, pointWaterVelocityBuffer,
+                waterCrazyness, gravityMagnitude,
+                springOutboundWaterVelocityAToBBuffer, springOutboundWaterVelocityBToABuffer,
+                mathQuality);
+
+            break;
+        }
+
+        case InstructionSet::Scalar:
+        {
+            CalculateSpringOutboundWaterVelocities_Naive(
+                springStart, springEnd,
+                springEndpointsBuffer, springNormalizedVectorBuffer,
+                pointPositionBuffer, pointWaterBuffer, pointWaterVelocityBuffer,
+                waterCrazyness, gravityMagnitude,
+                springOutboundWaterVelocityAToBBuffer, springOutboundWaterVelocityBToABuffer,
+                mathQuality);
+
+            break;
+        }
+    }
+}
+
+void CalculateSpringOutboundWaterVelocities_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality)
+{
+    for (ElementIndex springIndex = springStart; springIndex < springEnd; ++springIndex)
+    {
+        auto const pointAIndex = springEndpointsBuffer[springIndex * 2];
+        auto const pointBIndex = springEndpointsBuffer[springIndex * 2 + 1];
+
+        vec2f const & springNormalizedVector = springNormalizedVectorBuffer[springIndex];
+
+        //
+        // Bernoulli's velocity gained along the spring, from A to B; the one gained
+        // from B to A is the opposite
+        //
+
+        // Pressure difference plus gravity potential difference (positive implies A -> B flow)
+        float const dwy =
+            (pointWaterBuffer[pointAIndex] - pointWaterBuffer[pointBIndex])
+            + (pointPositionBuffer[pointAIndex].y - pointPositionBuffer[pointBIndex].y);
+
+        float const bernoulliVelocityMagnitude = (mathQuality == MathQuality::Fast)
+            ? FastSqrt(2.0f * gravityMagnitude * std::abs(dwy))
+            : sqrtf(2.0f * gravityMagnitude * std::abs(dwy));
+
+        float const bernoulliVelocityAToB = (dwy >= 0.0f)
+            ? bernoulliVelocityMagnitude
+            : -bernoulliVelocityMagnitude;
+
+        //
+        // Each endpoint weighs Bernoulli's velocity according to its own water crazyness alpha
+        //
+
+        float const alphaCrazynessA = 1.0f + waterCrazyness * (pointWaterBuffer[pointAIndex] - 1.0f);
+        float const alphaCrazynessB = 1.0f + waterCrazyness * (pointWaterBuffer[pointBIndex] - 1.0f);
+
+        springOutboundWaterVelocityAToBBuffer[springIndex] = std::max(
+            pointWaterVelocityBuffer[pointAIndex].dot(springNormalizedVector) + bernoulliVelocityAToB * alphaCrazynessA,
+            0.0f);
+
+        springOutboundWaterVelocityBToABuffer[springIndex] = std::max(
+            -pointWaterVelocityBuffer[pointBIndex].dot(springNormalizedVector) - bernoulliVelocityAToB * alphaCrazynessB,
+            0.0f);
+    }
+}
+
+void CalculateSpringOutboundWaterVelocities_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 4;
+
+    __m128 const Zero = _mm_setzero_ps();
+    __m128 const One = _mm_set1_ps(1.0f);
+    __m128 const SignMask = _mm_set1_ps(-0.0f);
+    __m128 const TwiceGravityMagnitude = _mm_set1_ps(2.0f * gravityMagnitude);
+    __m128 const WaterCrazyness = _mm_set1_ps(waterCrazyness);
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        ElementIndex const * restrict const endpoints = &(springEndpointsBuffer[s * 2]);
+
+        //
+        // Load point quantities - no gather in SSE2, hence one float at a time
+        //
+
+#define LOAD_FLOATS(buffer, member, first) \
+    _mm_setr_ps( \
+        buffer[endpoints[first]]member, \
+        buffer[endpoints[first + 2]]member, \
+        buffer[endpoints[first + 4]]member, \
+        buffer[endpoints[first + 6]]member)
+
+        __m128 const pA_water = LOAD_FLOATS(pointWaterBuffer, , 0);
+        __m128 const pB_water = LOAD_FLOATS(pointWaterBuffer, , 1);
+        __m128 const pA_y = LOAD_FLOATS(pointPositionBuffer, .y, 0);
+        __m128 const pB_y = LOAD_FLOATS(pointPositionBuffer, .y, 1);
+        __m128 const pA_waterVelX = LOAD_FLOATS(pointWaterVelocityBuffer, .x, 0);
+        __m128 const pA_waterVelY = LOAD_FLOATS(pointWaterVelocityBuffer, .y, 0);
+        __m128 const pB_waterVelX = LOAD_FLOATS(pointWaterVelocityBuffer, .x, 1);
+        __m128 const pB_waterVelY = LOAD_FLOATS(pointWaterVelocityBuffer, .y, 1);
+
+#undef LOAD_FLOATS
+
+        __m128 const n0n1 = _mm_loadu_ps(reinterpret_cast<float const *>(&(springNormalizedVectorBuffer[s]))); // x0,y0,x1,y1
+        __m128 const n2n3 = _mm_loadu_ps(reinterpret_cast<float const *>(&(springNormalizedVectorBuffer[s + 2]))); // x2,y2,x3,y3
+        __m128 const nX = _mm_shuffle_ps(n0n1, n2n3, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 const nY = _mm_shuffle_ps(n0n1, n2n3, _MM_SHUFFLE(3, 1, 3, 1));
+
+        //
+        // Bernoulli's velocity gained along the spring, from A to B
+        //
+
+        __m128 const dwy = _mm_add_ps(
+            _mm_sub_ps(pA_water, pB_water),
+            _mm_sub_ps(pA_y, pB_y));
+
+        __m128 const squareVelocity = _mm_mul_ps(TwiceGravityMagnitude, _mm_andnot_ps(SignMask, dwy));
+        __m128 const bernoulliVelocityAToB = _mm_or_ps(
+            (mathQuality == MathQuality::Fast) ? FastSqrt(squareVelocity) : _mm_sqrt_ps(squareVelocity),
+            _mm_and_ps(SignMask, dwy));
+
+        //
+        // Outbound velocities
+        //
+
+        __m128 const alphaCrazynessA = _mm_add_ps(One, _mm_mul_ps(WaterCrazyness, _mm_sub_ps(pA_water, One)));
+        __m128 const alphaCrazynessB = _mm_add_ps(One, _mm_mul_ps(WaterCrazyness, _mm_sub_ps(pB_water, One)));
+
+        __m128 const pA_waterVelAlongSpring = _mm_add_ps(_mm_mul_ps(pA_waterVelX, nX), _mm_mul_ps(pA_waterVelY, nY));
+        __m128 const pB_waterVelAlongSpring = _mm_add_ps(_mm_mul_ps(pB_waterVelX, nX), _mm_mul_ps(pB_waterVelY, nY));
+
+        _mm_storeu_ps(
+            &(springOutboundWaterVelocityAToBBuffer[s]),
+            _mm_max_ps(
+                _mm_add_ps(pA_waterVelAlongSpring, _mm_mul_ps(bernoulliVelocityAToB, alphaCrazynessA)),
+                Zero));
+
+        _mm_storeu_ps(
+            &(springOutboundWaterVelocityBToABuffer[s]),
+            _mm_max_ps(
+                _mm_sub_ps(_mm_xor_ps(pB_waterVelAlongSpring, SignMask), _mm_mul_ps(bernoulliVelocityAToB, alphaCrazynessB)),
+                Zero));
+    }
+
+    // Remainder
+    CalculateSpringOutboundWaterVelocities_Naive(
+        s, springEnd,
+        springEndpointsBuffer, springNormalizedVectorBuffer,
+        pointPositionBuffer, pointWaterBuffer, pointWaterVelocityBuffer,
+        waterCrazyness, gravityMagnitude,
+        springOutboundWaterVelocityAToBBuffer, springOutboundWaterVelocityBToABuffer,
+        mathQuality);
+}
+
+TARGET_AVX2
+void CalculateSpringOutboundWaterVelocities_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 8;
+
+    __m256 const Zero = _mm256_setzero_ps();
+    __m256 const One = _mm256_set1_ps(1.0f);
+    __m256 const SignMask = _mm256_set1_ps(-0.0f);
+    __m256 const TwiceGravityMagnitude = _mm256_set1_ps(2.0f * gravityMagnitude);
+    __m256 const WaterCrazyness = _mm256_set1_ps(waterCrazyness);
+
+    // Moves the A's in the low lane and the B's in the high lane
+    __m256i const DeinterleaveEndpoints = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    float const * restrict const positionBuffer = reinterpret_cast<float const *>(pointPositionBuffer);
+    float const * restrict const waterVelocityBuffer = reinterpret_cast<float const *>(pointWaterVelocityBuffer);
+
+    ElementIndex s = springStart;
+    for (; s + PacketSize <= springEnd; s += PacketSize)
+    {
+        //
+        // Load endpoint indices, and turn them into float offsets
+        //
+
+        __m256i const endpoints0 = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&(springEndpointsBuffer[s * 2]))),
+            DeinterleaveEndpoints); // A0..A3,B0..B3
+        __m256i const endpoints1 = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&(springEndpointsBuffer[s * 2 + PacketSize]))),
+            DeinterleaveEndpoints); // A4..A7,B4..B7
+
+        __m256i const pointAIndex = _mm256_permute2x128_si256(endpoints0, endpoints1, 0x20);
+        __m256i const pointBIndex = _mm256_permute2x128_si256(endpoints0, endpoints1, 0x31);
+        __m256i const pointAOffset = _mm256_add_epi32(pointAIndex, pointAIndex); // Two floats per vec2f
+        __m256i const pointBOffset = _mm256_add_epi32(pointBIndex, pointBIndex);
+
+        //
+        // Gather point quantities
+        //
+
+        __m256 const pA_water = _mm256_i32gather_ps(pointWaterBuffer, pointAIndex, 4);
+        __m256 const pB_water = _mm256_i32gather_ps(pointWaterBuffer, pointBIndex, 4);
+        __m256 const pA_y = _mm256_i32gather_ps(positionBuffer + 1, pointAOffset, 4);
+        __m256 const pB_y = _mm256_i32gather_ps(positionBuffer + 1, pointBOffset, 4);
+        __m256 const pA_waterVelX = _mm256_i32gather_ps(waterVelocityBuffer, pointAOffset, 4);
+        __m256 const pA_waterVelY = _mm256_i32gather_ps(waterVelocityBuffer + 1, pointAOffset, 4);
+        __m256 const pB_waterVelX = _mm256_i32gather_ps(waterVelocityBuffer, pointBOffset, 4);
+        __m256 const pB_waterVelY = _mm256_i32gather_ps(waterVelocityBuffer + 1, pointBOffset, 4);
+
+        //
+        // Load spring normalized vectors
+        //
+
+        __m256 const n0n3 = _mm256_loadu_ps(reinterpret_cast<float const *>(&(springNormalizedVectorBuffer[s]))); // x0,y0,..,x3,y3
+        __m256 const n4n7 = _mm256_loadu_ps(reinterpret_cast<float const *>(&(springNormalizedVectorBuffer[s + 4]))); // x4,y4,..,x7,y7
+
+        // x0,x1,x4,x5,x2,x3,x6,x7 -> x0..x7
+        __m256 const nX = _mm256_castpd_ps(
+            _mm256_permute4x64_pd(
+                _mm256_castps_pd(_mm256_shuffle_ps(n0n3, n4n7, _MM_SHUFFLE(2, 0, 2, 0))),
+                _MM_SHUFFLE(3, 1, 2, 0)));
+        __m256 const nY = _mm256_castpd_ps(
+            _mm256_permute4x64_pd(
+                _mm256_castps_pd(_mm256_shuffle_ps(n0n3, n4n7, _MM_SHUFFLE(3, 1, 3, 1))),
+                _MM_SHUFFLE(3, 1, 2, 0)));
+
+        //
+        // Bernoulli's velocity gained along the spring, from A to B
+        //
+
+        __m256 const dwy = _mm256_add_ps(
+            _mm256_sub_ps(pA_water, pB_water),
+            _mm256_sub_ps(pA_y, pB_y));
+
+        __m256 const squareVelocity = _mm256_mul_ps(TwiceGravityMagnitude, _mm256_andnot_ps(SignMask, dwy));
+        __m256 const bernoulliVelocityAToB = _mm256_or_ps(
+            (mathQuality == MathQuality::Fast) ? FastSqrt(squareVelocity) : _mm256_sqrt_ps(squareVelocity),
+            _mm256_and_ps(SignMask, dwy));
+
+        //
+        // Outbound velocities
+        //
+
+        __m256 const alphaCrazynessA = _mm256_add_ps(One, _mm256_mul_ps(WaterCrazyness, _mm256_sub_ps(pA_water, One)));
+        __m256 const alphaCrazynessB = _mm256_add_ps(One, _mm256_mul_ps(WaterCrazyness, _mm256_sub_ps(pB_water, One)));
+
+        __m256 const pA_waterVelAlongSpring = _mm256_add_ps(_mm256_mul_ps(pA_waterVelX, nX), _mm256_mul_ps(pA_waterVelY, nY));
+        __m256 const pB_waterVelAlongSpring = _mm256_add_ps(_mm256_mul_ps(pB_waterVelX, nX), _mm256_mul_ps(pB_waterVelY, nY));
+
+        _mm256_storeu_ps(
+            &(springOutboundWaterVelocityAToBBuffer[s]),
+            _mm256_max_ps(
+                _mm256_add_ps(pA_waterVelAlongSpring, _mm256_mul_ps(bernoulliVelocityAToB, alphaCrazynessA)),
+                Zero));
+
+        _mm256_storeu_ps(
+            &(springOutboundWaterVelocityBToABuffer[s]),
+            _mm256_max_ps(
+                _mm256_sub_ps(_mm256_xor_ps(pB_waterVelAlongSpring, SignMask), _mm256_mul_ps(bernoulliVelocityAToB, alphaCrazynessB)),
+                Zero));
+    }
+
+    // Remainder
+    CalculateSpringOutboundWaterVelocities_Naive(
+        s, springEnd,
+        springEndpointsBuffer, springNormalizedVectorBuffer,
+        pointPositionBuffer, pointWaterBuffer, pointWaterVelocityBuffer,
+        waterCrazyness, gravityMagnitude,
+        springOutboundWaterVelocityAToBBuffer, springOutboundWaterVelocityBToABuffer,
+        mathQuality);
+}
+
+void CalculateLeakingPointWaterInflows(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality)
+{
+    CalculateLeakingPointWaterInflows(
+        GetInstructionSet(),
+        pointIndices,
+        pointCount,
+        pointPositionBuffer,
+        pointWaterSurfaceHeightBuffer,
+        pointWaterBuffer,
+        waterDynamicsSimulationStepTimeDuration,
+        waterIntakeAdjustment,
+        gravityMagnitude,
+        inflowBuffer,
+        mathQuality);
+}
+
+void CalculateLeakingPointWaterInflows(
+    InstructionSet instructionSet,
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality)
+{
+    switch (instructionSet)
+    {
+        // Nothing to gain from wider packets, as we're bound by the gathers
+        case InstructionSet::AVX512:
+        case InstructionSet::AVX2:
+        {
+            CalculateLeakingPointWaterInflows_AVX2(
+                pointIndices, pointCount,
+                pointPositionBuffer, pointWaterSurfaceHeightBuffer, pointWaterBuffer,
+                waterDynamicsSimulationStepTimeDuration, waterIntakeAdjustment, gravityMagnitude,
+                inflowBuffer,
+                mathQuality);
+
+            break;
+        }
+
+        case InstructionSet::SSE2:
+        {
+            CalculateLeakingPointWaterInflows_SSE2(
+                pointIndices, pointCount,
+                pointPositionBuffer, pointWaterSurfaceHeightBuffer, pointWaterBuffer,
+                waterDynamicsSimulationStepTimeDuration, waterIntakeAdjustment, gravityMagnitude,
+                inflowBuffer,
+                mathQuality);
+
+            break;
+        }
+
+        case InstructionSet::Scalar:
+        {
+            CalculateLeakingPointWaterInflows_Naive(
+                pointIndices, pointCount,
+                pointPositionBuffer, pointWaterSurfaceHeightBuffer, pointWaterBuffer,
+                waterDynamicsSimulationStepTimeDuration, waterIntakeAdjustment, gravityMagnitude,
+                inflowBuffer,
+                mathQuality);
+
+            break;
+        }
+    }
+}
+
+void CalculateLeakingPointWaterInflows_Naive(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality)
+{
+    for (ElementCount l = 0; l < pointCount; ++l)
+    {
+        auto const pointIndex = pointIndices[l];
+
+        //
+        // 1) Calculate velocity of incoming water, based off Bernoulli's equation applied to point:
+        //  v**2/2 + p/density = c (assuming y of incoming water does not change along the intake)
+        //      With: p = pressure of water at point = d*wh*g (d = water density, wh = water height in point)
+        //
+        // Considering that at equilibrium we have v=0 and p=external_pressure, 
+        // then c=external_pressure/density;
+        // external_pressure is height_of_water_at_y*g*density, then c=height_of_water_at_y*g; 
+        // hence, the velocity of water incoming at point p, when the "water height" in the point is already
+        // wh and the external water pressure is d*height_of_water_at_y*g, is:
+        //  v = +/- sqrt(2*g*|height_of_water_at_y-wh|)
+        //
+
+        float const externalWaterHeight = std::max(
+            pointWaterSurfaceHeightBuffer[pointIndex] - pointPositionBuffer[pointIndex].y,
+            0.0f);
+
+        float const internalWaterHeight = pointWaterBuffer[pointIndex];
+
+        float const incomingWaterVelocityMagnitude = (mathQuality == MathQuality::Fast)
+            ? FastSqrt(2.0f * gravityMagnitude * std::abs(externalWaterHeight - internalWaterHeight))
+            : sqrtf(2.0f * gravityMagnitude * std::abs(externalWaterHeight - internalWaterHeight));
+
+        float incomingWaterVelocity;
+        if (externalWaterHeight >= internalWaterHeight)
+        {
+            // Incoming water
+            incomingWaterVelocity = incomingWaterVelocityMagnitude;
+        }
+        else
+        {
+            // Outgoing water
+            incomingWaterVelocity = - incomingWaterVelocityMagnitude;
+        }
+
+        //
+        // 2) In/Outtake water according to velocity:
+        // - During dt, we move a volume of water Vw equal to A*v*dt; the equivalent change in water
+        //   height is thus Vw/A, i.e. v*dt
+        //
+
+        float newWater =
+            incomingWaterVelocity
+            * waterDynamicsSimulationStepTimeDuration
+            * waterIntakeAdjustment;
+
+        if (newWater < 0.0f)
+        {
+            // Outgoing water
+
+            // Make sure we don't over-drain the point
+            newWater = -std::min(-newWater, internalWaterHeight);
+
+            // Simulate water "sticking" into material - after all, water that once entered
+            // won't leave completely afterwards, something will stay behind
+            newWater *= 0.95f;
+        }
+
+        inflowBuffer[l] = newWater;
+    }
+}
+
+void CalculateLeakingPointWaterInflows_SSE2(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 4;
+
+    __m128 const Zero = _mm_setzero_ps();
+    __m128 const SignMask = _mm_set1_ps(-0.0f);
+    __m128 const TwiceGravityMagnitude = _mm_set1_ps(2.0f * gravityMagnitude);
+    __m128 const Dt = _mm_set1_ps(waterDynamicsSimulationStepTimeDuration);
+    __m128 const WaterIntakeAdjustment = _mm_set1_ps(waterIntakeAdjustment);
+    __m128 const StickingFactor = _mm_set1_ps(0.95f);
+
+    ElementCount l = 0;
+    for (; l + PacketSize <= pointCount; l += PacketSize)
+    {
+        ElementIndex const * restrict const p = &(pointIndices[l]);
+
+        // No gather in SSE2
+        __m128 const waterSurfaceHeight = _mm_setr_ps(
+            pointWaterSurfaceHeightBuffer[p[0]], pointWaterSurfaceHeightBuffer[p[1]], pointWaterSurfaceHeightBuffer[p[2]], pointWaterSurfaceHeightBuffer[p[3]]);
+        __m128 const y = _mm_setr_ps(
+            pointPositionBuffer[p[0]].y, pointPositionBuffer[p[1]].y, pointPositionBuffer[p[2]].y, pointPositionBuffer[p[3]].y);
+        __m128 const internalWaterHeight = _mm_setr_ps(
+            pointWaterBuffer[p[0]], pointWaterBuffer[p[1]], pointWaterBuffer[p[2]], pointWaterBuffer[p[3]]);
+
+        __m128 const externalWaterHeight = _mm_max_ps(_mm_sub_ps(waterSurfaceHeight, y), Zero);
+
+        // Bernoulli's velocity, with the sign of the height difference
+        __m128 const dh = _mm_sub_ps(externalWaterHeight, internalWaterHeight);
+        __m128 const squareVelocity = _mm_mul_ps(TwiceGravityMagnitude, _mm_andnot_ps(SignMask, dh));
+        __m128 const incomingWaterVelocity = _mm_or_ps(
+            (mathQuality == MathQuality::Fast) ? FastSqrt(squareVelocity) : _mm_sqrt_ps(squareVelocity),
+            _mm_and_ps(SignMask, dh));
+
+        __m128 const newWater = _mm_mul_ps(_mm_mul_ps(incomingWaterVelocity, Dt), WaterIntakeAdjustment);
+
+        // Outgoing water: don't over-drain the point, and leave something behind
+        __m128 const outgoingWater = _mm_mul_ps(
+            _mm_max_ps(newWater, _mm_xor_ps(internalWaterHeight, SignMask)),
+            StickingFactor);
+
+        __m128 const isOutgoing = _mm_cmplt_ps(newWater, Zero);
+
+        _mm_storeu_ps(
+            &(inflowBuffer[l]),
+            _mm_or_ps(
+                _mm_and_ps(isOutgoing, outgoingWater),
+                _mm_andnot_ps(isOutgoing, newWater)));
+    }
+
+    // Remainder
+    CalculateLeakingPointWaterInflows_Naive(
+        pointIndices + l, pointCount - l,
+        pointPositionBuffer, pointWaterSurfaceHeightBuffer, pointWaterBuffer,
+        waterDynamicsSimulationStepTimeDuration, waterIntakeAdjustment, gravityMagnitude,
+        inflowBuffer + l,
+        mathQuality);
+}
+
+TARGET_AVX2
+void CalculateLeakingPointWaterInflows_AVX2(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality)
+{
+    static constexpr size_t PacketSize = 8;
+
+    __m256 const Zero = _mm256_setzero_ps();
+    __m256 const SignMask = _mm256_set1_ps(-0.0f);
+    __m256 const TwiceGravityMagnitude = _mm256_set1_ps(2.0f * gravityMagnitude);
+    __m256 const Dt = _mm256_set1_ps(waterDynamicsSimulationStepTimeDuration);
+    __m256 const WaterIntakeAdjustment = _mm256_set1_ps(waterIntakeAdjustment);
+    __m256 const StickingFactor = _mm256_set1_ps(0.95f);
+
+    float const * restrict const positionBuffer = reinterpret_cast<float const *>(pointPositionBuffer);
+
+    ElementCount l = 0;
+    for (; l + PacketSize <= pointCount; l += PacketSize)
+    {
+        __m256i const pointIndex = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&(pointIndices[l])));
+        __m256i const pointOffset = _mm256_add_epi32(pointIndex, pointIndex); // Two floats per vec2f
+
+        __m256 const waterSurfaceHeight = _mm256_i32gather_ps(pointWaterSurfaceHeightBuffer, pointIndex, 4);
+        __m256 const y = _mm256_i32gather_ps(positionBuffer + 1, pointOffset, 4);
+        __m256 const internalWaterHeight = _mm256_i32gather_ps(pointWaterBuffer, pointIndex, 4);
+
+        __m256 const externalWaterHeight = _mm256_max_ps(_mm256_sub_ps(waterSurfaceHeight, y), Zero);
+
+        // Bernoulli's velocity, with the sign of the height difference
+        __m256 const dh = _mm256_sub_ps(externalWaterHeight, internalWaterHeight);
+        __m256 const squareVelocity = _mm256_mul_ps(TwiceGravityMagnitude, _mm256_andnot_ps(SignMask, dh));
+        __m256 const incomingWaterVelocity = _mm256_or_ps(
+            (mathQuality == MathQuality::Fast) ? FastSqrt(squareVelocity) : _mm256_sqrt_ps(squareVelocity),
+            _mm256_and_ps(SignMask, dh));
+
+        __m256 const newWater = _mm256_mul_ps(_mm256_mul_ps(incomingWaterVelocity, Dt), WaterIntakeAdjustment);
+
+        // Outgoing water: don't over-drain the point, and leave something behind
+        __m256 const outgoingWater = _mm256_mul_ps(
+            _mm256_max_ps(newWater, _mm256_xor_ps(internalWaterHeight, SignMask)),
+            StickingFactor);
+
+        _mm256_storeu_ps(
+            &(inflowBuffer[l]),
+            _mm256_blendv_ps(
+                newWater,
+                outgoingWater,
+                _mm256_cmp_ps(newWater, Zero, _CMP_LT_OQ)));
+    }
+
+    // Remainder
+    CalculateLeakingPointWaterInflows_Naive(
+        pointIndices + l, pointCount - l,
+        pointPositionBuffer, pointWaterSurfaceHeightBuffer, pointWaterBuffer,
+        waterDynamicsSimulationStepTimeDuration, waterIntakeAdjustment, gravityMagnitude,
+        inflowBuffer + l,
+        mathQuality);
+}
+
+void SampleHeightField(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer)
+{
+    SampleHeightField(
+        GetInstructionSet(),
+        samples,
+        samplesCount,
+        dx,
+        pointStart,
+        pointEnd,
+        pointPositionBuffer,
+        heightBuffer);
+}
+
+void SampleHeightField(
+    InstructionSet instructionSet,
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer)
+{
+    switch (instructionSet)
+    {
+        // Nothing to gain from wider packets, as we're bound by the gathers
+        case InstructionSet::AVX512:
+        case InstructionSet::AVX2:
+        {
+            SampleHeightField_AVX2(samples, samplesCount, dx, pointStart, pointEnd, pointPositionBuffer, heightBuffer);
+            break;
+        }
+
+        case InstructionSet::SSE2:
+        {
+            SampleHeightField_SSE2(samples, samplesCount, dx, pointStart, pointEnd, pointPositionBuffer, heightBuffer);
+            break;
+        }
+
+        case InstructionSet::Scalar:
+        {
+            SampleHeightField_Naive(samples, samplesCount, dx, pointStart, pointEnd, pointPositionBuffer, heightBuffer);
+            break;
+        }
+    }
+}
+
+void SampleHeightField_Naive(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer)
+{
+    assert(0 == (samplesCount & (samplesCount - 1)));
+
+    for (ElementIndex p = pointStart; p < pointEnd; ++p)
+    {
+        float const sampleX = pointPositionBuffer[p].x / dx;
+        float const absoluteSampleIndex = floorf(sampleX);
+
+        int64_t index = static_cast<int64_t>(absoluteSampleIndex) % static_cast<int64_t>(samplesCount);
+        if (index < 0)
+            index += samplesCount;
+
+        heightBuffer[p] =
+            samples[index]
+            + (samples[index + 1] - samples[index]) * (sampleX - absoluteSampleIndex);
+    }
+}
+
+void SampleHeightField_SSE2(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer)
+{
+    assert(0 == (samplesCount & (samplesCount - 1)));
+
+    static constexpr size_t PacketSize = 4;
+
+    __m128 const Dx = _mm_set1_ps(dx);
+    __m128 const One = _mm_set1_ps(1.0f);
+
+    // With a power-of-two number of samples, and-ing with this mask is the same as
+    // the positive modulo - also for negative indices
+    __m128i const IndexMask = _mm_set1_epi32(static_cast<int>(samplesCount - 1));
+
+    alignas(16) int32_t indices[PacketSize];
+
+    ElementIndex p = pointStart;
+    for (; p + PacketSize <= pointEnd; p += PacketSize)
+    {
+        __m128 const p0p1 = _mm_loadu_ps(reinterpret_cast<float const *>(&(pointPositionBuffer[p]))); // x0,y0,x1,y1
+        __m128 const p2p3 = _mm_loadu_ps(reinterpret_cast<float const *>(&(pointPositionBuffer[p + 2]))); // x2,y2,x3,y3
+
+        __m128 const sampleX = _mm_div_ps(
+            _mm_shuffle_ps(p0p1, p2p3, _MM_SHUFFLE(2, 0, 2, 0)),
+            Dx);
+
+        // No floor in SSE2: truncate, and then correct negative non-integers
+        __m128 const truncatedSampleX = _mm_cvtepi32_ps(_mm_cvttps_epi32(sampleX));
+        __m128 const absoluteSampleIndex = _mm_sub_ps(
+            truncatedSampleX,
+            _mm_and_ps(_mm_cmpgt_ps(truncatedSampleX, sampleX), One));
+
+        _mm_store_si128(
+            reinterpret_cast<__m128i *>(indices),
+            _mm_and_si128(_mm_cvttps_epi32(absoluteSampleIndex), IndexMask));
+
+        // No gather in SSE2 either
+        __m128 const sample0 = _mm_setr_ps(samples[indices[0]], samples[indices[1]], samples[indices[2]], samples[indices[3]]);
+        __m128 const sample1 = _mm_setr_ps(samples[indices[0] + 1], samples[indices[1] + 1], samples[indices[2] + 1], samples[indices[3] + 1]);
+
+        _mm_storeu_ps(
+            &(heightBuffer[p]),
+            _mm_add_ps(
+                sample0,
+                _mm_mul_ps(
+                    _mm_sub_ps(sample1, sample0),
+                    _mm_sub_ps(sampleX, absoluteSampleIndex))));
+    }
+
+    // Remainder
+    SampleHeightField_Naive(samples, samplesCount, dx, p, pointEnd, pointPositionBuffer, heightBuffer);
+}
+
+TARGET_AVX2
+void SampleHeightField_AVX2(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer)
+{
+    assert(0 == (samplesCount & (samplesCount - 1)));
+
+    static constexpr size_t PacketSize = 8;
+
+    __m256 const Dx = _mm256_set1_ps(dx);
+
+    // With a power-of-two number of samples, and-ing with this mask is the same as
+    // the positive modulo - also for negative indices
+    __m256i const IndexMask = _mm256_set1_epi32(static_cast<int>(samplesCount - 1));
+
+    ElementIndex p = pointStart;
+    for (; p + PacketSize <= pointEnd; p += PacketSize)
+    {
+        __m256 const p0p3 = _mm256_loadu_ps(reinterpret_cast<float const *>(&(pointPositionBuffer[p]))); // x0,y0,..,x3,y3
+        __m256 const p4p7 = _mm256_loadu_ps(reinterpret_cast<float const *>(&(pointPositionBuffer[p + 4]))); // x4,y4,..,x7,y7
+
+        // x0,x1,x4,x5,x2,x3,x6,x7 -> x0..x7
+        __m256 const x = _mm256_castpd_ps(
+            _mm256_permute4x64_pd(
+                _mm256_castps_pd(_mm256_shuffle_ps(p0p3, p4p7, _MM_SHUFFLE(2, 0, 2, 0))),
+                _MM_SHUFFLE(3, 1, 2, 0)));
+
+        __m256 const sampleX = _mm256_div_ps(x, Dx);
+        __m256 const absoluteSampleIndex = _mm256_floor_ps(sampleX);
+        __m256i const index = _mm256_and_si256(_mm256_cvttps_epi32(absoluteSampleIndex), IndexMask);
+
+        __m256 const sample0 = _mm256_i32gather_ps(samples, index, 4);
+        __m256 const sample1 = _mm256_i32gather_ps(samples + 1, index, 4);
+
+        _mm256_storeu_ps(
+            &(heightBuffer[p]),
+            _mm256_add_ps(
+                sample0,
+                _mm256_mul_ps(
+                    _mm256_sub_ps(sample1, sample0),
+                    _mm256_sub_ps(sampleX, absoluteSampleIndex))));
+    }
+
+    // Remainder
+    SampleHeightField_Naive(samples, samplesCount, dx, p, pointEnd, pointPositionBuffer, heightBuffer);
+}
+
+}
@@ -0,0 +1,470 @@
+/***************************************************************************************
+* Original Author:      agent
+* Created:              2026-10-17
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "FastMath.h"
+#include "GameTypes.h"
+#include "SysSpecifics.h"
+#include "Vectors.h"
+
+/*
+ * The hot kernels of the physics, working directly on element buffers.
+ *
+ * The kernels know nothing about Points and Springs, so that they may be tested and benchmarked
+ * in isolation; each kernel comes in a naive (scalar) flavor and in one flavor for each instruction
+ * set we support, and the un-suffixed entry point picks the best flavor at runtime.
+ */
+namespace Algorithms {
+
+/*
+ * Accumulates Hooke's and damper forces of the springs in [springStart, springEnd)
+ * onto their endpoints.
+ *
+ * The endpoints buffer contains point A and point B indices, interleaved. Springs
+ * whose endpoints coincide contribute no force.
+ */
+void UpdateSpringForces(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer);
+
+void UpdateSpringForces(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer);
+
+void UpdateSpringForces_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer);
+
+void UpdateSpringForces_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer);
+
+void UpdateSpringForces_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer);
+
+void UpdateSpringForces_AVX512(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStiffnessCoefficientBuffer,
+    float const * restrict springDampingCoefficientBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    vec2f const * restrict pointVelocityBuffer,
+    vec2f * restrict pointForceBuffer);
+
+/*
+ * Calculates the current length and the normalized vector - from point A to point B -
+ * of the springs in [springStart, springEnd).
+ *
+ * The endpoints buffer contains point A and point B indices, interleaved. Springs
+ * whose endpoints coincide get a zero normalized vector.
+ *
+ * With fast math, lengths and normalized vectors are calculated from one approximated
+ * inverse square root, rather than with a square root and two divisions.
+ */
+void CalculateSpringGeometry(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometry(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometry_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometry_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometry_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+/*
+ * Calculates the geometry of the springs in [springStart, springEnd) like CalculateSpringGeometry(),
+ * and in the same pass evaluates their strain from the lengths just calculated.
+ *
+ * A spring breaks when its strain exceeds its strength times the strength adjustment, and it
+ * is stressed when its strain exceeds half of that; the indices of the springs that break and of
+ * those that are stressed - but do not break - are appended to the respective buffers, advancing
+ * the counts, and the max ratio between strain and effective strength is max'ed into the last argument.
+ * Deleted springs get their geometry calculated, but neither break nor stress.
+ *
+ * The index buffers must have room for springEnd - springStart indices past their counts.
+ */
+void CalculateSpringGeometryAndStrains(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometryAndStrains(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometryAndStrains_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometryAndStrains_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringGeometryAndStrains_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    float const * restrict springRestLengthBuffer,
+    float const * restrict springStrengthBuffer,
+    bool const * restrict springIsDeletedBuffer,
+    float strengthAdjustment,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict springLengthBuffer,
+    vec2f * restrict springNormalizedVectorBuffer,
+    ElementIndex * restrict brokenSpringIndices,
+    ElementCount & brokenSpringCount,
+    ElementIndex * restrict stressedSpringIndices,
+    ElementCount & stressedSpringCount,
+    float & maxRelativeStrain,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+/*
+ * Calculates the scalar velocity of the water leaving each endpoint of the springs in
+ * [springStart, springEnd) along the spring, i.e. the component along the spring of the
+ * endpoint's own water velocity plus the velocity gained via Bernoulli's principle;
+ * velocities directed towards the endpoint are clamped to zero.
+ *
+ * This is the per-spring half of the water flow: the A -> B and B -> A velocities
+ * of a spring are calculated together, and what is needed of the two endpoints is
+ * only read, hence springs may be processed in packets.
+ *
+ * The endpoints buffer contains point A and point B indices, interleaved; the spring
+ * normalized vectors are oriented from point A to point B.
+ *
+ * With fast math, Bernoulli's velocities are calculated with an approximated square root.
+ */
+void CalculateSpringOutboundWaterVelocities(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringOutboundWaterVelocities(
+    InstructionSet instructionSet,
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringOutboundWaterVelocities_Naive(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringOutboundWaterVelocities_SSE2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateSpringOutboundWaterVelocities_AVX2(
+    ElementIndex springStart,
+    ElementIndex springEnd,
+    ElementIndex const * restrict springEndpointsBuffer,
+    vec2f const * restrict springNormalizedVectorBuffer,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterBuffer,
+    vec2f const * restrict pointWaterVelocityBuffer,
+    float waterCrazyness,
+    float gravityMagnitude,
+    float * restrict springOutboundWaterVelocityAToBBuffer,
+    float * restrict springOutboundWaterVelocityBToABuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+/*
+ * Calculates the water taken in - or let out, when negative - by each of the specified leaking
+ * points during one water dynamics step, via Bernoulli's principle applied to the difference between
+ * the height of the external water above the point and the water already in the point.
+ *
+ * Water let out never exceeds the water in the point, and some of it "sticks" into the material.
+ *
+ * The inflows are stored by position in the list of points, not by point index.
+ *
+ * With fast math, Bernoulli's velocities are calculated with an approximated square root.
+ */
+void CalculateLeakingPointWaterInflows(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateLeakingPointWaterInflows(
+    InstructionSet instructionSet,
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateLeakingPointWaterInflows_Naive(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateLeakingPointWaterInflows_SSE2(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+void CalculateLeakingPointWaterInflows_AVX2(
+    ElementIndex const * restrict pointIndices,
+    ElementCount pointCount,
+    vec2f const * restrict pointPositionBuffer,
+    float const * restrict pointWaterSurfaceHeightBuffer,
+    float const * restrict pointWaterBuffer,
+    float waterDynamicsSimulationStepTimeDuration,
+    float waterIntakeAdjustment,
+    float gravityMagnitude,
+    float * restrict inflowBuffer,
+    MathQuality mathQuality = MathQuality::Accurate);
+
+/*
+ * Samples a periodic height field at the x coordinates of the points in [pointStart, pointEnd),
+ * linearly interpolating between samples.
+ *
+ * The number of samples must be a power of two, and the samples buffer must contain
+ * one extra sample - equal to the first one - so that we never have to wrap around.
+ *
+ * The vectorized flavors convert sample indices to 32-bit integers, hence at x coordinates
+ * farther than 2^31 samples from the origin they return garbage - though still one of the
+ * samples.
+ */
+void SampleHeightField(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer);
+
+void SampleHeightField(
+    InstructionSet instructionSet,
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer);
+
+void SampleHeightField_Naive(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer);
+
+void SampleHeightField_SSE2(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer);
+
+void SampleHeightField_AVX2(
+    float const * restrict samples,
+    ElementCount samplesCount,
+    float dx,
+    ElementIndex pointStart,
+    ElementIndex pointEnd,
+    vec2f const * restrict pointPositionBuffer,
+    float * restrict heightBuffer);
+
+}
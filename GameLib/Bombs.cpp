@@ -59,6 +59,54 @@ void Bombs::OnPointDestroyed(ElementIndex pointElementIndex)
     }
 }
 
+void Bombs::OnElementsDestroyed(
+    std::vector<ElementIndex> const & pointElementIndices,
+    std::vector<ElementIndex> const & springElementIndices)
+{
+    auto squareNeighborhoodRadius = GameParameters::BombNeighborhoodRadius * GameParameters::BombNeighborhoodRadius;
+
+    for (auto & bomb : mCurrentBombs)
+    {
+        // Check if the bomb is attached to one of the springs
+        auto bombSpring = bomb->GetAttachedSpringIndex();
+        if (!!bombSpring && mShipSprings.IsDeleted(*bombSpring))
+        {
+            // Detach bomb
+            bomb->DetachIfAttached();
+        }
+
+        // Check if the bomb is within the neighborhood of any of the disturbed points or springs
+        bool isDisturbed = false;
+
+        for (auto pointElementIndex : pointElementIndices)
+        {
+            if ((bomb->GetPosition() - mShipPoints.GetPosition(pointElementIndex)).squareLength() < squareNeighborhoodRadius)
+            {
+                isDisturbed = true;
+                break;
+            }
+        }
+
+        if (!isDisturbed)
+        {
+            for (auto springElementIndex : springElementIndices)
+            {
+                if ((bomb->GetPosition() - mShipSprings.GetMidpointPosition(springElementIndex, mShipPoints)).squareLength() < squareNeighborhoodRadius)
+                {
+                    isDisturbed = true;
+                    break;
+                }
+            }
+        }
+
+        if (isDisturbed)
+        {
+            // Tel the bomb that its neighborhood has been disturbed
+            bomb->OnNeighborhoodDisturbed();
+        }
+    }
+}
+
 void Bombs::OnSpringDestroyed(ElementIndex springElementIndex)
 {
     auto squareNeighborhoodRadius = GameParameters::BombNeighborhoodRadius * GameParameters::BombNeighborhoodRadius;
@@ -15,6 +15,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace Physics
 {	
@@ -51,6 +52,14 @@ public:
 
     void OnSpringDestroyed(ElementIndex springElementIndex);
 
+    /*
+     * Notifies the bombs of a batch of points and springs that are being destroyed,
+     * while the points are still where they were.
+     */
+    void OnElementsDestroyed(
+        std::vector<ElementIndex> const & pointElementIndices,
+        std::vector<ElementIndex> const & springElementIndices);
+
     bool ToggleTimerBombAt(
         vec2f const & targetPos,
         GameParameters const & gameParameters)
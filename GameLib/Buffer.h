@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 
 /*
 * This class implements a simple buffer of "things". The buffer is fixed-size and cannot
@@ -112,6 +113,19 @@ public:
         std::memcpy(mBuffer, other.mBuffer, mSize * sizeof(TElement));
     }
 
+    /*
+     * Swaps the contents of this buffer with another buffer, without copying them.
+     *
+     * The sizes of the buffers must match.
+     */
+    void swap(Buffer<TElement> & other)
+    {
+        assert(mSize == other.mSize);
+
+        std::swap(mBuffer, other.mBuffer);
+        std::swap(mCurrentPopulatedSize, other.mCurrentPopulatedSize);
+    }
+
     /*
      * Gets an element.
      */
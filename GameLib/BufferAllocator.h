@@ -11,9 +11,32 @@
 #include <memory>
 #include <vector>
 
+/*
+ * A pool of buffers of the same size.
+ *
+ * Buffers go back to the pool when the pointers returned by Allocate() go out of scope;
+ * once the pool holds as many buffers as are ever in use at the same time, allocating
+ * and releasing buffers does not touch the heap anymore.
+ */
 template <typename TElement>
 class BufferAllocator
 {
+private:
+
+    struct Releaser
+    {
+        BufferAllocator * Allocator;
+
+        void operator()(Buffer<TElement> * buffer) const
+        {
+            Allocator->Release(buffer);
+        }
+    };
+
+public:
+
+    using BufferPtr = std::unique_ptr<Buffer<TElement>, Releaser>;
+
 public:
 
     BufferAllocator(size_t bufferSize)
@@ -22,7 +45,7 @@ public:
     {
     }
 
-    std::shared_ptr<Buffer<TElement>> Allocate()
+    BufferPtr Allocate()
     {
         Buffer<TElement> * buffer;
         if (!mPool.empty())
@@ -35,12 +58,9 @@ public:
             buffer = new Buffer<TElement>(mBufferSize);
         }
 
-        return std::shared_ptr<Buffer<TElement>>(
+        return BufferPtr(
             buffer,
-            [this](auto p)
-            {
-                this->Release(p);
-            });
+            Releaser{ this });
     }
 
 private:
@@ -5,12 +5,14 @@
 ***************************************************************************************/
 #pragma once
 
+#include "Buffer.h"
 #include "GameTypes.h"
 #include "SysSpecifics.h"
 
 #include <cassert>
 #include <cstdint>
 #include <iterator>
+#include <vector>
 
 /*
  * This class is the base class of all containers of core elements.
@@ -24,6 +26,22 @@ class ElementContainer
 {
 public:
 
+    /*
+     * A range of consecutive element indices.
+     */
+    struct ElementRange
+    {
+        ElementIndex Start;
+        ElementIndex End; // Exclusive
+
+        ElementRange(
+            ElementIndex start,
+            ElementIndex end)
+            : Start(start)
+            , End(end)
+        {}
+    };
+
     /*
      * Our iterator, which simply iterates through indices.
      */
@@ -94,12 +112,65 @@ public:
         return iterator(mElementCount);
     }
 
+    /*
+     * Gets the indices of the elements that were not deleted as of the last time
+     * the active elements were rebuilt.
+     *
+     * Elements deleted after that are still in here, hence visitors still have to
+     * check for deletion whenever it matters to them.
+     */
+    std::vector<ElementIndex> const & GetActiveElements() const
+    {
+        return mActiveElements;
+    }
+
+    /*
+     * Gets the same active elements as above, as maximal ranges of consecutive
+     * indices; for vectorized visitors.
+     */
+    std::vector<ElementRange> const & GetActiveElementRanges() const
+    {
+        return mActiveElementRanges;
+    }
+
 protected:
 
     ElementContainer(ElementCount elementCount)
         : mElementCount(elementCount)
         , mBufferElementCount(static_cast<ElementCount>(make_aligned_element_count(elementCount)))
+        , mActiveElements()
+        , mActiveElementRanges()
+    {
+        // All elements are alive at the beginning
+        mActiveElements.reserve(mElementCount);
+        for (ElementIndex i = 0; i < mElementCount; ++i)
+        {
+            mActiveElements.push_back(i);
+        }
+
+        if (mElementCount > 0)
+        {
+            mActiveElementRanges.emplace_back(0, mElementCount);
+        }
+    }
+
+    void RebuildActiveElements(Buffer<bool> const & isDeletedBuffer)
     {
+        mActiveElements.clear();
+        mActiveElementRanges.clear();
+
+        for (ElementIndex i = 0; i < mElementCount; ++i)
+        {
+            if (!isDeletedBuffer[i])
+            {
+                mActiveElements.push_back(i);
+
+                if (!mActiveElementRanges.empty() && mActiveElementRanges.back().End == i)
+                    ++(mActiveElementRanges.back().End);
+                else
+                    mActiveElementRanges.emplace_back(i, i + 1);
+            }
+        }
     }
 
     ElementCount const mElementCount;
@@ -108,4 +179,10 @@ protected:
     // differs from the element count as this is rounded up to the 
     // vectorization word size
     ElementCount const mBufferElementCount;
+
+private:
+
+    // The non-deleted elements, as of the last rebuild
+    std::vector<ElementIndex> mActiveElements;
+    std::vector<ElementRange> mActiveElementRanges;
 };
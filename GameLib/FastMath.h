@@ -0,0 +1,175 @@
+/***************************************************************************************
+* Original Author:      agent
+* Created:              2026-10-17
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include "SysSpecifics.h"
+
+#include <immintrin.h>
+
+#include <limits>
+
+/*
+ * Approximations of the transcendental functions used by the physics kernels,
+ * trading a bounded loss of accuracy for speed.
+ *
+ * Each function comes in an SSE, AVX2, and scalar flavor; all flavors of a function
+ * calculate exactly the same operations, hence they give the same results on the
+ * same inputs.
+ */
+
+/*
+ * The quality of the math used by a kernel.
+ */
+enum class MathQuality
+{
+    // Correctly-rounded square roots and divisions, and libm's transcendentals
+    Accurate,
+
+    // The approximations in this file
+    Fast
+};
+
+//
+// Inverse square root
+//
+// Hardware estimate (12 bits) refined with one Newton-Raphson step.
+//
+// Max relative error: 5.0e-7 (~4 ulp) over all positive normalized floats.
+//
+// Zero and negative arguments yield garbage (NaN or infinity), hence
+// callers must mask these themselves.
+//
+
+inline __m128 FastInverseSqrt(__m128 x)
+{
+    __m128 const y0 = _mm_rsqrt_ps(x);
+
+    // y1 = y0 * (1.5 - 0.5 * x * y0^2)
+    return _mm_mul_ps(
+        y0,
+        _mm_sub_ps(
+            _mm_set1_ps(1.5f),
+            _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_mul_ps(y0, y0))));
+}
+
+TARGET_AVX2
+inline __m256 FastInverseSqrt(__m256 x)
+{
+    __m256 const y0 = _mm256_rsqrt_ps(x);
+
+    // y1 = y0 * (1.5 - 0.5 * x * y0^2)
+    return _mm256_mul_ps(
+        y0,
+        _mm256_sub_ps(
+            _mm256_set1_ps(1.5f),
+            _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), _mm256_mul_ps(y0, y0))));
+}
+
+inline float FastInverseSqrt(float x)
+{
+    return _mm_cvtss_f32(FastInverseSqrt(_mm_set1_ps(x)));
+}
+
+//
+// Square root
+//
+// Calculated as x * 1/sqrt(x), with the argument of the latter clamped to the smallest
+// normalized float so that zero arguments yield exactly zero, without NaNs.
+//
+// Max relative error: same as FastInverseSqrt(). Negative arguments yield garbage.
+//
+
+inline __m128 FastSqrt(__m128 x)
+{
+    return _mm_mul_ps(
+        x,
+        FastInverseSqrt(_mm_max_ps(x, _mm_set1_ps(std::numeric_limits<float>::min()))));
+}
+
+TARGET_AVX2
+inline __m256 FastSqrt(__m256 x)
+{
+    return _mm256_mul_ps(
+        x,
+        FastInverseSqrt(_mm256_max_ps(x, _mm256_set1_ps(std::numeric_limits<float>::min()))));
+}
+
+inline float FastSqrt(float x)
+{
+    return _mm_cvtss_f32(FastSqrt(_mm_set1_ps(x)));
+}
+
+//
+// Exponential
+//
+// Range reduction to x = n * ln(2) + r, with |r| <= ln(2)/2 and ln(2) split in two
+// to keep r exact, followed by Cephes' degree-7 minimax polynomial for e^r, and
+// by the construction of 2^n in the exponent bits.
+//
+// Max relative error: 2.0e-7 (~2 ulp) over [-87.3, 88.3]; arguments are clamped
+// to this range, hence very negative arguments yield ~1.2e-38 rather than zero,
+// and very positive ones yield ~2.0e+38 rather than infinity.
+//
+
+inline __m128 FastExp(__m128 x)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-87.3f)), _mm_set1_ps(88.3f));
+
+    // n = round(x / ln(2))
+    __m128i const n = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)));
+    __m128 const nf = _mm_cvtepi32_ps(n);
+
+    // r = x - n * ln(2)
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(nf, _mm_set1_ps(0.693359375f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(nf, _mm_set1_ps(-2.12194440e-4f)));
+
+    // e^r ~= 1 + r + r^2 * P(r)
+    __m128 p = _mm_set1_ps(1.9875691500e-4f);
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.3981999507e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(8.3334519073e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(4.1665795894e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(1.6666665459e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, r), _mm_set1_ps(5.0000001201e-1f));
+    p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, _mm_mul_ps(r, r)), r), _mm_set1_ps(1.0f));
+
+    // 2^n
+    __m128 const pow2n = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+
+    return _mm_mul_ps(p, pow2n);
+}
+
+TARGET_AVX2
+inline __m256 FastExp(__m256 x)
+{
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-87.3f)), _mm256_set1_ps(88.3f));
+
+    // n = round(x / ln(2))
+    __m256i const n = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)));
+    __m256 const nf = _mm256_cvtepi32_ps(n);
+
+    // r = x - n * ln(2)
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(nf, _mm256_set1_ps(0.693359375f)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(nf, _mm256_set1_ps(-2.12194440e-4f)));
+
+    // e^r ~= 1 + r + r^2 * P(r)
+    __m256 p = _mm256_set1_ps(1.9875691500e-4f);
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.3981999507e-3f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(8.3334519073e-3f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(4.1665795894e-2f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.6666665459e-1f));
+    p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(5.0000001201e-1f));
+    p = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p, _mm256_mul_ps(r, r)), r), _mm256_set1_ps(1.0f));
+
+    // 2^n
+    __m256 const pow2n = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23));
+
+    return _mm256_mul_ps(p, pow2n);
+}
+
+inline float FastExp(float x)
+{
+    return _mm_cvtss_f32(FastExp(_mm_set1_ps(x)));
+}
@@ -5,90 +5,139 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Physics {
 
-void DrawForceField::Apply(Points & points) const
+void DrawForceField::Apply(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    vec2f const * restrict positionBuffer,
+    vec2f * restrict forceBuffer) const
 {
-    for (auto pointIndex : points)
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
         // F = ForceStrength/sqrt(distance), along radius
-        vec2f displacement = (mCenterPosition - points.GetPosition(pointIndex));
-        float forceMagnitude = mStrength / sqrtf(0.1f + displacement.length());
+        vec2f const displacement = (mCenterPosition - positionBuffer[pointIndex]);
+        float const displacementLength = displacement.length();
+        float const forceMagnitude = mStrength / sqrtf(0.1f + displacementLength);
 
-        points.GetForce(pointIndex) += displacement.normalise() * forceMagnitude;
+        forceBuffer[pointIndex] += displacement.normalise(displacementLength) * forceMagnitude;
     }
 }
 
-void SwirlForceField::Apply(Points & points) const
+void SwirlForceField::Apply(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    vec2f const * restrict positionBuffer,
+    vec2f * restrict forceBuffer) const
 {
-    for (auto pointIndex : points)
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
         // F = ForceStrength/sqrt(distance), perpendicular to radius
-        vec2f displacement = (mCenterPosition - points.GetPosition(pointIndex));
+        vec2f const displacement = (mCenterPosition - positionBuffer[pointIndex]);
         float const displacementLength = displacement.length();
-        float forceMagnitude = mStrength / sqrtf(0.1f + displacementLength);
+        float const forceMagnitude = mStrength / sqrtf(0.1f + displacementLength);
 
-        points.GetForce(pointIndex) += vec2f(-displacement.y, displacement.x) * forceMagnitude;
+        forceBuffer[pointIndex] += vec2f(-displacement.y, displacement.x) * forceMagnitude;
     }
 }
 
-void BlastForceField::Apply(Points & points) const
+bool BlastForceField::MayAffect(
+    vec2f const & position,
+    float margin) const
+{
+    float const reach = mBlastRadius + margin;
+
+    return (position - mCenterPosition).squareLength() <= reach * reach;
+}
+
+void BlastForceField::Apply(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    vec2f const * restrict positionBuffer,
+    vec2f * restrict forceBuffer) const
 {
-    for (auto pointIndex : points)
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
-        // TODO
+        vec2f const pointRadius = positionBuffer[pointIndex] - mCenterPosition;
+        float const pointRadiusLength = pointRadius.length();
+
+        // Fades out linearly to zero at the blast radius, and is zero beyond it, 
+        // which is thus just a multiplication rather than a branch
+        float const strength = mStrength * std::max(1.0f - pointRadiusLength / mBlastRadius, 0.0f);
+
+        forceBuffer[pointIndex] += pointRadius.normalise(pointRadiusLength) * strength;
     }
 }
 
-void RadialSpaceWarpForceField::Apply(Points & points) const
+bool RadialSpaceWarpForceField::MayAffect(
+    vec2f const & position,
+    float margin) const
 {
-    for (auto pointIndex : points)
+    // The field only lives on the ring between these two radii
+    float const innerRadius = std::max(mRadius - mRadiusThickness - margin, 0.0f);
+    float const outerRadius = mRadius + mRadiusThickness + margin;
+
+    float const squareDistance = (position - mCenterPosition).squareLength();
+
+    return squareDistance <= outerRadius * outerRadius
+        && squareDistance >= innerRadius * innerRadius;
+}
+
+void RadialSpaceWarpForceField::Apply(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    vec2f const * restrict positionBuffer,
+    vec2f * restrict forceBuffer) const
+{
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
-        if (!points.IsDeleted(pointIndex))
-        {
-            vec2f const pointRadius = points.GetPosition(pointIndex) - mCenterPosition;
-            float const pointDistanceFromRadius = pointRadius.length() - mRadius;
-            float const absolutePointDistanceFromRadius = std::abs(pointDistanceFromRadius);
-            if (absolutePointDistanceFromRadius <= mRadiusThickness)
-            {
-                float const direction = pointDistanceFromRadius >= 0.0f ? 1.0f : -1.0f;
-
-                float const strength = mStrength * (1.0f - absolutePointDistanceFromRadius / mRadiusThickness);
-
-                points.GetForce(pointIndex) +=
-                    pointRadius.normalise()
-                    * strength
-                    * direction;
-            }
-        }
+        vec2f const pointRadius = positionBuffer[pointIndex] - mCenterPosition;
+        float const pointRadiusLength = pointRadius.length();
+        float const pointDistanceFromRadius = pointRadiusLength - mRadius;
+        float const absolutePointDistanceFromRadius = std::abs(pointDistanceFromRadius);
+
+        float const direction = pointDistanceFromRadius >= 0.0f ? 1.0f : -1.0f;
+
+        // Zero for points farther than the thickness, which is thus just a 
+        // multiplication rather than a branch
+        float const strength = mStrength * std::max(1.0f - absolutePointDistanceFromRadius / mRadiusThickness, 0.0f);
+
+        forceBuffer[pointIndex] +=
+            pointRadius.normalise(pointRadiusLength)
+            * strength
+            * direction;
     }
 }
 
-void ImplosionForceField::Apply(Points & points) const
+void ImplosionForceField::Apply(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex,
+    vec2f const * restrict positionBuffer,
+    vec2f * restrict forceBuffer) const
 {
-    for (auto pointIndex : points)
+    for (ElementIndex pointIndex = startPointIndex; pointIndex < endPointIndex; ++pointIndex)
     {
-        if (!points.IsDeleted(pointIndex))
-        {            
-            vec2f displacement = (mCenterPosition - points.GetPosition(pointIndex));
-            float const displacementLength = displacement.length();
-            vec2f normalizedDisplacement = displacement.normalise(displacementLength);
-
-            // Angular - constant
-            points.GetForce(pointIndex) +=
-                vec2f(-normalizedDisplacement.y, normalizedDisplacement.x)
-                * mStrength
-                / 2.0f
-                ;
-
-            // Radial - stronger when closer
-            points.GetForce(pointIndex) += 
-                normalizedDisplacement 
-                * mStrength
-                / (1.0f + sqrt(displacementLength))
-                * 10.0f
-                ;
-        }
+        vec2f const displacement = (mCenterPosition - positionBuffer[pointIndex]);
+        float const displacementLength = displacement.length();
+        vec2f const normalizedDisplacement = displacement.normalise(displacementLength);
+
+        // Angular - constant
+        forceBuffer[pointIndex] +=
+            vec2f(-normalizedDisplacement.y, normalizedDisplacement.x)
+            * mStrength
+            / 2.0f
+            ;
+
+        // Radial - stronger when closer
+        forceBuffer[pointIndex] += 
+            normalizedDisplacement 
+            * mStrength
+            / (1.0f + sqrtf(displacementLength))
+            * 10.0f
+            ;
     }
 }
 
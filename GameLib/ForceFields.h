@@ -6,29 +6,31 @@
 #pragma once
 
 #include "GameParameters.h"
-#include "Physics.h"
+#include "GameTypes.h"
+#include "SysSpecifics.h"
 #include "Vectors.h"
 
+#include <variant>
+
 namespace Physics
 {	
 
-/*
- * This class represents an abstract force field that works on points.
- */
-class ForceField
-{
-public:
-
-    virtual ~ForceField()
-    {}
-
-    virtual void Apply(Points & points) const = 0;
-};
+//
+// The force fields that work on points.
+//
+// Force fields are stored by value and applied without virtual dispatch, to ranges
+// of points at a time; the loops only touch the position and force buffers, so that
+// the compiler may vectorize them. 
+//
+// Each force field also tells whether it reaches everywhere, and otherwise whether it may
+// have any effect at all on a point, give or take a margin; at each step the ship only
+// applies it to the runs of points it may reach.
+//
 
 /*
  * A radial force field that attracts all points to a center point.
  */
-class DrawForceField final : public ForceField
+class DrawForceField final
 {
 public:
 
@@ -39,7 +41,20 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(Points & points) const override;
+    static constexpr bool ReachesEverywhere = true;
+
+    bool MayAffect(
+        vec2f const & /*position*/,
+        float /*margin*/) const
+    {
+        return true;
+    }
+
+    void Apply(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        vec2f const * restrict positionBuffer,
+        vec2f * restrict forceBuffer) const;
 
 private:
 
@@ -50,7 +65,7 @@ private:
 /*
  * Angular force field that rotates all points around a center point.
  */
-class SwirlForceField final : public ForceField
+class SwirlForceField final
 {
 public:
 
@@ -61,7 +76,20 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(Points & points) const override;
+    static constexpr bool ReachesEverywhere = true;
+
+    bool MayAffect(
+        vec2f const & /*position*/,
+        float /*margin*/) const
+    {
+        return true;
+    }
+
+    void Apply(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        vec2f const * restrict positionBuffer,
+        vec2f * restrict forceBuffer) const;
 
 private:
 
@@ -70,31 +98,45 @@ private:
 };
 
 /*
- * Force field that simulates a blast around a center point.
+ * Force field that simulates a blast around a center point, pushing away the points
+ * within the blast radius - the harder the closer they are to the center.
  */
-class BlastForceField final : public ForceField
+class BlastForceField final
 {
 public:
 
     BlastForceField(
         vec2f const & centerPosition,
-        float blastRadius)
+        float blastRadius,
+        float strength)
         : mCenterPosition(centerPosition)
         , mBlastRadius(blastRadius)
+        , mStrength(strength)
     {}
 
-    virtual void Apply(Points & points) const override;
+    static constexpr bool ReachesEverywhere = false;
+
+    bool MayAffect(
+        vec2f const & position,
+        float margin) const;
+
+    void Apply(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        vec2f const * restrict positionBuffer,
+        vec2f * restrict forceBuffer) const;
 
 private:
 
     vec2f const mCenterPosition;
     float const mBlastRadius;
+    float const mStrength;
 };
 
 /*
  * Force field that simulates a space warp along a circle around a center point.
  */
-class RadialSpaceWarpForceField final : public ForceField
+class RadialSpaceWarpForceField final
 {
 public:
 
@@ -109,7 +151,17 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(Points & points) const override;
+    static constexpr bool ReachesEverywhere = false;
+
+    bool MayAffect(
+        vec2f const & position,
+        float margin) const;
+
+    void Apply(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        vec2f const * restrict positionBuffer,
+        vec2f * restrict forceBuffer) const;
 
 private:
 
@@ -123,7 +175,7 @@ private:
  * Force field that simulates a both angular and radial force sucking in all points towards
  * a center point.
  */
-class ImplosionForceField final : public ForceField
+class ImplosionForceField final
 {
 public:
 
@@ -134,7 +186,20 @@ public:
         , mStrength(strength)
     {}
 
-    virtual void Apply(Points & points) const override;
+    static constexpr bool ReachesEverywhere = true;
+
+    bool MayAffect(
+        vec2f const & /*position*/,
+        float /*margin*/) const
+    {
+        return true;
+    }
+
+    void Apply(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex,
+        vec2f const * restrict positionBuffer,
+        vec2f * restrict forceBuffer) const;
 
 private:
 
@@ -142,4 +207,11 @@ private:
     float const mStrength;
 };
 
+using ForceField = std::variant<
+    DrawForceField,
+    SwirlForceField,
+    BlastForceField,
+    RadialSpaceWarpForceField,
+    ImplosionForceField>;
+
 }
@@ -7,11 +7,14 @@
 
 #include "GameMath.h"
 #include "Log.h"
+#include "SysSpecifics.h"
 
 std::unique_ptr<GameController> GameController::Create(
     std::shared_ptr<ResourceLoader> resourceLoader,
     ProgressCallback const & progressCallback)
 {
+    LogMessage("Physics kernels instruction set: ", InstructionSetToStr(GetInstructionSet()));
+
     // Load materials
     auto materials = resourceLoader->LoadMaterials();
 
@@ -17,6 +17,7 @@
 #include "TextLayer.h"
 #include "Vectors.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <filesystem>
@@ -140,7 +141,12 @@ public:
     float GetStiffnessAdjustment() const { return mGameParameters.StiffnessAdjustment; }
     void SetStiffnessAdjustment(float value) { mGameParameters.StiffnessAdjustment = value; }
     float GetMinStiffnessAdjustment() const { return GameParameters::MinStiffnessAdjustment; }
-    float GetMaxStiffnessAdjustment() const { return GameParameters::MaxStiffnessAdjustment; }
+    float GetMaxStiffnessAdjustment() const
+    {
+        return mGameParameters.UsePositionBasedMechanicalSolver
+            ? GameParameters::MaxPositionBasedStiffnessAdjustment
+            : GameParameters::MaxStiffnessAdjustment;
+    }
 
     float GetStrengthAdjustment() const { return mGameParameters.StrengthAdjustment; }
     void SetStrengthAdjustment(float value) { mGameParameters.StrengthAdjustment = value; }
@@ -152,6 +158,35 @@ public:
     float GetMinBuoyancyAdjustment() const { return GameParameters::MinBuoyancyAdjustment; }
     float GetMaxBuoyancyAdjustment() const { return GameParameters::MaxBuoyancyAdjustment; }
 
+    bool GetUseFusedMechanicalIterations() const { return mGameParameters.UseFusedMechanicalIterations; }
+    void SetUseFusedMechanicalIterations(bool value) { mGameParameters.UseFusedMechanicalIterations = value; }
+
+    bool GetUsePositionBasedMechanicalSolver() const { return mGameParameters.UsePositionBasedMechanicalSolver; }
+    void SetUsePositionBasedMechanicalSolver(bool value)
+    {
+        mGameParameters.UsePositionBasedMechanicalSolver = value;
+
+        // The explicit solver can't take springs stiffer than its own max
+        if (!value)
+            mGameParameters.StiffnessAdjustment = std::min(mGameParameters.StiffnessAdjustment, GameParameters::MaxStiffnessAdjustment);
+    }
+
+    bool GetDoAdaptMechanicalIterations() const { return mGameParameters.DoAdaptMechanicalIterations; }
+    void SetDoAdaptMechanicalIterations(bool value) { mGameParameters.DoAdaptMechanicalIterations = value; }
+
+    MathQuality GetSpringGeometryMathQuality() const { return mGameParameters.SpringGeometryMathQuality; }
+    void SetSpringGeometryMathQuality(MathQuality value) { mGameParameters.SpringGeometryMathQuality = value; }
+
+    int GetWaterDynamicsUpdatePeriod() const { return mGameParameters.WaterDynamicsUpdatePeriod; }
+    void SetWaterDynamicsUpdatePeriod(int value) { mGameParameters.WaterDynamicsUpdatePeriod = value; }
+    int GetMinWaterDynamicsUpdatePeriod() const { return GameParameters::MinWaterDynamicsUpdatePeriod; }
+    int GetMaxWaterDynamicsUpdatePeriod() const { return GameParameters::MaxWaterDynamicsUpdatePeriod; }
+
+    int GetElectricalDynamicsUpdatePeriod() const { return mGameParameters.ElectricalDynamicsUpdatePeriod; }
+    void SetElectricalDynamicsUpdatePeriod(int value) { mGameParameters.ElectricalDynamicsUpdatePeriod = value; }
+    int GetMinElectricalDynamicsUpdatePeriod() const { return GameParameters::MinElectricalDynamicsUpdatePeriod; }
+    int GetMaxElectricalDynamicsUpdatePeriod() const { return GameParameters::MaxElectricalDynamicsUpdatePeriod; }
+
     float GetWaterIntakeAdjustment() const { return mGameParameters.WaterIntakeAdjustment; }
     void SetWaterIntakeAdjustment(float value) { mGameParameters.WaterIntakeAdjustment = value; }
     float GetMinWaterIntakeAdjustment() const { return GameParameters::MinWaterIntakeAdjustment; }
@@ -167,6 +202,15 @@ public:
     float GetMinWaterQuickness() const { return GameParameters::MinWaterQuickness; }
     float GetMaxWaterQuickness() const { return GameParameters::MaxWaterQuickness; }
 
+    bool GetUseEdgeCentricWaterFlow() const { return mGameParameters.UseEdgeCentricWaterFlow; }
+    void SetUseEdgeCentricWaterFlow(bool value) { mGameParameters.UseEdgeCentricWaterFlow = value; }
+
+    bool GetUseParallelWaterFlow() const { return mGameParameters.UseParallelWaterFlow; }
+    void SetUseParallelWaterFlow(bool value) { mGameParameters.UseParallelWaterFlow = value; }
+
+    MathQuality GetWaterMathQuality() const { return mGameParameters.WaterMathQuality; }
+    void SetWaterMathQuality(MathQuality value) { mGameParameters.WaterMathQuality = value; }
+
     float GetWaveHeight() const { return mGameParameters.WaveHeight; }
     void SetWaveHeight(float value) { mGameParameters.WaveHeight = value; }
     float GetMinWaveHeight() const { return GameParameters::MinWaveHeight; }
@@ -6,10 +6,11 @@
 #pragma once
 
 #include "IGameEventHandler.h"
-#include "TupleKeys.h"
 
 #include <algorithm>
 #include <optional>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 class GameEventDispatcher : public IGameEventHandler
@@ -64,7 +65,11 @@ public:
         bool isPinned,
         bool isUnderwater) override
     {
-        mPinToggledEvents.insert(std::make_tuple(isPinned, isUnderwater));
+        auto const key = std::make_tuple(isPinned, isUnderwater);
+        if (mPinToggledEvents.end() == std::find(mPinToggledEvents.begin(), mPinToggledEvents.end(), key))
+        {
+            mPinToggledEvents.push_back(key);
+        }
     }
 
     virtual void OnStress(
@@ -318,16 +323,60 @@ public:
 
 private:
 
+    /*
+     * Sums up values by key.
+     *
+     * A vector rather than a hash map, as there are only a handful of keys between
+     * flushes, and clearing a vector keeps its memory for the next ones - hence
+     * aggregating events doesn't allocate once warmed up.
+     */
+    template<typename TKey, typename TValue>
+    class Aggregation
+    {
+    public:
+
+        TValue & operator[](TKey const & key)
+        {
+            for (auto & entry : mEntries)
+            {
+                if (entry.first == key)
+                    return entry.second;
+            }
+
+            mEntries.emplace_back(key, TValue());
+            return mEntries.back().second;
+        }
+
+        typename std::vector<std::pair<TKey, TValue>>::const_iterator begin() const
+        {
+            return mEntries.begin();
+        }
+
+        typename std::vector<std::pair<TKey, TValue>>::const_iterator end() const
+        {
+            return mEntries.end();
+        }
+
+        void clear()
+        {
+            mEntries.clear();
+        }
+
+    private:
+
+        std::vector<std::pair<TKey, TValue>> mEntries;
+    };
+
     // The current events being aggregated
-    unordered_tuple_map<std::tuple<Material const *, bool>, unsigned int> mDestroyEvents;
-    unordered_tuple_set<std::tuple<bool, bool>> mPinToggledEvents;
-    unordered_tuple_map<std::tuple<Material const *, bool>, unsigned int> mStressEvents;
-    unordered_tuple_map<std::tuple<Material const *, bool>, unsigned int> mBreakEvents;
+    Aggregation<std::tuple<Material const *, bool>, unsigned int> mDestroyEvents;
+    std::vector<std::tuple<bool, bool>> mPinToggledEvents;
+    Aggregation<std::tuple<Material const *, bool>, unsigned int> mStressEvents;
+    Aggregation<std::tuple<Material const *, bool>, unsigned int> mBreakEvents;
     std::vector<unsigned int> mSinkingBeginEvents;
-    unordered_tuple_map<std::tuple<DurationShortLongType, bool>, unsigned int> mLightFlickerEvents;
-    unordered_tuple_map<std::tuple<BombType, bool>, unsigned int> mBombExplosionEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mRCBombPingEvents;
-    unordered_tuple_map<std::tuple<bool>, unsigned int> mTimerBombDefusedEvents;
+    Aggregation<std::tuple<DurationShortLongType, bool>, unsigned int> mLightFlickerEvents;
+    Aggregation<std::tuple<BombType, bool>, unsigned int> mBombExplosionEvents;
+    Aggregation<std::tuple<bool>, unsigned int> mRCBombPingEvents;
+    Aggregation<std::tuple<bool>, unsigned int> mTimerBombDefusedEvents;
 
     // The registered sinks
     std::vector<IGameEventHandler *> mSinks;
@@ -12,10 +12,20 @@ GameParameters::GameParameters()
     : StiffnessAdjustment(1.0f)
     , StrengthAdjustment(1.0f)
     , BuoyancyAdjustment(1.0f)
+    , UseFusedMechanicalIterations(false)
+    , UsePositionBasedMechanicalSolver(false)
+    , DoAdaptMechanicalIterations(false)
+    , ShipsUpdateTimeBudget(8000)
+    , SpringGeometryMathQuality(MathQuality::Accurate)
+    , WaterDynamicsUpdatePeriod(1)
+    , ElectricalDynamicsUpdatePeriod(1)
     // Water
     , WaterIntakeAdjustment(1.0f)
     , WaterCrazyness(1.0f)
     , WaterQuickness(0.5f)
+    , UseEdgeCentricWaterFlow(true)
+    , UseParallelWaterFlow(true)
+    , WaterMathQuality(MathQuality::Accurate)
     // Misc
     , WaveHeight(2.5f)
     , SeaDepth(200.0f)
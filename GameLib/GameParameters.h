@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "FastMath.h"
 #include "Vectors.h"
 
 #include <chrono>
@@ -77,6 +78,45 @@ struct GameParameters
 	static constexpr float MinBuoyancyAdjustment = 0.0f;
 	static constexpr float MaxBuoyancyAdjustment = 4.0f;
 
+    // When set, each mechanical iteration runs as a single pass over tiles of points
+    // and their springs, rather than as one pass for each of the mechanical stages
+    bool UseFusedMechanicalIterations;
+
+    // When set, ship structures are solved with extended position-based dynamics (XPBD)
+    // in a few substeps of a few constraint iterations each, rather than with explicit spring
+    // forces; XPBD is stable with any compliance, hence it allows for stiffer springs
+    bool UsePositionBasedMechanicalSolver;
+    static constexpr int NumPositionBasedMechanicalDynamicsSubsteps = 8;
+    static constexpr int NumPositionBasedMechanicalDynamicsIterations = 2;
+    static constexpr float MaxPositionBasedStiffnessAdjustment = 100.0f;
+
+    // When set, each ship chooses at each step its own number of mechanical iterations, 
+    // between the min and NumMechanicalDynamicsIterations, based on the stiffness adjustment,
+    // on the max strain of its springs, and on the time budget for updating all ships;
+    // bodies get softer with less iterations
+    bool DoAdaptMechanicalIterations;
+    static constexpr int MinNumMechanicalDynamicsIterations = 4;
+
+    std::chrono::microseconds ShipsUpdateTimeBudget;
+
+    // The quality of the math used for the current lengths and directions of springs;
+    // see FastMath.h for the errors of fast math, which is opt-in as it changes the simulation
+    MathQuality SpringGeometryMathQuality;
+
+    // Water dynamics run once every WaterDynamicsUpdatePeriod steps, moving at each update the
+    // water that would move in as many steps; electrical dynamics and light diffusion run once
+    // every ElectricalDynamicsUpdatePeriod steps, and in the steps in between lamps and light
+    // stay as they are. Ships offset subsystems from each other - and from the subsystems of
+    // other ships - so that their costs are spread over different steps. Both default to
+    // every step, as longer periods trade the smoothness of water and lights for speed
+    int WaterDynamicsUpdatePeriod;
+    static constexpr int MinWaterDynamicsUpdatePeriod = 1;
+    static constexpr int MaxWaterDynamicsUpdatePeriod = 4;
+
+    int ElectricalDynamicsUpdatePeriod;
+    static constexpr int MinElectricalDynamicsUpdatePeriod = 1;
+    static constexpr int MaxElectricalDynamicsUpdatePeriod = 8;
+
     // Water
 
     float WaterIntakeAdjustment;
@@ -91,6 +131,18 @@ struct GameParameters
     static constexpr float MinWaterQuickness = 0.001f;
     static constexpr float MaxWaterQuickness = 1.0f;
 
+    // When set, water flows are calculated by visiting springs rather than points,
+    // with the same results but in a way that may be vectorized
+    bool UseEdgeCentricWaterFlow;
+
+    // When set, water flows are calculated in parallel, with each point gathering
+    // the water flowing into it; takes precedence over the edge-centric flow, but
+    // only when there's more than one thread to run on
+    bool UseParallelWaterFlow;
+
+    // The quality of the math used for water velocities, intakes, and splashes; fast math is opt-in
+    MathQuality WaterMathQuality;
+
     // Misc
 
 	float WaveHeight;
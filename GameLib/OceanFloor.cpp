@@ -5,10 +5,15 @@
 ***************************************************************************************/
 #include "Physics.h"
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
 namespace Physics {
 
 OceanFloor::OceanFloor()
     : mSamples(new float[SamplesCount + 1])
+    , mMaxFloorHeight(std::numeric_limits<float>::max())
     , mCurrentSeaDepth(std::numeric_limits<float>::lowest())
 {
 }
@@ -28,9 +33,49 @@ void OceanFloor::Update(GameParameters const & gameParameters)
             mSamples[i] = (c1 + c2 - c3) - gameParameters.SeaDepth;
         }
 
+        mMaxFloorHeight = *std::max_element(mSamples.get(), mSamples.get() + SamplesCount + 1);
+
         // Remember current sea depth
         mCurrentSeaDepth = gameParameters.SeaDepth;
     }
 }
 
+float OceanFloor::GetMaxFloorHeightIn(
+    float minX,
+    float maxX) const
+{
+    assert(minX <= maxX);
+
+    //
+    // Heights are interpolated between samples, hence the max is at one of
+    // the samples delimiting the segments the range falls in
+    //
+
+    float const firstSampleIndex = floorf(minX / Dx);
+    float const lastSampleIndex = floorf(maxX / Dx) + 1.0f;
+
+    if (lastSampleIndex - firstSampleIndex >= static_cast<float>(SamplesCount))
+    {
+        // Covers the whole period
+        return mMaxFloorHeight;
+    }
+
+    int64_t index = static_cast<int64_t>(firstSampleIndex) % SamplesCount;
+    if (index < 0)
+        index += SamplesCount;
+
+    int64_t const count = static_cast<int64_t>(lastSampleIndex - firstSampleIndex) + 1;
+
+    float maxFloorHeight = std::numeric_limits<float>::lowest();
+    for (int64_t s = 0; s < count; ++s)
+    {
+        maxFloorHeight = std::max(maxFloorHeight, mSamples[index]);
+
+        if (++index == SamplesCount)
+            index = 0;
+    }
+
+    return maxFloorHeight;
+}
+
 }
\ No newline at end of file
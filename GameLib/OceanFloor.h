@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "Algorithms.h"
 #include "GameMath.h"
 #include "GameParameters.h"
 #include "Physics.h"
@@ -36,6 +37,34 @@ public:
             + (mSamples[index + 1] - mSamples[index]) * ((x / Dx) - absoluteSampleIndex);
     }
 
+    /*
+     * Calculates the floor height at the x coordinates of all the specified points,
+     * in one go.
+     */
+    void GetFloorHeightsAt(
+        ElementIndex pointStart,
+        ElementIndex pointEnd,
+        vec2f const * restrict pointPositionBuffer,
+        float * restrict heightBuffer) const
+    {
+        Algorithms::SampleHeightField(
+            mSamples.get(),
+            static_cast<ElementCount>(SamplesCount),
+            Dx,
+            pointStart,
+            pointEnd,
+            pointPositionBuffer,
+            heightBuffer);
+    }
+
+    /*
+     * Gets an upper bound of the floor height at all x coordinates between
+     * the two specified ones.
+     */
+    float GetMaxFloorHeightIn(
+        float minX,
+        float maxX) const;
+
 private:
 
     // Frequencies of the wave components
@@ -57,6 +86,9 @@ private:
     // The samples
     std::unique_ptr<float[]> mSamples;    
 
+    // The highest of the samples
+    float mMaxFloorHeight;
+
     // The sea depth for which we're current
     float mCurrentSeaDepth;
 };
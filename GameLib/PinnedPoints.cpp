@@ -56,6 +56,26 @@ void PinnedPoints::OnSpringDestroyed(ElementIndex springElementIndex)
     }
 }
 
+void PinnedPoints::OnElementsDestroyed(
+    std::vector<ElementIndex> const & pointElementIndices,
+    std::vector<ElementIndex> const & springElementIndices)
+{
+    //
+    // Unpin the points being destroyed, and the endpoints of the springs
+    // being destroyed that have now lost all of their springs
+    //
+
+    for (auto pointElementIndex : pointElementIndices)
+    {
+        OnPointDestroyed(pointElementIndex);
+    }
+
+    for (auto springElementIndex : springElementIndices)
+    {
+        OnSpringDestroyed(springElementIndex);
+    }
+}
+
 void PinnedPoints::Upload(
     int shipId,
     Render::RenderContext & renderContext) const
@@ -13,6 +13,7 @@
 #include "Vectors.h"
 
 #include <memory>
+#include <vector>
 
 namespace Physics
 {	
@@ -43,6 +44,14 @@ public:
 
     void OnSpringDestroyed(ElementIndex springElementIndex);
 
+    /*
+     * Notifies the pinned points of a batch of points and springs that are being
+     * destroyed, once the springs have been removed from their endpoints.
+     */
+    void OnElementsDestroyed(
+        std::vector<ElementIndex> const & pointElementIndices,
+        std::vector<ElementIndex> const & springElementIndices);
+
     bool ToggleAt(
         vec2f const & targetPos,
         GameParameters const & gameParameters)
@@ -34,6 +34,7 @@ void Points::Add(
 
     mBuoyancyBuffer.emplace_back(buoyancy);
     mWaterBuffer.emplace_back(0.0f);
+    mNewWaterBuffer.emplace_back(0.0f);
     mWaterVelocityBuffer.emplace_back(vec2f::zero());
     mWaterMomentumBuffer.emplace_back(vec2f::zero());
     mIsLeakingBuffer.emplace_back(false);    
@@ -69,6 +70,14 @@ void Points::Destroy(ElementIndex pointElementIndex)
         mParentWorld.IsUnderwater(GetPosition(pointElementIndex)),
         1u);
 
+    MarkDestroyed(pointElementIndex);
+}
+
+void Points::MarkDestroyed(ElementIndex pointElementIndex)
+{
+    assert(pointElementIndex < mElementCount);
+    assert(!IsDeleted(pointElementIndex));
+
     // Flag ourselves as deleted
     mIsDeletedBuffer[pointElementIndex] = true;
 
@@ -107,7 +116,7 @@ void Points::UploadElements(
     int shipId,
     Render::RenderContext & renderContext) const
 {
-    for (ElementIndex i : *this)
+    for (ElementIndex i : GetActiveElements())
     {
         if (!mIsDeletedBuffer[i])
         {
@@ -176,7 +185,46 @@ void Points::SetMassToMaterialOffset(
     }
 }
 
-vec2f Points::CalculateIntegrationFactor(float mass)
+void Points::UpdateCachedWaterSurfaceHeights(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    mParentWorld.GetWaterHeightsAt(
+        startPointIndex,
+        endPointIndex,
+        mPositionBuffer.data(),
+        mCachedWaterSurfaceHeightBuffer.data());
+}
+
+void Points::UpdateCachedOceanFloorHeights(
+    ElementIndex startPointIndex,
+    ElementIndex endPointIndex)
+{
+    mParentWorld.GetOceanFloorHeightsAt(
+        startPointIndex,
+        endPointIndex,
+        mPositionBuffer.data(),
+        mCachedOceanFloorHeightBuffer.data());
+}
+
+void Points::UpdateMechanicalDynamicsSimulationStepTimeDuration(float mechanicalDynamicsSimulationStepTimeDuration)
+{
+    if (mechanicalDynamicsSimulationStepTimeDuration != mCurrentMechanicalDynamicsSimulationStepTimeDuration)
+    {
+        mCurrentMechanicalDynamicsSimulationStepTimeDuration = mechanicalDynamicsSimulationStepTimeDuration;
+
+        // Recalc integration factors, leaving deleted and pinned points frozen
+        for (ElementIndex i : GetActiveElements())
+        {
+            if (!mIsDeletedBuffer[i] && !mIsPinnedBuffer[i])
+            {
+                mIntegrationFactorBuffer[i] = CalculateIntegrationFactor(mMassBuffer[i]);
+            }
+        }
+    }
+}
+
+vec2f Points::CalculateIntegrationFactor(float mass) const
 {
     assert(mass > 0.0f);
 
@@ -185,7 +233,7 @@ vec2f Points::CalculateIntegrationFactor(float mass)
     // yields the change in position, during a time interval equal to the dynamics simulation step.
     //
 
-    static constexpr float dt = GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;
+    float const dt = mCurrentMechanicalDynamicsSimulationStepTimeDuration;
     
     return vec2f(dt * dt / mass, dt * dt / mass);
 }
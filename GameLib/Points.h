@@ -68,9 +68,13 @@ public:
         , mForceBuffer(mBufferElementCount, mElementCount, vec2f::zero())
         , mIntegrationFactorBuffer(mBufferElementCount, mElementCount, vec2f::zero())
         , mMassBuffer(mBufferElementCount, mElementCount, 1.0f)
+        // Height cache
+        , mCachedWaterSurfaceHeightBuffer(mBufferElementCount, 0, 0.0f)
+        , mCachedOceanFloorHeightBuffer(mBufferElementCount, 0, 0.0f)
         // Water dynamics
         , mBuoyancyBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mWaterBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mNewWaterBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mWaterVelocityBuffer(mBufferElementCount, mElementCount, vec2f::zero())
         , mWaterMomentumBuffer(mBufferElementCount, mElementCount, vec2f::zero())
         , mIsLeakingBuffer(mBufferElementCount, mElementCount, false)
@@ -93,7 +97,9 @@ public:
         , mParentWorld(parentWorld)
         , mGameEventHandler(std::move(gameEventHandler))
         , mDestroyHandler()
+        , mCurrentMechanicalDynamicsSimulationStepTimeDuration(GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>)
         , mAreImmutableRenderAttributesUploaded(false)
+        , mLeakingPoints()
         , mFloatBufferAllocator(mBufferElementCount)
         , mVec2fBufferAllocator(mBufferElementCount)
     {
@@ -131,6 +137,12 @@ public:
 
     void Destroy(ElementIndex pointElementIndex);
 
+    /*
+     * Flags a point as deleted, without invoking the destroy handler and without
+     * firing events; batch destructions take care of both themselves.
+     */
+    void MarkDestroyed(ElementIndex pointElementIndex);
+
     //
     // Render
     //
@@ -158,6 +170,12 @@ public:
         return mIsDeletedBuffer[pointElementIndex];
     }
 
+    // Drops the elements deleted since the last rebuild from the active elements
+    void RebuildActiveElements()
+    {
+        ElementContainer::RebuildActiveElements(mIsDeletedBuffer);
+    }
+
     //
     // Material
     //
@@ -196,6 +214,16 @@ public:
         return reinterpret_cast<float *>(mPositionBuffer.data());
     }
 
+    vec2f const * restrict GetPositionBufferAsVec2() const
+    {
+        return mPositionBuffer.data();
+    }
+
+    vec2f * restrict GetPositionBufferAsVec2()
+    {
+        return mPositionBuffer.data();
+    }
+
     vec2f const & GetVelocity(ElementIndex pointElementIndex) const
     {
         return mVelocityBuffer[pointElementIndex];
@@ -211,6 +239,11 @@ public:
         return reinterpret_cast<float *>(mVelocityBuffer.data());
     }
 
+    vec2f * restrict GetVelocityBufferAsVec2()
+    {
+        return mVelocityBuffer.data();
+    }
+
     vec2f const & GetForce(ElementIndex pointElementIndex) const
     {
         return mForceBuffer[pointElementIndex];
@@ -226,6 +259,11 @@ public:
         return reinterpret_cast<float *>(mForceBuffer.data());
     }
 
+    vec2f * restrict GetForceBufferAsVec2()
+    {
+        return mForceBuffer.data();
+    }
+
     vec2f const & GetIntegrationFactor(ElementIndex pointElementIndex) const
     {
         return mIntegrationFactorBuffer[pointElementIndex];
@@ -246,6 +284,46 @@ public:
         float offset,
         Springs & springs);
 
+    float GetCurrentMechanicalDynamicsSimulationStepTimeDuration() const
+    {
+        return mCurrentMechanicalDynamicsSimulationStepTimeDuration;
+    }
+
+    /*
+     * Recalculates the integration factors, if the dt of each mechanical iteration has changed.
+     */
+    void UpdateMechanicalDynamicsSimulationStepTimeDuration(float mechanicalDynamicsSimulationStepTimeDuration);
+
+    //
+    // Height cache
+    //
+    // The heights of the water surface and of the ocean floor at each point,
+    // as of the last time they were updated
+    //
+
+    void UpdateCachedWaterSurfaceHeights(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
+    float GetCachedWaterSurfaceHeight(ElementIndex pointElementIndex) const
+    {
+        return mCachedWaterSurfaceHeightBuffer[pointElementIndex];
+    }
+
+    float const * restrict GetCachedWaterSurfaceHeightBufferAsFloat() const
+    {
+        return mCachedWaterSurfaceHeightBuffer.data();
+    }
+
+    void UpdateCachedOceanFloorHeights(
+        ElementIndex startPointIndex,
+        ElementIndex endPointIndex);
+
+    float GetCachedOceanFloorHeight(ElementIndex pointElementIndex) const
+    {
+        return mCachedOceanFloorHeightBuffer[pointElementIndex];
+    }
+
     //
     // Water dynamics
     //
@@ -255,6 +333,11 @@ public:
         return mBuoyancyBuffer[pointElementIndex];
     }
 
+    float const * restrict GetWaterBufferAsFloat() const
+    {
+        return mWaterBuffer.data();
+    }
+
     float * restrict GetWaterBufferAsFloat()
     {
         return mWaterBuffer.data();
@@ -271,19 +354,36 @@ public:
     {
         mWaterBuffer[pointElementIndex] += water;
         assert(mWaterBuffer[pointElementIndex] >= 0.0f);
+
+        // Keep the new buffer in sync
+        mNewWaterBuffer[pointElementIndex] = mWaterBuffer[pointElementIndex];
     }
 
-    std::shared_ptr<Buffer<float>> MakeWaterBufferCopy()
+    /*
+     * The buffer that water movements write their results into; holds the same 
+     * water as the current buffer until it is swapped in with SwapWaterBuffers().
+     */
+    float * restrict GetNewWaterBufferAsFloat()
     {
-        auto waterBufferCopy = mFloatBufferAllocator.Allocate();
-        waterBufferCopy->copy(mWaterBuffer);
-
-        return waterBufferCopy;
+        return mNewWaterBuffer.data();
     }
 
-    void UpdateWaterBuffer(std::shared_ptr<Buffer<float>> newWaterBuffer)
+    /*
+     * Makes the new water buffer the current one, and brings the other buffer
+     * back in sync; only the specified points are expected to have been changed
+     * in the new buffer, hence only those are copied.
+     */
+    void SwapWaterBuffers(std::vector<ElementIndex> const & changedPointIndices)
     {
-        mWaterBuffer.copy(*newWaterBuffer);
+        mWaterBuffer.swap(mNewWaterBuffer);
+
+        float * const restrict waterBuffer = mWaterBuffer.data();
+        float * restrict newWaterBuffer = mNewWaterBuffer.data();
+
+        for (auto p : changedPointIndices)
+        {
+            newWaterBuffer[p] = waterBuffer[p];
+        }
     }
 
     vec2f * restrict GetWaterVelocityBufferAsVec2()
@@ -314,6 +414,21 @@ public:
         }
     }
 
+    // Only for the specified points
+    void UpdateWaterMomentaFromVelocities(std::vector<ElementIndex> const & pointIndices)
+    {
+        float * const restrict waterBuffer = mWaterBuffer.data();
+        vec2f * const restrict waterVelocityBuffer = mWaterVelocityBuffer.data();
+        vec2f * restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
+
+        for (auto p : pointIndices)
+        {
+            waterMomentumBuffer[p] =
+                waterVelocityBuffer[p]
+                * waterBuffer[p];
+        }
+    }
+
     void UpdateWaterVelocitiesFromMomenta()
     {
         float * const restrict waterBuffer = mWaterBuffer.data();
@@ -336,6 +451,29 @@ public:
         }
     }
 
+    // Only for the specified points
+    void UpdateWaterVelocitiesFromMomenta(std::vector<ElementIndex> const & pointIndices)
+    {
+        float * const restrict waterBuffer = mWaterBuffer.data();
+        vec2f * restrict waterVelocityBuffer = mWaterVelocityBuffer.data();
+        vec2f * const restrict waterMomentumBuffer = mWaterMomentumBuffer.data();
+
+        for (auto p : pointIndices)
+        {
+            if (waterBuffer[p] != 0.0f)
+            {
+                waterVelocityBuffer[p] =
+                    waterMomentumBuffer[p]
+                    / waterBuffer[p];
+            }
+            else
+            {
+                // No mass, no velocity
+                waterVelocityBuffer[p] = vec2f::zero();
+            }
+        }
+    }
+
     bool IsLeaking(ElementIndex pointElementIndex) const
     {
         return mIsLeakingBuffer[pointElementIndex];
@@ -343,7 +481,18 @@ public:
 
     void SetLeaking(ElementIndex pointElementIndex)
     {
-        mIsLeakingBuffer[pointElementIndex] = true;
+        if (!mIsLeakingBuffer[pointElementIndex])
+        {
+            mIsLeakingBuffer[pointElementIndex] = true;
+            mLeakingPoints.push_back(pointElementIndex);
+        }
+    }
+
+    // All the points that have ever been set as leaking, including the ones
+    // that have been deleted since, in no particular order
+    std::vector<ElementIndex> const & GetLeakingPoints() const
+    {
+        return mLeakingPoints;
     }
 
     //
@@ -476,19 +625,19 @@ public:
     // Temporary buffer
     //
 
-    std::shared_ptr<Buffer<float>> AllocateWorkBufferFloat()
+    BufferAllocator<float>::BufferPtr AllocateWorkBufferFloat()
     {
         return mFloatBufferAllocator.Allocate();
     }
 
-    std::shared_ptr<Buffer<vec2f>> AllocateWorkBufferVec2f()
+    BufferAllocator<vec2f>::BufferPtr AllocateWorkBufferVec2f()
     {
         return mVec2fBufferAllocator.Allocate();
     }
 
 private:
 
-    static vec2f CalculateIntegrationFactor(float mass);
+    vec2f CalculateIntegrationFactor(float mass) const;
 
 private:
 
@@ -514,6 +663,13 @@ private:
     Buffer<vec2f> mIntegrationFactorBuffer;
     Buffer<float> mMassBuffer;
 
+    //
+    // Height cache
+    //
+
+    Buffer<float> mCachedWaterSurfaceHeightBuffer;
+    Buffer<float> mCachedOceanFloorHeightBuffer;
+
     //
     // Water dynamics
     //
@@ -524,6 +680,10 @@ private:
     // this point. Quantity of water is max(water, 1.0)
     Buffer<float> mWaterBuffer;
 
+    // The buffer the next water quantities are calculated into, swapped with the
+    // buffer above at each water iteration; in sync with it between iterations
+    Buffer<float> mNewWaterBuffer;
+
     // Total velocity of the water at this point
     Buffer<vec2f> mWaterVelocityBuffer;
 
@@ -579,10 +739,17 @@ private:
     // The handler registered for point deletions
     DestroyHandler mDestroyHandler;
 
+    // The dt of each mechanical iteration that the integration factors are currently calculated for
+    float mCurrentMechanicalDynamicsSimulationStepTimeDuration;
+
     // Flag remembering whether or not we've already uploaded
     // the immutable render attributes
     bool mutable mAreImmutableRenderAttributesUploaded;
 
+    // The indices of the points that are leaking; points never stop leaking, 
+    // hence this only grows
+    std::vector<ElementIndex> mLeakingPoints;
+
     // Allocators for work buffers
     BufferAllocator<float> mFloatBufferAllocator;
     BufferAllocator<vec2f> mVec2fBufferAllocator;
@@ -5,16 +5,20 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include "Algorithms.h"
 #include "Log.h"
 #include "Segment.h"
 
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <queue>
 #include <set>
+#include <type_traits>
 
 namespace Physics {
 
@@ -46,10 +50,49 @@ Ship::Ship(
     , mTriangles(std::move(triangles))
     , mElectricalElements(std::move(electricalElements))
     , mConnectedComponentSizes()
+    , mConnectedComponentPointOffsets()
+    , mConnectedComponentPoints()
+    , mConnectedComponentSplitCandidates()
+    , mConnectedComponentSplitRepresentatives()
+    , mConnectedComponentSearchPointsA()
+    , mConnectedComponentSearchPointsB()
+    , mConnectedComponentSearchMarks(mPoints.GetElementCount(), 0)
+    , mCurrentConnectedComponentSearchMark(0)
+    , mBatchDestroyedPoints()
+    , mBatchDestroyedSprings()
+    , mBatchDestroyedTriangles()
+    , mBatchDestroyEvents()
+    , mConnectedComponentSleepStates()
+    , mSleepCheckPositions(mPoints.GetPositionBufferAsVec2(), mPoints.GetPositionBufferAsVec2() + mPoints.GetElementCount())
+    , mSleepCheckIsUnderwater(mPoints.GetElementCount(), false)
+    , mSleepGameParameters()
+    , mAwakePoints()
+    , mAwakePointRanges()
+    , mAwakeSpringRanges()
+    , mAreAwakeElementsDirty(true)
+    , mAwakeLeakingPoints()
+    , mAwakeLeakingPointInflows()
+    , mSleepingPoints()
+    , mSleepingPointRanges()
+    , mSleepingLeakingPoints()
+    , mSleepingLeakingPointInflows()
     , mAreElementsDirty(true)
     , mIsSinking(false)
     , mTotalWater(0.0)
     , mWaterSplashedRunningAverage()
+    , mCurrentWaterDynamicsSimulationStepTimeDuration(GameParameters::WaterDynamicsSimulationStepTimeDuration<float>)
+    , mCurrentWaterQuickness(0.0f)
+    , mStepCount(0)
+    , mIsElectricalConnectivityDirty(true)
+    , mElectricalConnectivityVisitSequenceNumber(NoneVisitSequenceNumber)
+    , mAreGeneratorsDry(mElectricalElements.GetGenerators().size(), true)
+    , mElectricalElementsToVisit()
+    , mIsLightDirty(true)
+    , mLampLights(mElectricalElements.GetLamps().size(), 0.0f)
+    , mLightDiffusionAdjustment(0.0f)
+    , mLightDiffusionGridPoints()
+    , mLightDiffusionGridCellStarts()
+    , mConnectedComponentLights()
     , mPinnedPoints(
         mParentWorld,
         mGameEventHandler,
@@ -62,6 +105,35 @@ Ship::Ship(
         mPoints,
         mSprings)
     , mCurrentForceFields()
+    , mForceFieldPointRanges()
+    , mForceFieldPointRangeOffsets()
+    , mMechanicalIterationsCount(GameParameters::NumMechanicalDynamicsIterations<int>)
+    , mStepsSinceMechanicalIterationsCountChange(0)
+    , mCurrentGlobalDampCoefficient(GlobalDampCoefficient)
+    , mPositionBasedPreviousPositions(mPoints.GetElementCount(), vec2f::zero())
+    , mPositionBasedSpringLambdas(mSprings.GetElementCount(), 0.0f)
+    , mSpringForcesColorBatches()
+    , mSpringForcesTasks()
+    , mPointWetFrontStates(mPoints.GetElementCount(), WetFrontState::Dry)
+    , mWetFrontPoints()
+    , mWetFrontSprings()
+    , mSortedWetFrontPointsCount(0)
+    , mSortedWetFrontSpringsCount(0)
+    , mWetFrontMergeBuffer()
+    , mAwakeWetFrontPoints()
+    , mAwakeWetFrontSpringRanges()
+    , mIsAwakeWetFrontDirty(true)
+    , mWaterFlowSpringChunks()
+    , mWaterFlowSpringTasks()
+    , mWaterFlowPointTasks()
+    , mCurrentWaterFlowPass(nullptr)
+    , mCurrentWaterFlowPassRunner(nullptr)
+    , mWaterSplashedChunkSums()
+    , mFusedMechanicalTiles()
+    , mConnectedComponentAABBs()
+    , mConnectedComponentMaxSquareVelocities()
+    , mIsConnectedComponentNearSeaFloor()
+    , mSeaFloorCollisionCandidatePointRanges()
 {
     // Set destroy handlers
     mPoints.RegisterDestroyHandler(std::bind(&Ship::PointDestroyHandler, this, std::placeholders::_1));
@@ -71,6 +143,33 @@ Ship::Ship(
 
     // Do a first connected component detection pass 
     DetectConnectedComponents(currentVisitSequenceNumber);
+
+    // Find the points that have water
+    ResetWetFront();
+
+    // Prepare the parallel spring forces tasks
+    MakeSpringForcesTasks();
+
+    // Prepare the layout for fused mechanical iterations; its awake elements follow
+    // the ship's at the first step
+    MakeFusedMechanicalTiles();
+
+    // Make room in the scratch vectors for as many elements as they might ever hold,
+    // so that updates don't allocate
+    mElectricalElementsToVisit.reserve(mElectricalElements.GetElementCount());
+    mConnectedComponentSearchPointsA.reserve(mPoints.GetElementCount());
+    mConnectedComponentSearchPointsB.reserve(mPoints.GetElementCount());
+    mAwakePoints.reserve(mPoints.GetElementCount());
+    mWetFrontPoints.reserve(mPoints.GetElementCount());
+    mWetFrontSprings.reserve(mSprings.GetElementCount());
+    mWetFrontMergeBuffer.reserve(std::max(mPoints.GetElementCount(), mSprings.GetElementCount()));
+    mAwakeWetFrontPoints.reserve(mPoints.GetElementCount());
+    mAwakeLeakingPoints.reserve(mPoints.GetElementCount());
+    mAwakeLeakingPointInflows.reserve(mPoints.GetElementCount());
+    mSleepingPoints.reserve(mPoints.GetElementCount());
+    mSleepingLeakingPoints.reserve(mPoints.GetElementCount());
+    mSleepingLeakingPointInflows.reserve(mPoints.GetElementCount());
+    mLightDiffusionGridPoints.reserve(mPoints.GetElementCount());
 }
 
 Ship::~Ship()
@@ -83,29 +182,36 @@ void Ship::DestroyAt(
 {
     float const squareRadius = radius * radius;
 
-    // Destroy all points within the radius
-    for (auto pointIndex : mPoints)
+    WakeUpAllConnectedComponents();
+
+    // Find all points within the radius...
+    mBatchDestroyedPoints.clear();
+    for (auto pointIndex : mPoints.GetActiveElements())
     {
         if (!mPoints.IsDeleted(pointIndex))
         {
             if ((mPoints.GetPosition(pointIndex) - targetPos).squareLength() < squareRadius)
             {
-                // Destroy point
-                mPoints.Destroy(pointIndex);
+                mBatchDestroyedPoints.push_back(pointIndex);
             }
         }
     }
+
+    // ...and destroy them all at once
+    DestroyPoints(mBatchDestroyedPoints);
 }
 
 void Ship::SawThrough(
     vec2f const & startPos,
     vec2f const & endPos)
 {
+    WakeUpAllConnectedComponents();
+
     //
     // Find all springs that intersect the saw segment
     //
 
-    for (auto springIndex : mSprings)
+    for (auto springIndex : mSprings.GetActiveElements())
     {
         if (!mSprings.IsDeleted(springIndex))
         {
@@ -132,7 +238,7 @@ void Ship::DrawTo(
 {
     // Store the force field
     mCurrentForceFields.emplace_back(
-        new DrawForceField(
+        DrawForceField(
             targetPos,
             strength));
 }
@@ -143,7 +249,7 @@ void Ship::SwirlAt(
 {
     // Store the force field
     mCurrentForceFields.emplace_back(
-        new SwirlForceField(
+        SwirlForceField(
             targetPos,
             strength));
 }
@@ -152,6 +258,8 @@ bool Ship::TogglePinAt(
     vec2f const & targetPos,
     GameParameters const & gameParameters)
 {
+    WakeUpAllConnectedComponents();
+
     return mPinnedPoints.ToggleAt(
         targetPos,
         gameParameters);
@@ -161,6 +269,8 @@ bool Ship::ToggleTimerBombAt(
     vec2f const & targetPos,
     GameParameters const & gameParameters)
 {
+    WakeUpAllConnectedComponents();
+
     return mBombs.ToggleTimerBombAt(
         targetPos,
         gameParameters);
@@ -170,6 +280,8 @@ bool Ship::ToggleRCBombAt(
     vec2f const & targetPos,
     GameParameters const & gameParameters)
 {
+    WakeUpAllConnectedComponents();
+
     return mBombs.ToggleRCBombAt(
         targetPos,
         gameParameters);
@@ -179,6 +291,8 @@ bool Ship::ToggleAntiMatterBombAt(
     vec2f const & targetPos,
     GameParameters const & gameParameters)
 {
+    WakeUpAllConnectedComponents();
+
     return mBombs.ToggleAntiMatterBombAt(
         targetPos,
         gameParameters);
@@ -186,11 +300,15 @@ bool Ship::ToggleAntiMatterBombAt(
 
 void Ship::DetonateRCBombs()
 {
+    WakeUpAllConnectedComponents();
+
     mBombs.DetonateRCBombs();
 }
 
 void Ship::DetonateAntiMatterBombs()
 {
+    WakeUpAllConnectedComponents();
+
     mBombs.DetonateAntiMatterBombs();
 }
 
@@ -203,7 +321,7 @@ ElementIndex Ship::GetNearestPointIndexAt(
     ElementIndex bestPointIndex = NoneElementIndex;
     float bestSquareDistance = std::numeric_limits<float>::max();
 
-    for (auto pointIndex : mPoints)
+    for (auto pointIndex : mPoints.GetActiveElements())
     {
         if (!mPoints.IsDeleted(pointIndex))
         {
@@ -223,6 +341,13 @@ void Ship::Update(
     VisitSequenceNumber currentVisitSequenceNumber,
     GameParameters const & gameParameters)
 {
+    //
+    // Choose the number of mechanical iterations for this step
+    //
+
+    UpdateMechanicalIterationsCount(gameParameters);
+
+
     //
     // Process eventual parameter changes
     //
@@ -236,6 +361,23 @@ void Ship::Update(
     // Update mechanical dynamics
     //
 
+    // Force fields might affect any point, hence nobody may sleep
+    if (!mCurrentForceFields.empty())
+    {
+        WakeUpAllConnectedComponents();
+    }
+
+    // Bodies at rest are only at rest with the parameters they fell asleep with
+    if (mSleepGameParameters.Update(gameParameters))
+    {
+        WakeUpAllConnectedComponents();
+    }
+
+    if (mAreAwakeElementsDirty)
+    {
+        RebuildAwakeElements();
+    }
+
     UpdateMechanicalDynamics(gameParameters);
 
 
@@ -250,39 +392,78 @@ void Ship::Update(
 
 
     //
-    // Update strain for all springs; might cause springs to break
-    // (which would flag our elements as dirty)
+    // Calculate spring lengths and directions, once for all the
+    // passes that follow, and update strain for all springs in the
+    // same pass; might cause springs to break (which would flag our
+    // elements as dirty)
     //
 
-    mSprings.UpdateStrains(
+    mSprings.UpdateCurrentGeometryAndStrains(
         gameParameters,
         mPoints);
 
 
     //
-    // Detect connected components, if there have been any deletions
+    // Update connected components, if there have been any deletions
     //
 
     if (mAreElementsDirty)
     {
-        DetectConnectedComponents(currentVisitSequenceNumber);
+        // Stop visiting deleted elements
+        mPoints.RebuildActiveElements();
+        mSprings.RebuildActiveElements();
+        mTriangles.RebuildActiveElements();
+
+        UpdateConnectedComponents();
+
+        // The wet front knows nothing about deletions
+        ResetWetFront();
+    }
+
+
+    //
+    // Update water dynamics, at their own pace
+    //
+
+    // Bomb explosions and connected components detection might have woken up
+    // connected components
+    if (mAreAwakeElementsDirty)
+    {
+        RebuildAwakeElements();
+    }
+
+    // Sleeping points don't move, but the water surface under them does; sample it
+    // once per step, for the checks that might wake them up
+    for (auto const & range : mSleepingPointRanges)
+    {
+        mPoints.UpdateCachedWaterSurfaceHeights(range.Start, range.End);
+    }
+
+    if (IsSubsystemUpdateStep(gameParameters.WaterDynamicsUpdatePeriod, WaterDynamicsUpdatePhase))
+    {
+        UpdateWaterDynamics(gameParameters);
     }
 
 
     //
-    // Update water dynamics
+    // Put to sleep connected components that have come to rest
     //
 
-    UpdateWaterDynamics(gameParameters);
+    UpdateConnectedComponentSleepStates(gameParameters);
 
 
     //
-    // Update electrical dynamics
+    // Update electrical dynamics, at their own pace
     //
 
-    UpdateElectricalDynamics(
-        currentVisitSequenceNumber, 
-        gameParameters);
+    if (IsSubsystemUpdateStep(gameParameters.ElectricalDynamicsUpdatePeriod, ElectricalDynamicsUpdatePhase))
+    {
+        UpdateElectricalDynamics(
+            currentVisitSequenceNumber,
+            gameParameters);
+    }
+
+    ++mStepCount;
 }
 
 void Ship::Render(
@@ -411,15 +592,125 @@ void Ship::Render(
 // Mechanical Dynamics
 ///////////////////////////////////////////////////////////////////////////////////
 
+void Ship::UpdateMechanicalIterationsCount(GameParameters const & gameParameters)
+{
+    static constexpr int MinIterationsCount = GameParameters::MinNumMechanicalDynamicsIterations;
+    static constexpr int MaxIterationsCount = GameParameters::NumMechanicalDynamicsIterations<int>;
+
+    // Lowering the count is deferred until it's been stable for this many steps,
+    // as each change requires recalculating all coefficients
+    static constexpr unsigned int StepsBeforeLoweringIterationsCount = 25;
+
+    int targetIterationsCount = MaxIterationsCount;
+    if (gameParameters.UsePositionBasedMechanicalSolver)
+    {
+        // Each iteration is a substep of the position-based solver
+        targetIterationsCount = GameParameters::NumPositionBasedMechanicalDynamicsSubsteps;
+
+        // No point in changing gently
+        mStepsSinceMechanicalIterationsCountChange = StepsBeforeLoweringIterationsCount;
+    }
+    else if (gameParameters.DoAdaptMechanicalIterations)
+    {
+        // Springs close to being stressed need all the iterations we have, 
+        // while relaxed ones may do with less
+        float const strainRequirement = std::min(mSprings.GetMaxRelativeStrain() / 0.5f, 1.0f);
+
+        // Bodies stiffer than nominal need all the iterations we have in order to stay stiff
+        float const stiffnessRequirement = std::max(
+            std::min(
+                (gameParameters.StiffnessAdjustment - 1.0f) / (GameParameters::MaxStiffnessAdjustment - 1.0f),
+                1.0f),
+            0.0f);
+
+        float const requiredIterationsCount =
+            static_cast<float>(MinIterationsCount)
+            + static_cast<float>(MaxIterationsCount - MinIterationsCount) * std::max(strainRequirement, stiffnessRequirement);
+
+        // The world's time budget caps all ships
+        float const allowedIterationsCount =
+            static_cast<float>(MaxIterationsCount)
+            * mParentWorld.GetMechanicalIterationsBudget();
+
+        targetIterationsCount = std::max(
+            std::min(
+                static_cast<int>(std::ceil(std::min(requiredIterationsCount, allowedIterationsCount))),
+                MaxIterationsCount),
+            MinIterationsCount);
+    }
+
+    ++mStepsSinceMechanicalIterationsCountChange;
+
+    int newIterationsCount = mMechanicalIterationsCount;
+    if (targetIterationsCount > mMechanicalIterationsCount)
+    {
+        // Raise immediately
+        newIterationsCount = targetIterationsCount;
+    }
+    else if (targetIterationsCount < mMechanicalIterationsCount
+        && mStepsSinceMechanicalIterationsCountChange >= StepsBeforeLoweringIterationsCount)
+    {
+        // Lower gently
+        newIterationsCount = mMechanicalIterationsCount - 1;
+    }
+
+    if (newIterationsCount != mMechanicalIterationsCount)
+    {
+        mMechanicalIterationsCount = newIterationsCount;
+        mStepsSinceMechanicalIterationsCountChange = 0;
+
+        // Recalculate the integration factors for the new dt; the springs 
+        // will follow with their coefficients when they see the new dt
+        mPoints.UpdateMechanicalDynamicsSimulationStepTimeDuration(
+            GameParameters::SimulationStepTimeDuration<float> / static_cast<float>(mMechanicalIterationsCount));
+
+        // Keep the global damp of a whole step the same
+        mCurrentGlobalDampCoefficient = std::pow(
+            GlobalDampCoefficient,
+            GameParameters::NumMechanicalDynamicsIterations<float> / static_cast<float>(mMechanicalIterationsCount));
+    }
+}
+
 void Ship::UpdateMechanicalDynamics(GameParameters const & gameParameters)
 {
-    for (int iter = 0; iter < GameParameters::NumMechanicalDynamicsIterations<int>; ++iter)
+    if (gameParameters.UsePositionBasedMechanicalSolver)
     {
-        // Apply force fields - if we have any
-        for (auto const & forceField : mCurrentForceFields)
+        UpdateMechanicalDynamicsPositionBased(gameParameters);
+        return;
+    }
+
+    if (gameParameters.UseFusedMechanicalIterations)
+    {
+        UpdateMechanicalDynamicsFused(gameParameters);
+        return;
+    }
+
+    // Gather the current coefficients of the awake springs into the order of
+    // the parallel spring forces - if we run them in parallel
+    if (!mSpringForcesTasks.empty())
+    {
+        auto & batches = mSpringForcesColorBatches;
+
+        for (auto const & awakeRange : batches.AwakeSpringRanges)
         {
-            forceField->Apply(mPoints);
+            for (ElementIndex s = awakeRange.Start; s < awakeRange.End; ++s)
+            {
+                batches.SpringStiffnessCoefficients[s] = mSprings.GetStiffnessCoefficient(batches.SpringIndices[s]);
+                batches.SpringDampingCoefficients[s] = mSprings.GetDampingCoefficient(batches.SpringIndices[s]);
+            }
         }
+    }
+
+    // Find the points that might hit the sea floor during this step
+    DetectSeaFloorCollisionCandidates();
+
+    // Find the points that each force field might reach during this step
+    CullForceFields();
+
+    for (int iter = 0; iter < mMechanicalIterationsCount; ++iter)
+    {
+        // Apply force fields - if we have any
+        ApplyForceFields();
 
         // Update point forces
         UpdatePointForces(gameParameters);
@@ -438,795 +729,2979 @@ void Ship::UpdateMechanicalDynamics(GameParameters const & gameParameters)
     mCurrentForceFields.clear();
 }
 
-void Ship::UpdatePointForces(GameParameters const & gameParameters)
+void Ship::UpdateMechanicalDynamicsFused(GameParameters const & gameParameters)
 {
-    // Water mass = 1000Kg
-    static constexpr float WaterMass = 1000.0f;
-
-    // Effective water mass that we want to use for buoyancy calculation
-    float const BuoyancyAdjustedWaterMass = WaterMass * gameParameters.BuoyancyAdjustment;
+    auto & tiles = mFusedMechanicalTiles;
 
-    // Underwater points feel this amount of water drag
     //
-    // The higher the value, the more viscous the water looks when a body moves through it
-    constexpr float WaterDragCoefficient = 0.020f; // ~= 1.0f - powf(0.6f, 0.02f)
-    
-    for (auto pointIndex : mPoints)
+    // Gather the current coefficients of the awake springs into our tile order
+    //
+
+    ElementIndex const * restrict springIndices = tiles.SpringIndices.data();
+    float * restrict springStiffnessCoefficients = tiles.SpringStiffnessCoefficients.data();
+    float * restrict springDampingCoefficients = tiles.SpringDampingCoefficients.data();
+
+    for (auto const & awakeRange : tiles.AwakeSpringRanges)
     {
-        // Get height of water at this point
-        float const waterHeightAtThisPoint = mParentWorld.GetWaterHeightAt(mPoints.GetPosition(pointIndex).x);
+        for (ElementIndex s = awakeRange.Start; s < awakeRange.End; ++s)
+        {
+            springStiffnessCoefficients[s] = mSprings.GetStiffnessCoefficient(springIndices[s]);
+            springDampingCoefficients[s] = mSprings.GetDampingCoefficient(springIndices[s]);
+        }
+    }
 
-        //
-        // 1. Add gravity and buoyancy
-        //        
+    float const buoyancyAdjustedWaterMass = WaterMass * gameParameters.BuoyancyAdjustment;
 
-        // Mass = own + contained water (clamped to 1)
-        mPoints.GetForce(pointIndex) += gameParameters.Gravity
-            * (mPoints.GetMass(pointIndex) + std::min(mPoints.GetWater(pointIndex), 1.0f) * 1000.0f);
+    ElementCount const pointCount = mPoints.GetElementCount();
+    size_t const tileCount = tiles.SpringTileEnds.size();
 
-        if (mPoints.GetPosition(pointIndex).y < waterHeightAtThisPoint)
+    // Find the points that might hit the sea floor during this step
+    DetectSeaFloorCollisionCandidates();
+
+    // Find the points that each force field might reach during this step
+    CullForceFields();
+
+    for (int iter = 0; iter < mMechanicalIterationsCount; ++iter)
+    {
+        // Apply force fields - if we have any; these are rare enough that
+        // we don't bother fusing them
+        ApplyForceFields();
+
+        size_t springRangeStart = 0;
+        ElementIndex pointStart = 0;
+        size_t awakePointRange = 0;
+        for (size_t t = 0; t < tileCount; ++t)
         {
             //
-            // Apply upward push of water mass (i.e. buoyancy!)
-            //
-            // We don't want hull points to feel buoyancy, otherwise hull points lighter than water (e.g. wood hull)
-            // would never sink as they don't get any water
+            // Sample the water surface at the awake points among the consecutive points
+            // of this tile; each point is integrated at this tile or at a later one, hence
+            // we sample it at the position it's going to be integrated from
             //
 
-            mPoints.GetForce(pointIndex) -=
-                gameParameters.Gravity
-                * BuoyancyAdjustedWaterMass
-                * mPoints.GetBuoyancy(pointIndex);
-        }
+            ElementIndex const tilePointStart = static_cast<ElementIndex>(t) * FusedMechanicalTileSize;
+            ElementIndex const tilePointEnd = std::min(tilePointStart + FusedMechanicalTileSize, pointCount);
 
+            for (; awakePointRange < mAwakePointRanges.size(); ++awakePointRange)
+            {
+                auto const & range = mAwakePointRanges[awakePointRange];
+                if (range.Start >= tilePointEnd)
+                    break;
 
-        //
-        // 2. Apply water drag
-        //
-        // FUTURE: should replace with directional water drag, which acts on frontier points only, 
-        // proportional to angle between velocity and normal to surface at this point;
-        // this would ensure that masses would also have a horizontal velocity component when sinking,
-        // providing a "gliding" effect
-        //
+                mPoints.UpdateCachedWaterSurfaceHeights(
+                    std::max(range.Start, tilePointStart),
+                    std::min(range.End, tilePointEnd));
 
-        if (mPoints.GetPosition(pointIndex).y < waterHeightAtThisPoint)
-        {
-            mPoints.GetForce(pointIndex) += mPoints.GetVelocity(pointIndex) * (-WaterDragCoefficient);
+                if (range.End > tilePointEnd)
+                    break; // Continues in the next tile
+            }
+
+            // Accumulate the forces of the awake springs of this tile
+            for (size_t r = springRangeStart; r < tiles.AwakeSpringRangeTileEnds[t]; ++r)
+            {
+                Algorithms::UpdateSpringForces(
+                    tiles.AwakeSpringRanges[r].Start,
+                    tiles.AwakeSpringRanges[r].End,
+                    tiles.SpringEndpoints.data(),
+                    tiles.SpringRestLengths.data(),
+                    tiles.SpringStiffnessCoefficients.data(),
+                    tiles.SpringDampingCoefficients.data(),
+                    mPoints.GetPositionBufferAsVec2(),
+                    mPoints.GetVelocityBufferAsVec2(),
+                    mPoints.GetForceBufferAsVec2());
+            }
+
+            springRangeStart = tiles.AwakeSpringRangeTileEnds[t];
+
+            // Finish off the awake points that have now seen all of their springs
+            for (ElementIndex p = pointStart; p < tiles.AwakePointTileEnds[t]; ++p)
+            {
+                ElementIndex const pointIndex = tiles.AwakePointIndices[p];
+
+                UpdatePointForces(pointIndex, buoyancyAdjustedWaterMass);
+
+                IntegrateAndResetPointForces(pointIndex);
+            }
+
+            pointStart = tiles.AwakePointTileEnds[t];
         }
+
+        // Handle collisions with sea floor; no spring of this iteration looks at the points
+        // after they've been integrated, hence it's the same as doing it at each tile
+        HandleCollisionsWithSeaFloor();
     }
+
+    // Consume force fields
+    mCurrentForceFields.clear();
 }
 
-void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
+void Ship::UpdateMechanicalDynamicsPositionBased(GameParameters const & gameParameters)
 {
-    for (auto springIndex : mSprings)
-    {
-        auto const pointAIndex = mSprings.GetPointAIndex(springIndex);
-        auto const pointBIndex = mSprings.GetPointBIndex(springIndex);
+    //
+    // Extended position-based dynamics: at each substep we predict positions from
+    // velocities and external forces, then we move points to satisfy the spring
+    // constraints, and finally we derive velocities from the changes in position.
+    //
+    // The constraints are solved with a few Gauss-Seidel iterations, each accumulating
+    // into the Lagrange multiplier of each spring, which starts at zero at each substep:
+    //  dLambda = (-C - compliance~ * lambda) / (wa + wb + compliance~)
+    // where w are the inverse masses, and compliance~ = compliance / dt^2.
+    //
+    // The compliance of a spring is the inverse of the physical stiffness the explicit solver
+    // gives it at its nominal dt, hence at equal stiffness adjustments the two solvers make for
+    // equally rigid springs; unlike the explicit solver, though, this one is stable at any
+    // stiffness, hence it may take stiffness adjustments way higher than the explicit max.
+    //
 
-        // No need to check whether the spring is deleted, as a deleted spring
-        // has zero coefficients
+    float const dt = mPoints.GetCurrentMechanicalDynamicsSimulationStepTimeDuration();
+    float const inverseSquareDt = 1.0f / (dt * dt);
 
-        vec2f const displacement = mPoints.GetPosition(pointBIndex) - mPoints.GetPosition(pointAIndex);
-        float const displacementLength = displacement.length();
-        vec2f const springDir = displacement.normalise(displacementLength);
+    // The stiffness coefficients are current for our dt, while we want the physical
+    // stiffness of springs at the nominal dt:
+    //  k = stiffnessCoefficient * dt^2 / nominalDt^2
+    //  compliance~ = 1 / (k * dt^2) = complianceFactor / stiffnessCoefficient
+    float constexpr NominalDt = GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;
+    float const complianceFactor = NominalDt * NominalDt * inverseSquareDt * inverseSquareDt;
 
-        //
-        // 1. Hooke's law
-        //
+    ElementIndex const * restrict const springEndpointsBuffer = mSprings.GetEndpointsBufferAsElementIndex();
+    float const * restrict const springRestLengthBuffer = mSprings.GetRestLengthBufferAsFloat();
+    float const * restrict const springStiffnessCoefficientBuffer = mSprings.GetStiffnessCoefficientBufferAsFloat();
 
-        // Calculate spring force on point A
-        vec2f const fSpringA = 
-            springDir 
-            * (displacementLength - mSprings.GetRestLength(springIndex)) 
-            * mSprings.GetStiffnessCoefficient(springIndex);
+    // The fraction of relative velocity that each substep removes from each spring,
+    // i.e. what the explicit solver removes in the same time; kept current for our dt
+    // by the springs, together with their coefficients
+    float const * restrict const springDampingFractionBuffer = mSprings.GetPositionBasedDampingFractionBufferAsFloat();
 
+    vec2f * restrict const positionBuffer = mPoints.GetPositionBufferAsVec2();
+    vec2f * restrict const velocityBuffer = mPoints.GetVelocityBufferAsVec2();
+    vec2f * restrict const forceBuffer = mPoints.GetForceBufferAsVec2();
+
+    // Integration factors are dt^2/mass, hence inverse masses once divided by dt^2;
+    // zero for pinned and deleted points, which are thus immovable
+    float const * restrict const integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+
+    float * restrict const springLambdaBuffer = mPositionBasedSpringLambdas.data();
+    vec2f * restrict const previousPositionBuffer = mPositionBasedPreviousPositions.data();
+
+    // Find the points that might hit the sea floor during this step
+    DetectSeaFloorCollisionCandidates();
+
+    // Find the points that each force field might reach during this step
+    CullForceFields();
+
+    for (int substep = 0; substep < mMechanicalIterationsCount; ++substep)
+    {
+        // Apply force fields - if we have any
+        ApplyForceFields();
+
+        // Update external point forces
+        UpdatePointForces(gameParameters);
 
         //
-        // 2. Damper forces
-        //
-        // Damp the velocities of the two points, as if the points were also connected by a damper
-        // along the same direction as the spring
+        // 1. Predict positions
         //
 
-        // Calculate damp force on point A
-        vec2f const relVelocity = mPoints.GetVelocity(pointBIndex) - mPoints.GetVelocity(pointAIndex);
-        vec2f const fDampA = 
-            springDir 
-            * relVelocity.dot(springDir) 
-            * mSprings.GetDampingCoefficient(springIndex);
+        for (auto const & awakeRange : mAwakePointRanges)
+        {
+            for (ElementIndex p = awakeRange.Start; p < awakeRange.End; ++p)
+            {
+                previousPositionBuffer[p] = positionBuffer[p];
+
+                positionBuffer[p] += 
+                    velocityBuffer[p] * dt 
+                    + forceBuffer[p] * integrationFactorBuffer[p * 2];
 
+                forceBuffer[p] = vec2f::zero();
+            }
+        }
 
         //
-        // Apply forces
+        // 2. Solve spring constraints
         //
 
-        mPoints.GetForce(pointAIndex) += fSpringA + fDampA;
-        mPoints.GetForce(pointBIndex) -= fSpringA + fDampA;
-    }
-}
+        for (auto const & awakeRange : mAwakeSpringRanges)
+        {
+            std::fill(
+                springLambdaBuffer + awakeRange.Start,
+                springLambdaBuffer + awakeRange.End,
+                0.0f);
+        }
 
-void Ship::IntegrateAndResetPointForces()
-{
-    static constexpr float dt = GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;
+        for (int iter = 0; iter < GameParameters::NumPositionBasedMechanicalDynamicsIterations; ++iter)
+        {
+            for (auto const & awakeRange : mAwakeSpringRanges)
+            {
+                for (ElementIndex s = awakeRange.Start; s < awakeRange.End; ++s)
+                {
+                    if (mSprings.IsDeleted(s))
+                        continue;
 
-    // Global damp - lowers velocity uniformly, damping oscillations originating between gravity and buoyancy
-    // Note: it's extremely sensitive, big difference between 0.9995 and 0.9998
-    // Note: technically it's not a drag force, it's just a dimensionless deceleration
-    float constexpr GlobalDampCoefficient = 0.9996f;
+                    ElementIndex const pointAIndex = springEndpointsBuffer[s * 2];
+                    ElementIndex const pointBIndex = springEndpointsBuffer[s * 2 + 1];
 
-    //
-    // Take the four buffers that we need as restrict pointers, so that the compiler
-    // can better see it should parallelize this loop as much as possible
-    //
-    // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
-    // integrating two points at each iteration
-    //
+                    float const wa = integrationFactorBuffer[pointAIndex * 2] * inverseSquareDt;
+                    float const wb = integrationFactorBuffer[pointBIndex * 2] * inverseSquareDt;
 
-    float * restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
-    float * restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
-    float * restrict forceBuffer = mPoints.GetForceBufferAsFloat();
-    float * restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+                    vec2f const displacement = positionBuffer[pointAIndex] - positionBuffer[pointBIndex];
+                    float const displacementLength = displacement.length();
 
-    size_t const numIterations = mPoints.GetBufferElementCount() * 2; // Two components per vector
-    for (size_t i = 0; i < numIterations; ++i)
-    {
-        //
-        // Verlet integration (fourth order, with velocity being first order)
-        //
+                    if (wa + wb == 0.0f || displacementLength == 0.0f)
+                        continue;
 
-        float const deltaPos = velocityBuffer[i] * dt + forceBuffer[i] * integrationFactorBuffer[i];
-        positionBuffer[i] += deltaPos;
-        velocityBuffer[i] = deltaPos * GlobalDampCoefficient / dt;
+                    float const compliance = complianceFactor / springStiffnessCoefficientBuffer[s];
 
-        // Zero out force now that we've integrated it
-        forceBuffer[i] = 0.0f;
-    }
-}
+                    float const constraint = displacementLength - springRestLengthBuffer[s];
+                    float const dLambda = 
+                        (-constraint - compliance * springLambdaBuffer[s])
+                        / (wa + wb + compliance);
 
-void Ship::HandleCollisionsWithSeaFloor()
-{
-    for (auto pointIndex : mPoints)
-    {
-        // Check if point is now below the sea floor
-        float const floorheight = mParentWorld.GetOceanFloorHeightAt(mPoints.GetPosition(pointIndex).x);
-        if (mPoints.GetPosition(pointIndex).y < floorheight)
-        {
-            // Calculate normal to sea floor
-            static constexpr float Dx = 0.01f;
-            vec2f seaFloorNormal = vec2f(
-                floorheight - mParentWorld.GetOceanFloorHeightAt(mPoints.GetPosition(pointIndex).x + Dx),
-                Dx).normalise();
+                    springLambdaBuffer[s] += dLambda;
 
-            // Calculate displacement to move point back to sea floor, along the normal to the floor 
-            // (which is oriented upwards)
-            vec2f bounceDisplacement = seaFloorNormal * (floorheight - mPoints.GetPosition(pointIndex).y);
+                    vec2f const springDir = displacement / displacementLength;
+                    positionBuffer[pointAIndex] += springDir * (dLambda * wa);
+                    positionBuffer[pointBIndex] -= springDir * (dLambda * wb);
+                }
+            }
+        }
 
-            // Move point back along normal to ~basically floor level
-            mPoints.GetPosition(pointIndex) += bounceDisplacement;
+        //
+        // 3. Derive velocities
+        //
 
-            // Simulate a perfectly elastic impact, bouncing along specular to sea floor normal:
-            // R = 2*n*dot_product(n,-V) + V
-            mPoints.GetVelocity(pointIndex) += 
-                seaFloorNormal
-                * -2.0f
-                * seaFloorNormal.dot(mPoints.GetVelocity(pointIndex));
+        for (auto const & awakeRange : mAwakePointRanges)
+        {
+            for (ElementIndex p = awakeRange.Start; p < awakeRange.End; ++p)
+            {
+                velocityBuffer[p] = 
+                    (positionBuffer[p] - previousPositionBuffer[p]) 
+                    * mCurrentGlobalDampCoefficient 
+                    / dt;
+            }
         }
-    }
-}
 
-///////////////////////////////////////////////////////////////////////////////////
-// Water Dynamics
-///////////////////////////////////////////////////////////////////////////////////
+        //
+        // 4. Damp relative velocities along springs
+        //
 
-void Ship::UpdateWaterDynamics(GameParameters const & gameParameters)
-{
-    float waterTakenInStep = 0.f;
-    float waterSplashedInStep = 0.f;
+        for (auto const & awakeRange : mAwakeSpringRanges)
+        {
+            for (ElementIndex s = awakeRange.Start; s < awakeRange.End; ++s)
+            {
+                if (mSprings.IsDeleted(s))
+                    continue;
 
-    for (int i = 0; i < GameParameters::NumWaterDynamicsIterations<int>; ++i)
-    {
-        UpdateWaterInflow(gameParameters, waterTakenInStep);
+                ElementIndex const pointAIndex = springEndpointsBuffer[s * 2];
+                ElementIndex const pointBIndex = springEndpointsBuffer[s * 2 + 1];
 
-        UpdateWaterVelocities(gameParameters, waterSplashedInStep);
-    }
+                float const wa = integrationFactorBuffer[pointAIndex * 2];
+                float const wb = integrationFactorBuffer[pointBIndex * 2];
+                float const wSum = wa + wb;
 
-    // Notify waters
-    mGameEventHandler->OnWaterTaken(waterTakenInStep);
-    mGameEventHandler->OnWaterSplashed(waterSplashedInStep);
+                if (wSum == 0.0f)
+                    continue;
 
-    // Update total water taken and check whether we've started sinking
-    mTotalWater += waterTakenInStep;
-    if (!mIsSinking
-        && mTotalWater > static_cast<float>(mPoints.GetElementCount()) / 1.5f)
-    {
-        // Started sinking
-        mGameEventHandler->OnSinkingBegin(mId);
-        mIsSinking = true;
+                vec2f const springDir = (positionBuffer[pointAIndex] - positionBuffer[pointBIndex]).normalise();
+                float const relativeVelocity = (velocityBuffer[pointAIndex] - velocityBuffer[pointBIndex]).dot(springDir);
+                float const dVelocity = -relativeVelocity * springDampingFractionBuffer[s] / wSum;
+
+                velocityBuffer[pointAIndex] += springDir * (dVelocity * wa);
+                velocityBuffer[pointBIndex] -= springDir * (dVelocity * wb);
+            }
+        }
+
+        // Handle collisions with sea floor
+        HandleCollisionsWithSeaFloor();
     }
+
+    // Consume force fields
+    mCurrentForceFields.clear();
 }
 
-void Ship::UpdateWaterInflow(
-    GameParameters const & gameParameters,
-    float & waterTaken)
+void Ship::CullForceFields()
 {
-    //
-    // Intake/outtake water into/from all the leaking nodes that are underwater
-    //
+    mForceFieldPointRanges.clear();
+    mForceFieldPointRangeOffsets.clear();
 
-    for (auto pointIndex : mPoints)
-    {
-        // Avoid taking water into points that are destroyed, as that would change total water taken
-        if (!mPoints.IsDeleted(pointIndex))
-        {
-            if (mPoints.IsLeaking(pointIndex))
-            {
-                //
-                // 1) Calculate velocity of incoming water, based off Bernoulli's equation applied to point:
-                //  v**2/2 + p/density = c (assuming y of incoming water does not change along the intake)
-                //      With: p = pressure of water at point = d*wh*g (d = water density, wh = water height in point)
-                //
-                // Considering that at equilibrium we have v=0 and p=external_pressure, 
-                // then c=external_pressure/density;
-                // external_pressure is height_of_water_at_y*g*density, then c=height_of_water_at_y*g; 
-                // hence, the velocity of water incoming at point p, when the "water height" in the point is already
-                // wh and the external water pressure is d*height_of_water_at_y*g, is:
-                //  v = +/- sqrt(2*g*|height_of_water_at_y-wh|)
-                //
+    if (mCurrentForceFields.empty())
+        return;
 
-                float const externalWaterHeight = std::max(
-                    mParentWorld.GetWaterHeightAt(mPoints.GetPosition(pointIndex).x) - mPoints.GetPosition(pointIndex).y,
-                    0.0f);
+    vec2f const * restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
 
-                float const internalWaterHeight = mPoints.GetWater(pointIndex);
+    mForceFieldPointRangeOffsets.push_back(0);
 
-                float incomingWaterVelocity;
-                if (externalWaterHeight >= internalWaterHeight)
+    for (auto const & forceField : mCurrentForceFields)
+    {
+        std::visit(
+            [&](auto const & field)
+            {
+                if constexpr (std::decay_t<decltype(field)>::ReachesEverywhere)
                 {
-                    // Incoming water
-                    incomingWaterVelocity = sqrtf(2.0f * GameParameters::GravityMagnitude * (externalWaterHeight - internalWaterHeight));
+                    mForceFieldPointRanges.insert(
+                        mForceFieldPointRanges.end(),
+                        mAwakePointRanges.cbegin(),
+                        mAwakePointRanges.cend());
                 }
                 else
                 {
-                    // Outgoing water
-                    incomingWaterVelocity = - sqrtf(2.0f * GameParameters::GravityMagnitude * (internalWaterHeight - externalWaterHeight));
+                    // Make runs of the awake points within reach
+                    size_t const firstRange = mForceFieldPointRanges.size();
+                    for (auto const & awakeRange : mAwakePointRanges)
+                    {
+                        for (ElementIndex pointIndex = awakeRange.Start; pointIndex < awakeRange.End; ++pointIndex)
+                        {
+                            if (field.MayAffect(positionBuffer[pointIndex], ForceFieldCullingMargin))
+                            {
+                                if (mForceFieldPointRanges.size() > firstRange && mForceFieldPointRanges.back().End == pointIndex)
+                                    ++(mForceFieldPointRanges.back().End);
+                                else
+                                    mForceFieldPointRanges.emplace_back(pointIndex, pointIndex + 1);
+                            }
+                        }
+                    }
                 }
+            },
+            forceField);
 
-                //
-                // 2) In/Outtake water according to velocity:
-                // - During dt, we move a volume of water Vw equal to A*v*dt; the equivalent change in water
-                //   height is thus Vw/A, i.e. v*dt
-                //
+        mForceFieldPointRangeOffsets.push_back(mForceFieldPointRanges.size());
+    }
+}
 
-                float newWater =
-                    incomingWaterVelocity
-                    * GameParameters::WaterDynamicsSimulationStepTimeDuration<float>
-                    * gameParameters.WaterIntakeAdjustment;
+void Ship::ApplyForceFields()
+{
+    if (mCurrentForceFields.empty())
+        return;
 
-                if (newWater < 0.0f)
-                {
-                    // Outgoing water
+    assert(mForceFieldPointRangeOffsets.size() == mCurrentForceFields.size() + 1);
 
-                    // Make sure we don't over-drain the point
-                    newWater = -std::min(-newWater, mPoints.GetWater(pointIndex));
+    vec2f const * restrict positionBuffer = mPoints.GetPositionBufferAsVec2();
+    vec2f * restrict forceBuffer = mPoints.GetForceBufferAsVec2();
 
-                    // Simulate water "sticking" into material - after all, water that once entered
-                    // won't leave completely afterwards, something will stay behind
-                    newWater *= 0.95f;
+    for (size_t f = 0; f < mCurrentForceFields.size(); ++f)
+    {
+        std::visit(
+            [&](auto const & field)
+            {
+                // Only visit the points that the force field may reach
+                for (size_t r = mForceFieldPointRangeOffsets[f]; r < mForceFieldPointRangeOffsets[f + 1]; ++r)
+                {
+                    field.Apply(
+                        mForceFieldPointRanges[r].Start,
+                        mForceFieldPointRanges[r].End,
+                        positionBuffer,
+                        forceBuffer);
                 }
+            },
+            mCurrentForceFields[f]);
+    }
+}
 
-                // Adjust water
-                mPoints.AddWater(pointIndex, newWater);
-
-                // Adjust total water taken during step
-                waterTaken += newWater;
-            }
+inline void Ship::UpdatePointForces(
+    ElementIndex pointIndex,
+    float buoyancyAdjustedWaterMass)
+{
+    // Underwater points feel this amount of water drag
+    //
+    // The higher the value, the more viscous the water looks when a body moves through it
+    constexpr float WaterDragCoefficient = 0.020f; // ~= 1.0f - powf(0.6f, 0.02f)
+
+    // Get height of water at this point
+    float const waterHeightAtThisPoint = mPoints.GetCachedWaterSurfaceHeight(pointIndex);
+
+    //
+    // 1. Add gravity and buoyancy
+    //        
+
+    // Mass = own + contained water (clamped to 1)
+    mPoints.GetForce(pointIndex) += GameParameters::Gravity
+        * (mPoints.GetMass(pointIndex) + std::min(mPoints.GetWater(pointIndex), 1.0f) * 1000.0f);
+
+    if (mPoints.GetPosition(pointIndex).y < waterHeightAtThisPoint)
+    {
+        //
+        // Apply upward push of water mass (i.e. buoyancy!)
+        //
+        // We don't want hull points to feel buoyancy, otherwise hull points lighter than water (e.g. wood hull)
+        // would never sink as they don't get any water
+        //
+
+        mPoints.GetForce(pointIndex) -=
+            GameParameters::Gravity
+            * buoyancyAdjustedWaterMass
+            * mPoints.GetBuoyancy(pointIndex);
+    }
+
+
+    //
+    // 2. Apply water drag
+    //
+    // FUTURE: should replace with directional water drag, which acts on frontier points only, 
+    // proportional to angle between velocity and normal to surface at this point;
+    // this would ensure that masses would also have a horizontal velocity component when sinking,
+    // providing a "gliding" effect
+    //
+
+    if (mPoints.GetPosition(pointIndex).y < waterHeightAtThisPoint)
+    {
+        mPoints.GetForce(pointIndex) += mPoints.GetVelocity(pointIndex) * (-WaterDragCoefficient);
+    }
+}
+
+void Ship::UpdatePointForces(GameParameters const & gameParameters)
+{
+    // Effective water mass that we want to use for buoyancy calculation
+    float const buoyancyAdjustedWaterMass = WaterMass * gameParameters.BuoyancyAdjustment;
+
+    // Only the awake points move, hence only they need the water surface sampled anew
+    for (auto const & range : mAwakePointRanges)
+    {
+        mPoints.UpdateCachedWaterSurfaceHeights(range.Start, range.End);
+    }
+
+    for (auto pointIndex : mAwakePoints)
+    {
+        UpdatePointForces(pointIndex, buoyancyAdjustedWaterMass);
+    }
+}
+
+void Ship::UpdateSpringForces(GameParameters const & /*gameParameters*/)
+{
+    if (mSpringForcesTasks.empty())
+    {
+        // Not worth parallelizing
+        UpdateSpringForces(0, mSprings.GetElementCount());
+    }
+    else
+    {
+        //
+        // Run one color batch at a time; the springs in a batch share no endpoints,
+        // hence the tasks of a batch never write to the same point - except for
+        // the serial batch, which has one task only
+        //
+
+        for (auto const & colorBatchTasks : mSpringForcesTasks)
+        {
+            mParentWorld.GetTaskThreadPool().Run(colorBatchTasks);
         }
     }
 }
 
-void Ship::UpdateWaterVelocities(
-    GameParameters const & gameParameters,
-    float & waterSplashed)
+void Ship::UpdateSpringForces(
+    ElementIndex startSpringIndex,
+    ElementIndex endSpringIndex)
 {
     //
-    // For each point, move each spring's outgoing water momentum to 
-    // its destination point
+    // Delegate to the vectorized kernel for the instruction set of this CPU,
+    // for each range of awake springs in the specified range.
+    //
+    // Springs deleted since the awake springs were rebuilt are harmless, 
+    // as a deleted spring has zero coefficients
     //
 
-    // Calculate water momenta
-    mPoints.UpdateWaterMomentaFromVelocities();
+    auto const & awakeRanges = mAwakeSpringRanges;
 
-    // Source and result water buffers
-    float * restrict oldPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
-    auto newPointWaterBuffer = mPoints.MakeWaterBufferCopy();
-    float * restrict newPointWaterBufferData = newPointWaterBuffer->data();
-    vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
-    vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+    // Find the first awake range ending after our start
+    auto it = std::upper_bound(
+        awakeRanges.cbegin(),
+        awakeRanges.cend(),
+        startSpringIndex,
+        [](ElementIndex springIndex, ElementContainer::ElementRange const & range)
+        {
+            return springIndex < range.End;
+        });
 
-    // Weights of outbound water flows along each spring, including impermeable ones;
-    // set to zero for springs whose resultant scalar water velocities are 
-    // directed towards the point being visited
-    std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundWaterFlowWeights;
+    for (; it != awakeRanges.cend() && it->Start < endSpringIndex; ++it)
+    {
+        Algorithms::UpdateSpringForces(
+            std::max(it->Start, startSpringIndex),
+            std::min(it->End, endSpringIndex),
+            mSprings.GetEndpointsBufferAsElementIndex(),
+            mSprings.GetRestLengthBufferAsFloat(),
+            mSprings.GetStiffnessCoefficientBufferAsFloat(),
+            mSprings.GetDampingCoefficientBufferAsFloat(),
+            mPoints.GetPositionBufferAsVec2(),
+            mPoints.GetVelocityBufferAsVec2(),
+            mPoints.GetForceBufferAsVec2());
+    }
+}
 
-    // Total weight
-    float totalOutboundWaterFlowWeight;
+void Ship::UpdateColorBatchSpringForces(
+    ElementIndex startSlot,
+    ElementIndex endSlot)
+{
+    //
+    // Same as above, for the springs in the specified range of color batch slots
+    //
 
-    // Resultant water velocities along each spring
-    std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
+    auto const & batches = mSpringForcesColorBatches;
+    auto const & awakeRanges = batches.AwakeSpringRanges;
+
+    // Find the first awake range ending after our start
+    auto it = std::upper_bound(
+        awakeRanges.cbegin(),
+        awakeRanges.cend(),
+        startSlot,
+        [](ElementIndex slot, ElementContainer::ElementRange const & range)
+        {
+            return slot < range.End;
+        });
+
+    for (; it != awakeRanges.cend() && it->Start < endSlot; ++it)
+    {
+        Algorithms::UpdateSpringForces(
+            std::max(it->Start, startSlot),
+            std::min(it->End, endSlot),
+            batches.SpringEndpoints.data(),
+            batches.SpringRestLengths.data(),
+            batches.SpringStiffnessCoefficients.data(),
+            batches.SpringDampingCoefficients.data(),
+            mPoints.GetPositionBufferAsVec2(),
+            mPoints.GetVelocityBufferAsVec2(),
+            mPoints.GetForceBufferAsVec2());
+    }
+}
+
+void Ship::IntegrateAndResetPointForces()
+{
+    float const dt = mPoints.GetCurrentMechanicalDynamicsSimulationStepTimeDuration();
+    float const globalDampCoefficient = mCurrentGlobalDampCoefficient;
 
     //
-    // Precalculate point "freeness factors", i.e. how much each point's
-    // quantity of water "suppresses" splashes from adjacent kinetic energy losses
+    // Take the four buffers that we need as restrict pointers, so that the compiler
+    // can better see it should parallelize this loop as much as possible
+    //
+    // This loop is compiled with single-precision packet SSE instructions on MSVC 17,
+    // integrating two points at each iteration
     //
 
-    auto pointFreenessFactorBuffer = mPoints.AllocateWorkBufferFloat();
-    float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
-    for (auto pointIndex : mPoints)
+    float * restrict positionBuffer = mPoints.GetPositionBufferAsFloat();
+    float * restrict velocityBuffer = mPoints.GetVelocityBufferAsFloat();
+    float * restrict forceBuffer = mPoints.GetForceBufferAsFloat();
+    float * restrict integrationFactorBuffer = mPoints.GetIntegrationFactorBufferAsFloat();
+
+    for (auto const & awakeRange : mAwakePointRanges)
+    {
+        size_t const startIteration = awakeRange.Start * 2; // Two components per vector
+        size_t const endIteration = awakeRange.End * 2;
+        for (size_t i = startIteration; i < endIteration; ++i)
+        {
+            //
+            // Verlet integration (fourth order, with velocity being first order)
+            //
+
+            float const deltaPos = velocityBuffer[i] * dt + forceBuffer[i] * integrationFactorBuffer[i];
+            positionBuffer[i] += deltaPos;
+            velocityBuffer[i] = deltaPos * globalDampCoefficient / dt;
+
+            // Zero out force now that we've integrated it
+            forceBuffer[i] = 0.0f;
+        }
+    }
+}
+
+inline void Ship::IntegrateAndResetPointForces(ElementIndex pointIndex)
+{
+    float const dt = mPoints.GetCurrentMechanicalDynamicsSimulationStepTimeDuration();
+
+    // Same as the vectorized flavor, one point at a time
+    vec2f const & force = mPoints.GetForce(pointIndex);
+    vec2f const & integrationFactor = mPoints.GetIntegrationFactor(pointIndex);
+    vec2f const deltaPos =
+        mPoints.GetVelocity(pointIndex) * dt
+        + vec2f(force.x * integrationFactor.x, force.y * integrationFactor.y);
+
+    mPoints.GetPosition(pointIndex) += deltaPos;
+    mPoints.GetVelocity(pointIndex) = deltaPos * mCurrentGlobalDampCoefficient / dt;
+
+    mPoints.GetForce(pointIndex) = vec2f::zero();
+}
+
+inline void Ship::HandleCollisionsWithSeaFloor(
+    ElementIndex pointIndex,
+    float floorheight)
+{
+    // Check if point is now below the sea floor
+    if (mPoints.GetPosition(pointIndex).y < floorheight)
+    {
+        // Calculate normal to sea floor
+        static constexpr float Dx = 0.01f;
+        vec2f seaFloorNormal = vec2f(
+            floorheight - mParentWorld.GetOceanFloorHeightAt(mPoints.GetPosition(pointIndex).x + Dx),
+            Dx).normalise();
+
+        // Calculate displacement to move point back to sea floor, along the normal to the floor 
+        // (which is oriented upwards)
+        vec2f bounceDisplacement = seaFloorNormal * (floorheight - mPoints.GetPosition(pointIndex).y);
+
+        // Move point back along normal to ~basically floor level
+        mPoints.GetPosition(pointIndex) += bounceDisplacement;
+
+        // Simulate a perfectly elastic impact, bouncing along specular to sea floor normal:
+        // R = 2*n*dot_product(n,-V) + V
+        mPoints.GetVelocity(pointIndex) += 
+            seaFloorNormal
+            * -2.0f
+            * seaFloorNormal.dot(mPoints.GetVelocity(pointIndex));
+    }
+}
+
+void Ship::HandleCollisionsWithSeaFloor()
+{
+    for (auto const & candidateRange : mSeaFloorCollisionCandidatePointRanges)
+    {
+        mPoints.UpdateCachedOceanFloorHeights(
+            candidateRange.Start,
+            candidateRange.End);
+
+        for (ElementIndex pointIndex = candidateRange.Start; pointIndex < candidateRange.End; ++pointIndex)
+        {
+            HandleCollisionsWithSeaFloor(
+                pointIndex,
+                mPoints.GetCachedOceanFloorHeight(pointIndex));
+        }
+    }
+}
+
+void Ship::DetectSeaFloorCollisionCandidates()
+{
+    // Connected components closer than this to the floor are always candidates,
+    // regardless of their velocity
+    static constexpr float SafetyMargin = 1.0f;
+
+    mSeaFloorCollisionCandidatePointRanges.clear();
+
+    if (!mCurrentForceFields.empty())
     {
-        pointFreenessFactorBufferData[pointIndex] = 
-            exp(-oldPointWaterBufferData[pointIndex] * 10.0f);
+        // Force fields may accelerate points arbitrarily during the step
+        mSeaFloorCollisionCandidatePointRanges = mAwakePointRanges;
+        return;
     }
 
+    //
+    // Calculate the boxes and max velocities of all awake connected components
+    //
+
+    mConnectedComponentAABBs.assign(
+        mConnectedComponentSizes.size(),
+        Geometry::AABB(
+            vec2f(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()),
+            vec2f(std::numeric_limits<float>::max(), std::numeric_limits<float>::max())));
+
+    mConnectedComponentMaxSquareVelocities.assign(mConnectedComponentSizes.size(), 0.0f);
+
+    for (auto pointIndex : mAwakePoints)
+    {
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            auto const c = mPoints.GetConnectedComponentId(pointIndex) - 1;
+
+            mConnectedComponentAABBs[c].ExtendTo(mPoints.GetPosition(pointIndex));
+
+            mConnectedComponentMaxSquareVelocities[c] = std::max(
+                mConnectedComponentMaxSquareVelocities[c],
+                mPoints.GetVelocity(pointIndex).squareLength());
+        }
+    }
 
     //
-    // Visit all points and move water and its momenta
+    // Check which connected components might reach the floor during this step
     //
-    
-    for (auto pointIndex : mPoints)
+
+    mIsConnectedComponentNearSeaFloor.assign(mConnectedComponentSizes.size(), false);
+
+    for (size_t c = 0; c < mConnectedComponentAABBs.size(); ++c)
     {
-        //
-        // 1) Calculate water momenta along all springs
-        //
+        auto const & box = mConnectedComponentAABBs[c];
+        if (box.BottomLeft.x <= box.TopRight.x) // Not asleep nor empty
+        {
+            float const reach =
+                sqrtf(mConnectedComponentMaxSquareVelocities[c]) * GameParameters::SimulationStepTimeDuration<float>
+                + SafetyMargin;
 
-        // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
-        // and gravity were exaggerated
-        //
-        // WaterCrazyness=0   -> alpha=1
-        // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
-        // WaterCrazyness=1   -> alpha=Wh
-        float const alphaCrazyness = 1.0f + gameParameters.WaterCrazyness * (oldPointWaterBufferData[pointIndex] - 1.0f);
+            mIsConnectedComponentNearSeaFloor[c] =
+                box.BottomLeft.y - reach
+                <= mParentWorld.GetMaxOceanFloorHeightIn(box.BottomLeft.x - reach, box.TopRight.x + reach);
+        }
+    }
 
-        // Kinetic energy lost at this point
-        float pointKineticEnergyLoss = 0.0f;
-        
-        // Count of non-hull free and drowned neighbor points
-        float pointSplashNeighbors = 0.0f;
-        float pointSplashFreeNeighbors = 0.0f;
+    //
+    // Collect the points of those connected components
+    //
 
-        totalOutboundWaterFlowWeight = 0.0f;
+    for (auto pointIndex : mAwakePoints)
+    {
+        if (!mPoints.IsDeleted(pointIndex)
+            && mIsConnectedComponentNearSeaFloor[mPoints.GetConnectedComponentId(pointIndex) - 1])
+        {
+            if (!mSeaFloorCollisionCandidatePointRanges.empty() && mSeaFloorCollisionCandidatePointRanges.back().End == pointIndex)
+                ++(mSeaFloorCollisionCandidatePointRanges.back().End);
+            else
+                mSeaFloorCollisionCandidatePointRanges.emplace_back(pointIndex, pointIndex + 1);
+        }
+    }
+}
 
-        for (size_t s = 0; s < mPoints.GetConnectedSprings(pointIndex).size(); ++s)
+///////////////////////////////////////////////////////////////////////////////////
+// Water Dynamics
+///////////////////////////////////////////////////////////////////////////////////
+
+void Ship::UpdateWaterDynamics(GameParameters const & gameParameters)
+{
+    // Each update stands for as many steps as the update period: leaks take in water
+    // for that long, and water moves as much as it would in as many updates
+    float const updatePeriod = static_cast<float>(gameParameters.WaterDynamicsUpdatePeriod);
+    mCurrentWaterDynamicsSimulationStepTimeDuration = GameParameters::WaterDynamicsSimulationStepTimeDuration<float> * updatePeriod;
+    mCurrentWaterQuickness = 1.0f - std::pow(1.0f - gameParameters.WaterQuickness, updatePeriod);
+
+    float waterTakenInStep = 0.f;
+    float waterSplashedInStep = 0.f;
+
+    // Awake points have moved since the last mechanical iteration sampled the water surface
+    for (auto const & range : mAwakePointRanges)
+    {
+        mPoints.UpdateCachedWaterSurfaceHeights(range.Start, range.End);
+    }
+
+    // Sleeping leaks that would now take in water wake up their connected components
+    WakeUpConnectedComponentsTakingWater(gameParameters);
+
+    if (mAreAwakeElementsDirty)
+    {
+        RebuildAwakeElements();
+    }
+
+    for (int i = 0; i < GameParameters::NumWaterDynamicsIterations<int>; ++i)
+    {
+        UpdateWaterInflow(gameParameters, waterTakenInStep);
+
+        // Inflow might have grown the wet front
+        if (mIsAwakeWetFrontDirty)
         {
-            auto const springIndex = mPoints.GetConnectedSprings(pointIndex)[s];
+            RebuildAwakeWetFront();
+        }
 
-            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+        if (IsParallelWaterFlowUsed(gameParameters))
+            UpdateWaterVelocitiesParallel(gameParameters, waterSplashedInStep);
+        else if (gameParameters.UseEdgeCentricWaterFlow)
+            UpdateWaterVelocitiesEdgeCentric(gameParameters, waterSplashedInStep);
+        else
+            UpdateWaterVelocities(gameParameters, waterSplashedInStep);
 
-            // Normalized spring vector, oriented point -> other endpoint
-            vec2f const springNormalizedVector = (mPoints.GetPosition(otherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise();
+        // Points at the front that got water take their neighbors into the wet front
+        for (auto pointIndex : mAwakeWetFrontPoints)
+        {
+            if (mPointWetFrontStates[pointIndex] == WetFrontState::Front
+                && mPoints.GetWater(pointIndex) != 0.0f)
+            {
+                ExpandWetFront(pointIndex);
+            }
+        }
+    }
+
+    // Notify waters
+    mGameEventHandler->OnWaterTaken(waterTakenInStep);
+    mGameEventHandler->OnWaterSplashed(waterSplashedInStep);
+
+    // Update total water taken and check whether we've started sinking
+    mTotalWater += waterTakenInStep;
+    if (!mIsSinking
+        && mTotalWater > static_cast<float>(mPoints.GetElementCount()) / 1.5f)
+    {
+        // Started sinking
+        mGameEventHandler->OnSinkingBegin(mId);
+        mIsSinking = true;
+    }
+}
+
+void Ship::UpdateWaterInflow(
+    GameParameters const & gameParameters,
+    float & waterTaken)
+{
+    //
+    // Intake/outtake water into/from all the awake leaking nodes that are underwater
+    //
+
+    Algorithms::CalculateLeakingPointWaterInflows(
+        mAwakeLeakingPoints.data(),
+        static_cast<ElementCount>(mAwakeLeakingPoints.size()),
+        mPoints.GetPositionBufferAsVec2(),
+        mPoints.GetCachedWaterSurfaceHeightBufferAsFloat(),
+        mPoints.GetWaterBufferAsFloat(),
+        mCurrentWaterDynamicsSimulationStepTimeDuration,
+        gameParameters.WaterIntakeAdjustment,
+        GameParameters::GravityMagnitude,
+        mAwakeLeakingPointInflows.data(),
+        gameParameters.WaterMathQuality);
+
+    for (size_t l = 0; l < mAwakeLeakingPoints.size(); ++l)
+    {
+        auto const pointIndex = mAwakeLeakingPoints[l];
+        float const newWater = mAwakeLeakingPointInflows[l];
+
+        // Adjust water
+        mPoints.AddWater(pointIndex, newWater);
+
+        // Water may now flow from this point into its neighbors
+        if (newWater > 0.0f
+            && mPointWetFrontStates[pointIndex] != WetFrontState::Wet)
+        {
+            ExpandWetFront(pointIndex);
+        }
+
+        // Water still flowing keeps the connected component awake
+        if (std::abs(newWater) > SleepMaxWaterInflow)
+        {
+            mConnectedComponentSleepStates[mPoints.GetConnectedComponentId(pointIndex) - 1].IsTakingWater = true;
+        }
+
+        // Adjust total water taken during step
+        waterTaken += newWater;
+    }
+}
+
+void Ship::ResetWetFront()
+{
+    std::fill(mPointWetFrontStates.begin(), mPointWetFrontStates.end(), WetFrontState::Dry);
+    mWetFrontPoints.clear();
+    mWetFrontSprings.clear();
+    mSortedWetFrontPointsCount = 0;
+    mSortedWetFrontSpringsCount = 0;
+
+    for (auto pointIndex : mPoints.GetActiveElements())
+    {
+        if (!mPoints.IsDeleted(pointIndex)
+            && mPoints.GetWater(pointIndex) != 0.0f)
+        {
+            ExpandWetFront(pointIndex);
+        }
+    }
+
+    mIsAwakeWetFrontDirty = true;
+}
+
+void Ship::ExpandWetFront(ElementIndex pointIndex)
+{
+    assert(mPointWetFrontStates[pointIndex] != WetFrontState::Wet);
+
+    if (mPointWetFrontStates[pointIndex] == WetFrontState::Dry)
+    {
+        AddToWetFront(pointIndex);
+    }
+
+    mPointWetFrontStates[pointIndex] = WetFrontState::Wet;
+
+    for (auto const springIndex : mPoints.GetConnectedSprings(pointIndex))
+    {
+        auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+        if (mPointWetFrontStates[otherEndpointIndex] == WetFrontState::Dry)
+        {
+            AddToWetFront(otherEndpointIndex);
+        }
+    }
+
+    mIsAwakeWetFrontDirty = true;
+}
+
+void Ship::AddToWetFront(ElementIndex pointIndex)
+{
+    assert(mPointWetFrontStates[pointIndex] == WetFrontState::Dry);
+
+    mPointWetFrontStates[pointIndex] = WetFrontState::Front;
+    mWetFrontPoints.push_back(pointIndex);
+
+    // Each spring joins when its second endpoint does
+    for (auto const springIndex : mPoints.GetConnectedSprings(pointIndex))
+    {
+        if (mPointWetFrontStates[mSprings.GetOtherEndpointIndex(springIndex, pointIndex)] != WetFrontState::Dry)
+        {
+            mWetFrontSprings.push_back(springIndex);
+        }
+    }
+}
+
+void Ship::RebuildAwakeWetFront()
+{
+    mAwakeWetFrontPoints.clear();
+    mAwakeWetFrontSpringRanges.clear();
+
+    // Visit in memory order; while the ship floods the wet front grows at almost
+    // each water iteration, but only by a few elements
+    MergeUnsortedTail(mWetFrontPoints, mSortedWetFrontPointsCount, mWetFrontMergeBuffer);
+    mSortedWetFrontPointsCount = mWetFrontPoints.size();
+    MergeUnsortedTail(mWetFrontSprings, mSortedWetFrontSpringsCount, mWetFrontMergeBuffer);
+    mSortedWetFrontSpringsCount = mWetFrontSprings.size();
+
+    for (auto pointIndex : mWetFrontPoints)
+    {
+        if (IsConnectedComponentAwake(mPoints.GetConnectedComponentId(pointIndex)))
+        {
+            mAwakeWetFrontPoints.push_back(pointIndex);
+        }
+    }
+
+    for (auto springIndex : mWetFrontSprings)
+    {
+        // Both endpoints of a spring belong to the same connected component
+        if (IsConnectedComponentAwake(mPoints.GetConnectedComponentId(mSprings.GetPointAIndex(springIndex))))
+        {
+            if (!mAwakeWetFrontSpringRanges.empty() && mAwakeWetFrontSpringRanges.back().End == springIndex)
+                ++(mAwakeWetFrontSpringRanges.back().End);
+            else
+                mAwakeWetFrontSpringRanges.emplace_back(springIndex, springIndex + 1);
+        }
+    }
+
+    //
+    // Make the tasks of the parallel water flow
+    //
+
+    mWaterFlowSpringChunks.clear();
+    mWaterFlowSpringTasks.clear();
+    mWaterFlowPointTasks.clear();
+
+    if (mParentWorld.GetTaskThreadPool().GetParallelism() > 1)
+    {
+        for (auto const & range : mAwakeWetFrontSpringRanges)
+        {
+            for (ElementIndex chunkStart = range.Start; chunkStart < range.End; chunkStart += static_cast<ElementIndex>(WaterFlowChunkSize))
+            {
+                mWaterFlowSpringChunks.emplace_back(
+                    chunkStart,
+                    std::min(chunkStart + static_cast<ElementIndex>(WaterFlowChunkSize), range.End));
+            }
+        }
+
+        for (size_t c = 0; c < mWaterFlowSpringChunks.size(); ++c)
+        {
+            mWaterFlowSpringTasks.emplace_back(
+                [this, c]()
+                {
+                    mCurrentWaterFlowPassRunner(mCurrentWaterFlowPass, c);
+                });
+        }
+
+        size_t const pointChunkCount = (mAwakeWetFrontPoints.size() + WaterFlowChunkSize - 1) / WaterFlowChunkSize;
+        for (size_t c = 0; c < pointChunkCount; ++c)
+        {
+            mWaterFlowPointTasks.emplace_back(
+                [this, c]()
+                {
+                    mCurrentWaterFlowPassRunner(mCurrentWaterFlowPass, c);
+                });
+        }
+
+        mWaterSplashedChunkSums.resize(pointChunkCount);
+    }
+
+    mIsAwakeWetFrontDirty = false;
+}
+
+void Ship::MergeUnsortedTail(
+    std::vector<ElementIndex> & elements,
+    size_t sortedCount,
+    std::vector<ElementIndex> & mergeBuffer)
+{
+    assert(sortedCount <= elements.size());
+
+    if (sortedCount == elements.size())
+        return;
+
+    auto const tailStart = elements.begin() + sortedCount;
+    std::sort(tailStart, elements.end());
+
+    if (sortedCount == 0)
+        return;
+
+    // Merge out of place and copy back, as in-place merging might allocate
+    mergeBuffer.clear();
+    std::merge(
+        elements.begin(), tailStart,
+        tailStart, elements.end(),
+        std::back_inserter(mergeBuffer));
+
+    std::copy(mergeBuffer.begin(), mergeBuffer.end(), elements.begin());
+}
+
+bool Ship::IsParallelWaterFlowUsed(GameParameters const & gameParameters) const
+{
+    // With one thread the parallel flow would just calculate each spring's flow twice
+    return gameParameters.UseParallelWaterFlow
+        && mParentWorld.GetTaskThreadPool().GetParallelism() > 1;
+}
+
+template<typename TPass>
+void Ship::RunWaterFlowPass(
+    std::vector<TaskThreadPool::Task> const & tasks,
+    TPass const & pass)
+{
+    mCurrentWaterFlowPass = &pass;
+    mCurrentWaterFlowPassRunner = [](void const * pass, size_t chunkIndex)
+    {
+        (*static_cast<TPass const *>(pass))(chunkIndex);
+    };
+
+    mParentWorld.GetTaskThreadPool().Run(tasks);
+
+    mCurrentWaterFlowPass = nullptr;
+}
+
+inline float Ship::CalculateWaterKineticEnergyLoss(
+    float ma,
+    float va,
+    float mb,
+    float vb,
+    float waterPermeability)
+{
+    //
+    // Kinetic energy lost by a quantity of water ma moving at va into a quantity mb
+    // moving at vb (perfectly inelastic collision), or into a wall when impermeable.
+    //
+    // When negative, the other endpoint would have lost more, and we pick that up
+    // when visiting it.
+    //
+
+    float const totalMass = ma + mb;
+    float const vf = (totalMass != 0.0f)
+        ? (ma * va + mb * vb) / totalMass * waterPermeability
+        : 0.0f;
+
+    return std::max(0.5f * ma * (va * va - vf * vf), 0.0f);
+}
+
+inline float Ship::CalculateWaterFreenessFactor(
+    float water,
+    MathQuality mathQuality)
+{
+    //
+    // How much a point's quantity of water "suppresses" splashes from
+    // adjacent kinetic energy losses
+    //
+
+    return (mathQuality == MathQuality::Fast)
+        ? FastExp(-water * 10.0f)
+        : exp(-water * 10.0f);
+}
+
+void Ship::UpdateWaterVelocities(
+    GameParameters const & gameParameters,
+    float & waterSplashed)
+{
+    //
+    // For each point, move each spring's outgoing water momentum to 
+    // its destination point
+    //
+
+    // Calculate water momenta
+    mPoints.UpdateWaterMomentaFromVelocities();
+
+    // Source and result water buffers
+    float * restrict oldPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    float * restrict newPointWaterBufferData = mPoints.GetNewWaterBufferAsFloat();
+    vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+    vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+
+    // Weights of outbound water flows along each spring, including impermeable ones;
+    // set to zero for springs whose resultant scalar water velocities are 
+    // directed towards the point being visited
+    std::array<float, GameParameters::MaxSpringsPerPoint> springOutboundWaterFlowWeights;
+
+    // Total weight
+    float totalOutboundWaterFlowWeight;
+
+    // Resultant water velocities along each spring
+    std::array<vec2f, GameParameters::MaxSpringsPerPoint> springOutboundWaterVelocities;
+
+    //
+    // Precalculate point "freeness factors", i.e. how much each point's
+    // quantity of water "suppresses" splashes from adjacent kinetic energy losses
+    //
+
+    auto pointFreenessFactorBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
+    for (auto pointIndex : mAwakePoints)
+    {
+        pointFreenessFactorBufferData[pointIndex] = CalculateWaterFreenessFactor(
+            oldPointWaterBufferData[pointIndex],
+            gameParameters.WaterMathQuality);
+    }
+
+
+    //
+    // Visit all awake points and move water and its momenta; water never crosses
+    // connected components, hence the water of sleeping ones stays where it is
+    //
+    
+    for (auto pointIndex : mAwakePoints)
+    {
+        //
+        // 1) Calculate water momenta along all springs
+        //
+
+        // A higher crazyness gives more emphasys to bernoulli's velocity, as if pressures
+        // and gravity were exaggerated
+        //
+        // WaterCrazyness=0   -> alpha=1
+        // WaterCrazyness=0.5 -> alpha=0.5 + 0.5*Wh
+        // WaterCrazyness=1   -> alpha=Wh
+        float const alphaCrazyness = 1.0f + gameParameters.WaterCrazyness * (oldPointWaterBufferData[pointIndex] - 1.0f);
+
+        // Kinetic energy lost at this point
+        float pointKineticEnergyLoss = 0.0f;
+        
+        // Count of non-hull free and drowned neighbor points
+        float pointSplashNeighbors = 0.0f;
+        float pointSplashFreeNeighbors = 0.0f;
+
+        totalOutboundWaterFlowWeight = 0.0f;
+
+        for (size_t s = 0; s < mPoints.GetConnectedSprings(pointIndex).size(); ++s)
+        {
+            auto const springIndex = mPoints.GetConnectedSprings(pointIndex)[s];
+
+            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+
+            // Normalized spring vector, oriented point -> other endpoint
+            vec2f const springNormalizedVector =
+                mSprings.GetCurrentNormalizedVector(springIndex)
+                * mSprings.GetSpringDirectionFrom(springIndex, pointIndex);
+
+            // Component of the point's own velocity along the spring
+            float const pointVelocityAlongSpring =
+                oldPointWaterVelocityBufferData[pointIndex]
+                .dot(springNormalizedVector);
+
+            //
+            // Calulate Bernoulli's velocity gained along this spring, from this point to 
+            // the other endpoint
+            //
+
+            // Pressure difference (positive implies point -> other endpoint flow)
+            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[otherEndpointIndex];
+
+            // Gravity potential difference (positive implies point -> other endpoint flow)
+            float const dy = mPoints.GetPosition(pointIndex).y - mPoints.GetPosition(otherEndpointIndex).y;
+
+            // Calculate gained water velocity along this spring, from point to other endpoint
+            // (Bernoulli, 1738)
+            float bernoulliVelocityAlongSpring;
+            float const dwy = dw + dy;
+            if (dwy >= 0.0f)
+            {
+                // Gained velocity goes from point to other endpoint
+                bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
+            }
+            else
+            {
+                // Gained velocity goes from other endpoint to point
+                bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
+            }
+
+            // Resultant scalar velocity along spring; outbound only, as
+            // if this were inbound it wouldn't result in any water movement
+            // between these two springs. Morevoer, Bernoulli's velocity injected
+            // along this spring will be picked up later also by the other endpoint,
+            // and at that time it would move water if it agrees with its velocity
+            float const springOutboundScalarWaterVelocity = std::max(
+                pointVelocityAlongSpring + bernoulliVelocityAlongSpring * alphaCrazyness,
+                0.0f);
+
+            // Store weight along spring, scaling for the greater distance traveled along
+            // diagonalsprings
+            springOutboundWaterFlowWeights[s] = 
+                springOutboundScalarWaterVelocity
+                / mSprings.GetRestLength(springIndex);
+
+            // Resultant outbound velocity along spring
+            springOutboundWaterVelocities[s] =
+                springNormalizedVector
+                * springOutboundScalarWaterVelocity;
+
+            // Update total outbound flow weight
+            totalOutboundWaterFlowWeight += springOutboundWaterFlowWeights[s];
+
+
+            //
+            // Update splash neighbors counts
+            //
+
+            pointSplashFreeNeighbors +=
+                mSprings.GetWaterPermeability(springIndex)
+                * pointFreenessFactorBufferData[otherEndpointIndex];
+
+            pointSplashNeighbors += mSprings.GetWaterPermeability(springIndex);
+        }
+
+
+
+        //
+        // 2) Calculate normalization factor for water flows:
+        //    the quantity of water along a spring is proportional to the weight of the spring
+        //    (resultant velocity along that spring), and the sum of all outbound water flows must
+        //    match the water currently at the point times the quickness fractio
+        //
+
+        assert(totalOutboundWaterFlowWeight >= 0.0f);
+
+        float waterQuantityNormalizationFactor = 0.0f;
+        if (totalOutboundWaterFlowWeight != 0.0f)
+        { 
+            waterQuantityNormalizationFactor =
+                oldPointWaterBufferData[pointIndex]
+                * mCurrentWaterQuickness
+                / totalOutboundWaterFlowWeight;
+        }
+
+
+        //
+        // 3) Move water along all springs according to their flows, 
+        //    and update destination's momenta accordingly
+        //
+
+        for (size_t s = 0; s < mPoints.GetConnectedSprings(pointIndex).size(); ++s)
+        {
+            auto const springIndex = mPoints.GetConnectedSprings(pointIndex)[s];
+
+            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(
+                springIndex,
+                pointIndex);
+
+            // Calculate quantity of water directed outwards
+            float const springOutboundQuantityOfWater =
+                springOutboundWaterFlowWeights[s]
+                * waterQuantityNormalizationFactor;
+
+            assert(springOutboundQuantityOfWater >= 0.0f);
+
+            if (mSprings.GetWaterPermeability(springIndex) != 0.0f)
+            {
+                //
+                // Water - and momentum - move from point to endpoint
+                //
+
+                // Move water quantity
+                newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
+                newPointWaterBufferData[otherEndpointIndex] += springOutboundQuantityOfWater;
+
+                // Remove "old momentum" (old velocity) from point
+                newPointWaterMomentumBufferData[pointIndex] -=
+                    oldPointWaterVelocityBufferData[pointIndex]
+                    * springOutboundQuantityOfWater;
+
+                // Add "new momentum" (old velocity + velocity gained) to other endpoint
+                newPointWaterMomentumBufferData[otherEndpointIndex] +=
+                    springOutboundWaterVelocities[s]
+                    * springOutboundQuantityOfWater;
+
+
+                //
+                // Update point's kinetic energy loss:
+                // splintered water colliding with whole other endpoint
+                //
+
+                vec2f const springNormalizedVector =
+                    mSprings.GetCurrentNormalizedVector(springIndex)
+                    * mSprings.GetSpringDirectionFrom(springIndex, pointIndex);
+
+                float ma = springOutboundQuantityOfWater;
+                float va = springOutboundWaterVelocities[s].length();
+                float mb = oldPointWaterBufferData[otherEndpointIndex];
+                float vb = oldPointWaterVelocityBufferData[otherEndpointIndex].dot(springNormalizedVector);
+
+                float vf = 0.0f;
+                if (ma + mb != 0.0f)
+                    vf = (ma * va + mb * vb) / (ma + mb);
+
+                float deltaKa =
+                    0.5f
+                    * ma
+                    * (va * va - vf * vf);
+
+                // Note: deltaKa might be negative, in which case deltaKb would have been
+                // more positive (perfectly inelastic -> deltaK == max); we will pickup
+                // deltaKb later
+                pointKineticEnergyLoss += std::max(deltaKa, 0.0f);
+            }
+            else
+            {
+                // Deleted springs are removed from points' connected springs
+                assert(!mSprings.IsDeleted(springIndex));
+
+                //
+                // New momentum (old velocity + velocity gained) bounces back
+                // (and zeroes outgoing), assuming perfectly inelastic collision
+                //
+                // No changes to other endpoint
+                //
+
+                newPointWaterMomentumBufferData[pointIndex] -=
+                    springOutboundWaterVelocities[s]
+                    * springOutboundQuantityOfWater;
+
+
+                //
+                // Update point's kinetic energy loss:
+                // entire splintered water
+                //
+
+                float ma = springOutboundQuantityOfWater;
+                float va = springOutboundWaterVelocities[s].length();
+
+                float deltaKa =
+                    0.5f
+                    * ma
+                    * va * va;
+
+                assert(deltaKa >= 0.0f);
+                pointKineticEnergyLoss += deltaKa;
+            }
+        }
+
+        //
+        // 4) Update water splash
+        //
+        
+        if (pointSplashNeighbors != 0.0f)
+        {
+            // Water splashed is proportional to kinetic energy loss that took
+            // place near free points (i.e. not drowned by water)
+            waterSplashed +=
+                pointKineticEnergyLoss
+                * pointSplashFreeNeighbors
+                / pointSplashNeighbors;
+        }
+    }
+
+
+
+    //
+    // Average kinetic energy loss
+    //
+
+    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
+
+
+
+    //
+    // Move result values back to point, transforming momenta into velocities
+    //
+
+    mPoints.SwapWaterBuffers(mAwakePoints);
+    mPoints.UpdateWaterVelocitiesFromMomenta();
+}
+
+void Ship::UpdateWaterVelocitiesEdgeCentric(
+    GameParameters const & gameParameters,
+    float & waterSplashed)
+{
+    //
+    // Same as UpdateWaterVelocities(), but visiting springs rather than points: each
+    // spring moves water in both of its directions at once, while the quantities
+    // that depend on totals at each point are calculated by separate passes
+    // over the points.
+    //
+    // Only visits the awake wet front, and the springs within it.
+    //
+
+    // Calculate water momenta
+    mPoints.UpdateWaterMomentaFromVelocities(mAwakeWetFrontPoints);
+
+    // Source and result water buffers
+    float * restrict oldPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    float * restrict newPointWaterBufferData = mPoints.GetNewWaterBufferAsFloat();
+    vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+    vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+
+    // Scalar outbound water velocities along each spring, in each direction
+    auto springOutboundWaterVelocityAToBBuffer = mSprings.AllocateWorkBufferFloat();
+    float * restrict springOutboundWaterVelocityAToBBufferData = springOutboundWaterVelocityAToBBuffer->data();
+    auto springOutboundWaterVelocityBToABuffer = mSprings.AllocateWorkBufferFloat();
+    float * restrict springOutboundWaterVelocityBToABufferData = springOutboundWaterVelocityBToABuffer->data();
+
+    // Per-point totals
+    auto pointFreenessFactorBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
+    auto pointTotalOutboundWaterFlowWeightBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointTotalOutboundWaterFlowWeightBufferData = pointTotalOutboundWaterFlowWeightBuffer->data();
+    auto pointSplashNeighborsBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointSplashNeighborsBufferData = pointSplashNeighborsBuffer->data();
+    auto pointSplashFreeNeighborsBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointSplashFreeNeighborsBufferData = pointSplashFreeNeighborsBuffer->data();
+    auto pointKineticEnergyLossBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointKineticEnergyLossBufferData = pointKineticEnergyLossBuffer->data();
+
+    for (auto pointIndex : mAwakeWetFrontPoints)
+    {
+        pointFreenessFactorBufferData[pointIndex] = CalculateWaterFreenessFactor(
+            oldPointWaterBufferData[pointIndex],
+            gameParameters.WaterMathQuality);
+
+        pointTotalOutboundWaterFlowWeightBufferData[pointIndex] = 0.0f;
+        pointSplashNeighborsBufferData[pointIndex] = 0.0f;
+        pointSplashFreeNeighborsBufferData[pointIndex] = 0.0f;
+        pointKineticEnergyLossBufferData[pointIndex] = 0.0f;
+    }
+
+    ElementIndex const * restrict const springEndpointsBuffer = mSprings.GetEndpointsBufferAsElementIndex();
+
+
+    //
+    // 1) Calculate outbound water velocities along all springs of the awake wet front
+    //
+
+    for (auto const & range : mAwakeWetFrontSpringRanges)
+    {
+        Algorithms::CalculateSpringOutboundWaterVelocities(
+            range.Start,
+            range.End,
+            springEndpointsBuffer,
+            mSprings.GetCurrentNormalizedVectorBufferAsVec2(),
+            mPoints.GetPositionBufferAsVec2(),
+            oldPointWaterBufferData,
+            oldPointWaterVelocityBufferData,
+            gameParameters.WaterCrazyness,
+            GameParameters::GravityMagnitude,
+            springOutboundWaterVelocityAToBBufferData,
+            springOutboundWaterVelocityBToABufferData,
+            gameParameters.WaterMathQuality);
+    }
+
+
+    //
+    // 2) Accumulate outbound flow weights and splash neighbors at the endpoints; weights
+    //    are scaled for the greater distance traveled along diagonal springs
+    //
+
+    for (auto const & range : mAwakeWetFrontSpringRanges)
+    {
+        for (ElementIndex springIndex = range.Start; springIndex < range.End; ++springIndex)
+        {
+            auto const pointAIndex = springEndpointsBuffer[springIndex * 2];
+            auto const pointBIndex = springEndpointsBuffer[springIndex * 2 + 1];
+
+            float const restLength = mSprings.GetRestLength(springIndex);
+            float const waterPermeability = mSprings.GetWaterPermeability(springIndex);
+
+            pointTotalOutboundWaterFlowWeightBufferData[pointAIndex] += springOutboundWaterVelocityAToBBufferData[springIndex] / restLength;
+            pointTotalOutboundWaterFlowWeightBufferData[pointBIndex] += springOutboundWaterVelocityBToABufferData[springIndex] / restLength;
+
+            pointSplashFreeNeighborsBufferData[pointAIndex] += waterPermeability * pointFreenessFactorBufferData[pointBIndex];
+            pointSplashFreeNeighborsBufferData[pointBIndex] += waterPermeability * pointFreenessFactorBufferData[pointAIndex];
+
+            pointSplashNeighborsBufferData[pointAIndex] += waterPermeability;
+            pointSplashNeighborsBufferData[pointBIndex] += waterPermeability;
+        }
+    }
+
+
+    //
+    // 3) Calculate normalization factors for water flows, in place of the total weights
+    //
+
+    float * restrict const pointWaterQuantityNormalizationFactorBufferData = pointTotalOutboundWaterFlowWeightBufferData;
+
+    for (auto pointIndex : mAwakeWetFrontPoints)
+    {
+        float const totalOutboundWaterFlowWeight = pointTotalOutboundWaterFlowWeightBufferData[pointIndex];
+
+        assert(totalOutboundWaterFlowWeight >= 0.0f);
+
+        pointWaterQuantityNormalizationFactorBufferData[pointIndex] = (totalOutboundWaterFlowWeight != 0.0f)
+            ? oldPointWaterBufferData[pointIndex] * mCurrentWaterQuickness / totalOutboundWaterFlowWeight
+            : 0.0f;
+    }
+
+
+    //
+    // 4) Move water along all springs, in both directions, and update destinations' momenta
+    //    accordingly
+    //
+    // Water permeability is either zero or one, and we use it to blend the two cases
+    // rather than branching on it:
+    // - Permeable: water - and momentum - move to the other endpoint, and the kinetic
+    //   energy lost is the one of the splintered water colliding with the other endpoint's
+    //   water;
+    // - Impermeable: the new momentum bounces back, and the entire kinetic energy of the
+    //   splintered water is lost
+    //
+
+    for (auto const & range : mAwakeWetFrontSpringRanges)
+    {
+        for (ElementIndex springIndex = range.Start; springIndex < range.End; ++springIndex)
+        {
+            auto const pointAIndex = springEndpointsBuffer[springIndex * 2];
+            auto const pointBIndex = springEndpointsBuffer[springIndex * 2 + 1];
+
+            float const restLength = mSprings.GetRestLength(springIndex);
+            float const waterPermeability = mSprings.GetWaterPermeability(springIndex);
+            float const waterImpermeability = 1.0f - waterPermeability;
+
+            assert(waterPermeability == 0.0f || waterPermeability == 1.0f);
+
+            // Oriented A -> B; zero-length springs have no direction, hence the water leaving
+            // along them carries no velocity
+            vec2f const & springNormalizedVector = mSprings.GetCurrentNormalizedVector(springIndex);
+            float const springDirectionLength = (mSprings.GetCurrentLength(springIndex) > 0.0f) ? 1.0f : 0.0f;
+
+            // Quantities of water leaving each endpoint along this spring
+            float const quantityOfWaterAToB =
+                springOutboundWaterVelocityAToBBufferData[springIndex] / restLength
+                * pointWaterQuantityNormalizationFactorBufferData[pointAIndex];
+            float const quantityOfWaterBToA =
+                springOutboundWaterVelocityBToABufferData[springIndex] / restLength
+                * pointWaterQuantityNormalizationFactorBufferData[pointBIndex];
+
+            assert(quantityOfWaterAToB >= 0.0f && quantityOfWaterBToA >= 0.0f);
+
+            // Resultant outbound velocities along the spring
+            vec2f const waterVelocityAToB = springNormalizedVector * springOutboundWaterVelocityAToBBufferData[springIndex];
+            vec2f const waterVelocityBToA = springNormalizedVector * -springOutboundWaterVelocityBToABufferData[springIndex];
+
+            // Move water quantities
+            newPointWaterBufferData[pointAIndex] += (quantityOfWaterBToA - quantityOfWaterAToB) * waterPermeability;
+            newPointWaterBufferData[pointBIndex] += (quantityOfWaterAToB - quantityOfWaterBToA) * waterPermeability;
+
+            // Remove the "old momentum" (old velocity) of the water leaving when permeable,
+            // or the "new momentum" (old velocity + velocity gained) bouncing back when not
+            newPointWaterMomentumBufferData[pointAIndex] -=
+                (oldPointWaterVelocityBufferData[pointAIndex] * waterPermeability + waterVelocityAToB * waterImpermeability)
+                * quantityOfWaterAToB;
+            newPointWaterMomentumBufferData[pointBIndex] -=
+                (oldPointWaterVelocityBufferData[pointBIndex] * waterPermeability + waterVelocityBToA * waterImpermeability)
+                * quantityOfWaterBToA;
+
+            // Add the "new momentum" to the other endpoint, when permeable
+            newPointWaterMomentumBufferData[pointBIndex] += waterVelocityAToB * (quantityOfWaterAToB * waterPermeability);
+            newPointWaterMomentumBufferData[pointAIndex] += waterVelocityBToA * (quantityOfWaterBToA * waterPermeability);
+
+            // Update kinetic energy losses
+            pointKineticEnergyLossBufferData[pointAIndex] += CalculateWaterKineticEnergyLoss(
+                quantityOfWaterAToB,
+                springOutboundWaterVelocityAToBBufferData[springIndex] * springDirectionLength,
+                oldPointWaterBufferData[pointBIndex],
+                oldPointWaterVelocityBufferData[pointBIndex].dot(springNormalizedVector),
+                waterPermeability);
+            pointKineticEnergyLossBufferData[pointBIndex] += CalculateWaterKineticEnergyLoss(
+                quantityOfWaterBToA,
+                springOutboundWaterVelocityBToABufferData[springIndex] * springDirectionLength,
+                oldPointWaterBufferData[pointAIndex],
+                -oldPointWaterVelocityBufferData[pointAIndex].dot(springNormalizedVector),
+                waterPermeability);
+        }
+    }
+
+
+    //
+    // 5) Update water splash
+    //
+
+    for (auto pointIndex : mAwakeWetFrontPoints)
+    {
+        if (pointSplashNeighborsBufferData[pointIndex] != 0.0f)
+        {
+            // Water splashed is proportional to kinetic energy loss that took
+            // place near free points (i.e. not drowned by water)
+            waterSplashed +=
+                pointKineticEnergyLossBufferData[pointIndex]
+                * pointSplashFreeNeighborsBufferData[pointIndex]
+                / pointSplashNeighborsBufferData[pointIndex];
+        }
+    }
+
+
+
+    //
+    // Average kinetic energy loss
+    //
+
+    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
+
+
+
+    //
+    // Move result values back to point, transforming momenta into velocities
+    //
+
+    mPoints.SwapWaterBuffers(mAwakeWetFrontPoints);
+    mPoints.UpdateWaterVelocitiesFromMomenta(mAwakeWetFrontPoints);
+}
+
+void Ship::UpdateWaterVelocitiesParallel(
+    GameParameters const & gameParameters,
+    float & waterSplashed)
+{
+    //
+    // Same as UpdateWaterVelocitiesEdgeCentric(), but each point gathers the water
+    // flowing in and out of it, rather than having the springs scatter water to
+    // their endpoints; each pass only writes to the elements it visits, hence
+    // the awake wet front may be split among threads.
+    //
+    // The water moving along each spring is thus calculated twice - once by each
+    // endpoint - which is the price we pay for not synchronizing.
+    //
+
+    // Calculate water momenta
+    mPoints.UpdateWaterMomentaFromVelocities(mAwakeWetFrontPoints);
+
+    // Source and result water buffers
+    float * restrict oldPointWaterBufferData = mPoints.GetWaterBufferAsFloat();
+    float * restrict newPointWaterBufferData = mPoints.GetNewWaterBufferAsFloat();
+    vec2f * restrict oldPointWaterVelocityBufferData = mPoints.GetWaterVelocityBufferAsVec2();
+    vec2f * restrict newPointWaterMomentumBufferData = mPoints.GetWaterMomentumBufferAsVec2f();
+
+    // Scalar outbound water velocities along each spring, in each direction
+    auto springOutboundWaterVelocityAToBBuffer = mSprings.AllocateWorkBufferFloat();
+    float * restrict springOutboundWaterVelocityAToBBufferData = springOutboundWaterVelocityAToBBuffer->data();
+    auto springOutboundWaterVelocityBToABuffer = mSprings.AllocateWorkBufferFloat();
+    float * restrict springOutboundWaterVelocityBToABufferData = springOutboundWaterVelocityBToABuffer->data();
+
+    // Per-point factors
+    auto pointFreenessFactorBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointFreenessFactorBufferData = pointFreenessFactorBuffer->data();
+    auto pointWaterQuantityNormalizationFactorBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointWaterQuantityNormalizationFactorBufferData = pointWaterQuantityNormalizationFactorBuffer->data();
+    auto pointSplashFactorBuffer = mPoints.AllocateWorkBufferFloat();
+    float * restrict pointSplashFactorBufferData = pointSplashFactorBuffer->data();
+
+    // Runs the specified visitor on all chunks of the awake wet front, in parallel
+    auto const runOnAwakeWetFrontChunks = [this](auto const & chunkVisitor)
+    {
+        RunWaterFlowPass(
+            mWaterFlowPointTasks,
+            [this, &chunkVisitor](size_t c)
+            {
+                chunkVisitor(
+                    c,
+                    mAwakeWetFrontPoints.data() + c * WaterFlowChunkSize,
+                    mAwakeWetFrontPoints.data() + std::min((c + 1) * WaterFlowChunkSize, mAwakeWetFrontPoints.size()));
+            });
+    };
+
+
+    //
+    // 1) Calculate outbound water velocities along all springs of the awake wet front
+    //
+
+    auto const calculateSpringOutboundWaterVelocities = [&](ElementIndex chunkStart, ElementIndex chunkEnd)
+    {
+        Algorithms::CalculateSpringOutboundWaterVelocities(
+            chunkStart,
+            chunkEnd,
+            mSprings.GetEndpointsBufferAsElementIndex(),
+            mSprings.GetCurrentNormalizedVectorBufferAsVec2(),
+            mPoints.GetPositionBufferAsVec2(),
+            oldPointWaterBufferData,
+            oldPointWaterVelocityBufferData,
+            gameParameters.WaterCrazyness,
+            GameParameters::GravityMagnitude,
+            springOutboundWaterVelocityAToBBufferData,
+            springOutboundWaterVelocityBToABufferData,
+            gameParameters.WaterMathQuality);
+    };
+
+    RunWaterFlowPass(
+        mWaterFlowSpringTasks,
+        [this, &calculateSpringOutboundWaterVelocities](size_t c)
+        {
+            calculateSpringOutboundWaterVelocities(
+                mWaterFlowSpringChunks[c].Start,
+                mWaterFlowSpringChunks[c].End);
+        });
+
+    //
+    // ...and the "freeness factors" of all points of the awake wet front, i.e. how much each point's
+    // quantity of water "suppresses" splashes from adjacent kinetic energy losses
+    //
+
+    runOnAwakeWetFrontChunks(
+        [&](size_t /*chunkIndex*/, ElementIndex const * chunkStart, ElementIndex const * chunkEnd)
+        {
+            for (auto it = chunkStart; it != chunkEnd; ++it)
+            {
+                pointFreenessFactorBufferData[*it] = CalculateWaterFreenessFactor(
+                    oldPointWaterBufferData[*it],
+                    gameParameters.WaterMathQuality);
+            }
+        });
+
+
+    //
+    // 2) Calculate normalization factors for water flows and splash factors, by
+    //    gathering outbound flow weights and splash neighbors along all springs
+    //    of each point
+    //
+
+    runOnAwakeWetFrontChunks(
+        [&](size_t /*chunkIndex*/, ElementIndex const * chunkStart, ElementIndex const * chunkEnd)
+        {
+            for (auto it = chunkStart; it != chunkEnd; ++it)
+            {
+                auto const pointIndex = *it;
+
+                float totalOutboundWaterFlowWeight = 0.0f;
+                float pointSplashNeighbors = 0.0f;
+                float pointSplashFreeNeighbors = 0.0f;
+
+                for (auto const springIndex : mPoints.GetConnectedSprings(pointIndex))
+                {
+                    auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+
+                    // No water moves between a dry point and a point at the front
+                    if (mPointWetFrontStates[otherEndpointIndex] == WetFrontState::Dry)
+                        continue;
+
+                    float const springOutboundScalarWaterVelocity = (pointIndex == mSprings.GetPointAIndex(springIndex))
+                        ? springOutboundWaterVelocityAToBBufferData[springIndex]
+                        : springOutboundWaterVelocityBToABufferData[springIndex];
+
+                    totalOutboundWaterFlowWeight += springOutboundScalarWaterVelocity / mSprings.GetRestLength(springIndex);
+
+                    pointSplashFreeNeighbors +=
+                        mSprings.GetWaterPermeability(springIndex)
+                        * pointFreenessFactorBufferData[otherEndpointIndex];
+
+                    pointSplashNeighbors += mSprings.GetWaterPermeability(springIndex);
+                }
+
+                assert(totalOutboundWaterFlowWeight >= 0.0f);
+
+                pointWaterQuantityNormalizationFactorBufferData[pointIndex] = (totalOutboundWaterFlowWeight != 0.0f)
+                    ? oldPointWaterBufferData[pointIndex] * mCurrentWaterQuickness / totalOutboundWaterFlowWeight
+                    : 0.0f;
+
+                pointSplashFactorBufferData[pointIndex] = (pointSplashNeighbors != 0.0f)
+                    ? pointSplashFreeNeighbors / pointSplashNeighbors
+                    : 0.0f;
+            }
+        });
+
+
+    //
+    // 3) Gather water, momenta, and kinetic energy losses along all springs of each point;
+    //    see UpdateWaterVelocitiesEdgeCentric() for the blending of permeable and 
+    //    impermeable springs
+    //
+
+    runOnAwakeWetFrontChunks(
+        [&](size_t chunkIndex, ElementIndex const * chunkStart, ElementIndex const * chunkEnd)
+        {
+            float chunkWaterSplashed = 0.0f;
+
+            for (auto it = chunkStart; it != chunkEnd; ++it)
+            {
+                auto const pointIndex = *it;
+
+                float pointWater = newPointWaterBufferData[pointIndex];
+                vec2f pointWaterMomentum = newPointWaterMomentumBufferData[pointIndex];
+                float pointKineticEnergyLoss = 0.0f;
+
+                for (auto const springIndex : mPoints.GetConnectedSprings(pointIndex))
+                {
+                    auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(springIndex, pointIndex);
+
+                    // No water moves between a dry point and a point at the front
+                    if (mPointWetFrontStates[otherEndpointIndex] == WetFrontState::Dry)
+                        continue;
+
+                    float const waterPermeability = mSprings.GetWaterPermeability(springIndex);
+                    float const waterImpermeability = 1.0f - waterPermeability;
+                    float const restLength = mSprings.GetRestLength(springIndex);
+
+                    // Oriented point -> other endpoint
+                    vec2f const springNormalizedVector =
+                        mSprings.GetCurrentNormalizedVector(springIndex)
+                        * mSprings.GetSpringDirectionFrom(springIndex, pointIndex);
+                    float const springDirectionLength = (mSprings.GetCurrentLength(springIndex) > 0.0f) ? 1.0f : 0.0f;
+
+                    bool const isPointA = (pointIndex == mSprings.GetPointAIndex(springIndex));
+                    float const outboundScalarWaterVelocity = isPointA
+                        ? springOutboundWaterVelocityAToBBufferData[springIndex]
+                        : springOutboundWaterVelocityBToABufferData[springIndex];
+                    float const inboundScalarWaterVelocity = isPointA
+                        ? springOutboundWaterVelocityBToABufferData[springIndex]
+                        : springOutboundWaterVelocityAToBBufferData[springIndex];
+
+                    // Quantities of water leaving the point and leaving the other endpoint
+                    float const outboundQuantityOfWater =
+                        outboundScalarWaterVelocity / restLength
+                        * pointWaterQuantityNormalizationFactorBufferData[pointIndex];
+                    float const inboundQuantityOfWater =
+                        inboundScalarWaterVelocity / restLength
+                        * pointWaterQuantityNormalizationFactorBufferData[otherEndpointIndex];
+
+                    // Move water quantities
+                    pointWater += (inboundQuantityOfWater - outboundQuantityOfWater) * waterPermeability;
+
+                    // Remove the momentum leaving, and add the momentum arriving
+                    vec2f const outboundWaterVelocity = springNormalizedVector * outboundScalarWaterVelocity;
+                    vec2f const inboundWaterVelocity = springNormalizedVector * -inboundScalarWaterVelocity;
+
+                    pointWaterMomentum -=
+                        (oldPointWaterVelocityBufferData[pointIndex] * waterPermeability + outboundWaterVelocity * waterImpermeability)
+                        * outboundQuantityOfWater;
+                    pointWaterMomentum += inboundWaterVelocity * (inboundQuantityOfWater * waterPermeability);
+
+                    // Update kinetic energy loss
+                    pointKineticEnergyLoss += CalculateWaterKineticEnergyLoss(
+                        outboundQuantityOfWater,
+                        outboundScalarWaterVelocity * springDirectionLength,
+                        oldPointWaterBufferData[otherEndpointIndex],
+                        oldPointWaterVelocityBufferData[otherEndpointIndex].dot(springNormalizedVector),
+                        waterPermeability);
+                }
+
+                newPointWaterBufferData[pointIndex] = pointWater;
+                newPointWaterMomentumBufferData[pointIndex] = pointWaterMomentum;
+
+                chunkWaterSplashed += pointKineticEnergyLoss * pointSplashFactorBufferData[pointIndex];
+            }
+
+            mWaterSplashedChunkSums[chunkIndex] = chunkWaterSplashed;
+        });
+
+
+    //
+    // 4) Update water splash, summing up chunks in order
+    //
+
+    for (float const chunkWaterSplashed : mWaterSplashedChunkSums)
+    {
+        waterSplashed += chunkWaterSplashed;
+    }
+
+
+
+    //
+    // Average kinetic energy loss
+    //
+
+    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
+
+
+
+    //
+    // Move result values back to point, transforming momenta into velocities
+    //
+
+    mPoints.SwapWaterBuffers(mAwakeWetFrontPoints);
+    mPoints.UpdateWaterVelocitiesFromMomenta(mAwakeWetFrontPoints);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+// Electrical Dynamics
+///////////////////////////////////////////////////////////////////////////////////
+
+void Ship::UpdateElectricalDynamics(
+    VisitSequenceNumber currentVisitSequenceNumber,
+    GameParameters const & gameParameters)
+{
+    // Generators getting wet or dry change what is powered
+    auto const & generators = mElectricalElements.GetGenerators();
+    for (size_t g = 0; g < generators.size(); ++g)
+    {
+        if (!mElectricalElements.IsDeleted(generators[g]))
+        {
+            bool const isDry = mPoints.GetWater(mElectricalElements.GetPointIndex(generators[g])) < GeneratorMaxWater;
+            if (isDry != mAreGeneratorsDry[g])
+            {
+                mAreGeneratorsDry[g] = isDry;
+                mIsElectricalConnectivityDirty = true;
+            }
+        }
+    }
+
+    // Only re-visit the electrical graph when it might have changed; elements keep
+    // the visit sequence number of the last visit that reached them
+    if (mIsElectricalConnectivityDirty)
+    {
+        UpdateElectricalConnectivity(currentVisitSequenceNumber);
+
+        mElectricalConnectivityVisitSequenceNumber = currentVisitSequenceNumber;
+        mIsElectricalConnectivityDirty = false;
+    }
+
+    mElectricalElements.Update(
+        mElectricalConnectivityVisitSequenceNumber,
+        mPoints,
+        gameParameters);
+
+    DiffuseLight(gameParameters);
+}
+
+void Ship::UpdateElectricalConnectivity(VisitSequenceNumber currentVisitSequenceNumber)
+{
+    //
+    // Visit electrical graph starting from (non-wet) generators, and propagate
+    // visit sequence number
+    //
+
+    // The queue of elements to visit is a vector large enough for all elements,
+    // as each element is queued at most once
+    mElectricalElementsToVisit.clear();
+    size_t electricalElementsToVisitHead = 0;
+
+    auto const & generators = mElectricalElements.GetGenerators();
+    for (size_t g = 0; g < generators.size(); ++g)
+    {
+        auto const generatorIndex = generators[g];
+
+        // Do not visit deleted generators
+        if (!mElectricalElements.IsDeleted(generatorIndex))
+        {
+            // Make sure we haven't visited it already
+            if (currentVisitSequenceNumber != mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(generatorIndex))
+            {
+                // Mark it as visited
+                mElectricalElements.SetConnectivityVisitSequenceNumber(
+                    generatorIndex,
+                    currentVisitSequenceNumber);
+
+                // Check if dry enough
+                if (mAreGeneratorsDry[g])
+                {
+                    // Add generator to queue
+                    assert(electricalElementsToVisitHead == mElectricalElementsToVisit.size());
+                    mElectricalElementsToVisit.push_back(generatorIndex);
+
+                    // Visit all electrical elements reachable from this generator
+                    while (electricalElementsToVisitHead < mElectricalElementsToVisit.size())
+                    {
+                        auto e = mElectricalElementsToVisit[electricalElementsToVisitHead++];
+
+                        assert(currentVisitSequenceNumber == mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(e));
+
+                        for (auto reachableElectricalElementIndex : mElectricalElements.GetConnectedElectricalElements(e))
+                        {
+                            assert(!mElectricalElements.IsDeleted(reachableElectricalElementIndex));
+
+                            // Make sure not visited already
+                            if (currentVisitSequenceNumber != mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(reachableElectricalElementIndex))
+                            {
+                                // Add to queue
+                                mElectricalElementsToVisit.push_back(reachableElectricalElementIndex);
+
+                                // Mark it as visited
+                                mElectricalElements.SetConnectivityVisitSequenceNumber(
+                                    reachableElectricalElementIndex,
+                                    currentVisitSequenceNumber);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Ship::DiffuseLight(GameParameters const & gameParameters)
+{
+    //
+    // Diffuse light from each lamp to the points in its connected component,
+    // inversely-proportional to the square of the distance.
+    //
+    // Points farther than the distance at which a lamp's light becomes invisible
+    // get none of it, hence each lamp only visits the points in the cells of
+    // a uniform grid that are within that distance.
+    //
+
+    auto const & lamps = mElectricalElements.GetLamps();
+
+    // Check whether lamp currents have changed;
+    // can safely visit deleted lamps as their current will always be zero
+    for (size_t l = 0; l < lamps.size(); ++l)
+    {
+        float const lampLight = mElectricalElements.GetAvailableCurrent(lamps[l]);
+        if (lampLight != mLampLights[l])
+        {
+            mLampLights[l] = lampLight;
+            mIsLightDirty = true;
+        }
+    }
+
+    if (gameParameters.LightDiffusionAdjustment != mLightDiffusionAdjustment)
+    {
+        mLightDiffusionAdjustment = gameParameters.LightDiffusionAdjustment;
+        mIsLightDirty = true;
+    }
+
+    if (!mIsLightDirty)
+    {
+        // Light moves with the points it is at
+        return;
+    }
+
+    mIsLightDirty = false;
+
+    // Zero-out light at all points first
+    for (auto pointIndex : mPoints)
+    {
+        // Zero its light
+        mPoints.GetLight(pointIndex) = 0.0f;
+    }
+
+    // Greater adjustment => underrated distance => wider diffusion
+    float const adjustmentCoefficient = powf(1.0f - mLightDiffusionAdjustment, 2.0f);
+
+    if (adjustmentCoefficient == 0.0f)
+    {
+        // Distances don't count, and each point gets the light of the brightest
+        // lamp in its connected component
+        mConnectedComponentLights.assign(mConnectedComponentSizes.size(), 0.0f);
+        for (size_t l = 0; l < lamps.size(); ++l)
+        {
+            ConnectedComponentId const lampConnectedComponentId = mPoints.GetConnectedComponentId(
+                mElectricalElements.GetPointIndex(lamps[l]));
+
+            if (lampConnectedComponentId > 0 && lampConnectedComponentId <= mConnectedComponentLights.size())
+            {
+                mConnectedComponentLights[lampConnectedComponentId - 1] = std::max(
+                    mConnectedComponentLights[lampConnectedComponentId - 1],
+                    mLampLights[l]);
+            }
+        }
+
+        for (auto pointIndex : mPoints.GetActiveElements())
+        {
+            if (!mPoints.IsDeleted(pointIndex))
+            {
+                mPoints.GetLight(pointIndex) = mConnectedComponentLights[mPoints.GetConnectedComponentId(pointIndex) - 1];
+            }
+        }
+
+        return;
+    }
+
+    // The square distance at which the light of a lamp becomes invisible:
+    // lampLight / (d^2 * adjustmentCoefficient) < epsilon
+    float const unitSquareCutoffDistance = 1.0f / (LightVisibilityEpsilon * adjustmentCoefficient);
+
+    //
+    // Bucket the non-deleted points into the grid, with cells as wide as the cutoff
+    // distance of the brightest lamps
+    //
+
+    vec2f minPosition(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    vec2f maxPosition(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+    for (auto pointIndex : mPoints.GetActiveElements())
+    {
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            vec2f const & position = mPoints.GetPosition(pointIndex);
+            minPosition.x = std::min(minPosition.x, position.x);
+            minPosition.y = std::min(minPosition.y, position.y);
+            maxPosition.x = std::max(maxPosition.x, position.x);
+            maxPosition.y = std::max(maxPosition.y, position.y);
+        }
+    }
+
+    if (minPosition.x > maxPosition.x)
+    {
+        // No points
+        return;
+    }
+
+    float const cellSize = std::max(
+        sqrtf(unitSquareCutoffDistance),
+        std::max(maxPosition.x - minPosition.x, maxPosition.y - minPosition.y) / static_cast<float>(MaxLightDiffusionGridCellsPerSide - 1));
+
+    size_t const cellsX = static_cast<size_t>((maxPosition.x - minPosition.x) / cellSize) + 1;
+    size_t const cellsY = static_cast<size_t>((maxPosition.y - minPosition.y) / cellSize) + 1;
+
+    auto const getCell = [&](vec2f const & position)
+    {
+        size_t const cellX = std::min(static_cast<size_t>((position.x - minPosition.x) / cellSize), cellsX - 1);
+        size_t const cellY = std::min(static_cast<size_t>((position.y - minPosition.y) / cellSize), cellsY - 1);
+        return cellY * cellsX + cellX;
+    };
+
+    // Count the points in each cell
+    mLightDiffusionGridCellStarts.assign(cellsX * cellsY + 1, 0);
+    for (auto pointIndex : mPoints.GetActiveElements())
+    {
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            ++mLightDiffusionGridCellStarts[getCell(mPoints.GetPosition(pointIndex)) + 1];
+        }
+    }
+
+    // Turn the counts into starts
+    for (size_t c = 1; c < mLightDiffusionGridCellStarts.size(); ++c)
+    {
+        mLightDiffusionGridCellStarts[c] += mLightDiffusionGridCellStarts[c - 1];
+    }
+
+    // Place the points, using the start of each cell as its cursor...
+    mLightDiffusionGridPoints.resize(mLightDiffusionGridCellStarts.back());
+    for (auto pointIndex : mPoints.GetActiveElements())
+    {
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            mLightDiffusionGridPoints[mLightDiffusionGridCellStarts[getCell(mPoints.GetPosition(pointIndex))]++] = pointIndex;
+        }
+    }
+
+    // ...and restore the starts, which the cursors have moved to the next cell's
+    for (size_t c = mLightDiffusionGridCellStarts.size() - 1; c > 0; --c)
+    {
+        mLightDiffusionGridCellStarts[c] = mLightDiffusionGridCellStarts[c - 1];
+    }
+
+    mLightDiffusionGridCellStarts[0] = 0;
+
+    //
+    // Go through all lamps, visiting the cells within their cutoff distance
+    //
+
+    for (size_t l = 0; l < lamps.size(); ++l)
+    {
+        float const lampLight = mLampLights[l];
+        if (lampLight <= 0.0f)
+            continue;
+
+        auto const lampPointIndex = mElectricalElements.GetPointIndex(lamps[l]);
+        vec2f const & lampPosition = mPoints.GetPosition(lampPointIndex);
+        ConnectedComponentId const lampConnectedComponentId = mPoints.GetConnectedComponentId(lampPointIndex);
+
+        float const lampSquareCutoffDistance = lampLight * unitSquareCutoffDistance;
+        float const lampCutoffDistance = sqrtf(lampSquareCutoffDistance);
+
+        // Find the cells overlapping the box around the lamp, clamped to the grid
+        auto const toCell = [cellSize](float coordinate, float minCoordinate, size_t cellCount)
+        {
+            float const cell = (coordinate - minCoordinate) / cellSize;
+            if (cell <= 0.0f)
+                return size_t(0);
+            return std::min(static_cast<size_t>(cell), cellCount - 1);
+        };
+
+        size_t const startCellX = toCell(lampPosition.x - lampCutoffDistance, minPosition.x, cellsX);
+        size_t const endCellX = toCell(lampPosition.x + lampCutoffDistance, minPosition.x, cellsX);
+        size_t const startCellY = toCell(lampPosition.y - lampCutoffDistance, minPosition.y, cellsY);
+        size_t const endCellY = toCell(lampPosition.y + lampCutoffDistance, minPosition.y, cellsY);
+
+        auto const diffuseToPoint = [&](ElementIndex pointIndex)
+        {
+            float const pointSquareDistance = (mPoints.GetPosition(pointIndex) - lampPosition).squareLength();
+            if (pointSquareDistance < lampSquareCutoffDistance)
+            {
+                float squareDistance = std::max(
+                    1.0f,
+                    pointSquareDistance * adjustmentCoefficient);
+
+                assert(squareDistance >= 1.0f);
+
+                float newLight = lampLight / squareDistance;
+                if (newLight > mPoints.GetLight(pointIndex))
+                    mPoints.GetLight(pointIndex) = newLight;
+            }
+        };
+
+        // Count the points in those cells, so that we may rather visit the lamp's
+        // connected component when it's smaller - e.g. when the lamp is on debris
+        size_t cellPointsCount = 0;
+        for (size_t cellY = startCellY; cellY <= endCellY; ++cellY)
+        {
+            cellPointsCount +=
+                mLightDiffusionGridCellStarts[cellY * cellsX + endCellX + 1]
+                - mLightDiffusionGridCellStarts[cellY * cellsX + startCellX];
+        }
+
+        assert(lampConnectedComponentId > 0 && lampConnectedComponentId < mConnectedComponentPointOffsets.size());
+        ElementIndex const connectedComponentPointsStart = mConnectedComponentPointOffsets[lampConnectedComponentId - 1];
+        ElementIndex const connectedComponentPointsEnd = mConnectedComponentPointOffsets[lampConnectedComponentId];
+
+        if (connectedComponentPointsEnd - connectedComponentPointsStart < cellPointsCount)
+        {
+            for (ElementIndex cp = connectedComponentPointsStart; cp < connectedComponentPointsEnd; ++cp)
+            {
+                auto const pointIndex = mConnectedComponentPoints[cp];
+
+                if (!mPoints.IsDeleted(pointIndex)
+                    && mPoints.GetConnectedComponentId(pointIndex) == lampConnectedComponentId)
+                {
+                    diffuseToPoint(pointIndex);
+                }
+            }
+        }
+        else
+        {
+            for (size_t cellY = startCellY; cellY <= endCellY; ++cellY)
+            {
+                // The cells of a row are contiguous
+                for (ElementIndex gp = mLightDiffusionGridCellStarts[cellY * cellsX + startCellX]; gp < mLightDiffusionGridCellStarts[cellY * cellsX + endCellX + 1]; ++gp)
+                {
+                    auto const pointIndex = mLightDiffusionGridPoints[gp];
+
+                    if (mPoints.GetConnectedComponentId(pointIndex) == lampConnectedComponentId)
+                    {
+                        diffuseToPoint(pointIndex);
+                    }
+                }
+            }
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+// Private helpers
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+void Ship::DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNumber)
+{
+    mConnectedComponentSizes.clear();
+    mConnectedComponentPointOffsets.assign(1, 0);
+    mConnectedComponentPoints.clear();
+
+    ConnectedComponentId currentConnectedComponentId = 0;
+    std::queue<ElementIndex> pointsToVisitForConnectedComponents;
+
+    // Visit all points
+    for (auto pointIndex : mPoints.GetActiveElements())
+    {
+        // Don't visit destroyed points, or we run the risk of creating a zillion connected components
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            // Check if visited
+            if (mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(pointIndex) != currentVisitSequenceNumber)
+            {
+                // This node has not been visited, hence it's the beginning of a new connected component
+                ++currentConnectedComponentId;
+                size_t pointsInCurrentConnectedComponent = 0;
+
+                //
+                // Propagate the connected component ID to all points reachable from this point
+                //
+
+                // Add point to queue
+                assert(pointsToVisitForConnectedComponents.empty());
+                pointsToVisitForConnectedComponents.push(pointIndex);
+
+                // Mark as visited
+                mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(
+                    pointIndex,
+                    currentVisitSequenceNumber);
+
+                // Visit all points reachable from this point via springs
+                while (!pointsToVisitForConnectedComponents.empty())
+                {
+                    auto currentPointIndex = pointsToVisitForConnectedComponents.front();
+                    pointsToVisitForConnectedComponents.pop();
+
+                    assert(currentVisitSequenceNumber == mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(currentPointIndex));
+
+                    // Assign the connected component ID
+                    mPoints.SetConnectedComponentId(currentPointIndex, currentConnectedComponentId);
+                    ++pointsInCurrentConnectedComponent;
+                    mConnectedComponentPoints.push_back(currentPointIndex);
+
+                    // Go through this point's adjacents
+                    for (auto adjacentSpringElementIndex : mPoints.GetConnectedSprings(currentPointIndex))
+                    {
+                        assert(!mSprings.IsDeleted(adjacentSpringElementIndex));
+
+                        auto pointAIndex = mSprings.GetPointAIndex(adjacentSpringElementIndex);
+                        assert(!mPoints.IsDeleted(pointAIndex));
+                        if (currentVisitSequenceNumber != mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(pointAIndex))
+                        {
+                            mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(pointAIndex, currentVisitSequenceNumber);
+                            pointsToVisitForConnectedComponents.push(pointAIndex);
+                        }
+
+                        auto pointBIndex = mSprings.GetPointBIndex(adjacentSpringElementIndex);
+                        assert(!mPoints.IsDeleted(pointBIndex));
+                        if (currentVisitSequenceNumber != mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(pointBIndex))
+                        {
+                            mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(pointBIndex, currentVisitSequenceNumber);
+                            pointsToVisitForConnectedComponents.push(pointBIndex);
+                        }
+                    }
+                }
+
+                // Store number of connected components
+                mConnectedComponentSizes.push_back(pointsInCurrentConnectedComponent);
+                mConnectedComponentPointOffsets.push_back(static_cast<ElementIndex>(mConnectedComponentPoints.size()));
+            }
+        }
+    }
+
+    // Connected component IDs have changed, hence everybody starts awake again
+    mConnectedComponentSleepStates.assign(mConnectedComponentSizes.size(), ConnectedComponentSleepState());
+    mAreAwakeElementsDirty = true;
+
+    // Lamps light up different points now
+    mIsLightDirty = true;
+}
+
+void Ship::UpdateConnectedComponents()
+{
+    //
+    // Deletions may only split connected components, and each part that splits off
+    // has at least one split candidate, as it has lost springs or neighbors; hence we
+    // check each surviving candidate against the candidates that we know to be in
+    // distinct parts, and it either joins one of their parts or it starts a new one.
+    //
+    // Candidates are all checked against each other, as the candidates of a deleted
+    // point might have been deleted in the same step; they are visited in memory order,
+    // and checked against the most recent parts first, as these are the nearest ones.
+    //
+
+    std::sort(mConnectedComponentSplitCandidates.begin(), mConnectedComponentSplitCandidates.end());
+    mConnectedComponentSplitCandidates.erase(
+        std::unique(mConnectedComponentSplitCandidates.begin(), mConnectedComponentSplitCandidates.end()),
+        mConnectedComponentSplitCandidates.end());
+
+    mConnectedComponentSplitRepresentatives.clear();
+
+    bool hasSplit = false;
+
+    for (auto const candidateIndex : mConnectedComponentSplitCandidates)
+    {
+        // Deleted points belong to no connected component
+        if (mPoints.IsDeleted(candidateIndex))
+            continue;
+
+        // Whatever happens, the connected component has been shaken
+        WakeUpConnectedComponent(mPoints.GetConnectedComponentId(candidateIndex));
+
+        bool isConnectedToRepresentative = false;
+        for (auto it = mConnectedComponentSplitRepresentatives.rbegin(); it != mConnectedComponentSplitRepresentatives.rend(); ++it)
+        {
+            // Points in different connected components are already known to be disconnected;
+            // the candidate's ID changes when it splits off
+            if (mPoints.GetConnectedComponentId(*it) != mPoints.GetConnectedComponentId(candidateIndex))
+                continue;
+
+            if (SplitConnectedComponent(*it, candidateIndex))
+            {
+                hasSplit = true;
+            }
+            else
+            {
+                isConnectedToRepresentative = true;
+                break;
+            }
+        }
+
+        if (!isConnectedToRepresentative)
+        {
+            // Starts a new part
+            mConnectedComponentSplitRepresentatives.push_back(candidateIndex);
+        }
+    }
+
+    mConnectedComponentSplitCandidates.clear();
+
+    if (hasSplit)
+    {
+        // Lamps light up different points now
+        mIsLightDirty = true;
+    }
+
+    // Deleted points are still in the awake elements
+    mAreAwakeElementsDirty = true;
+}
+
+bool Ship::SplitConnectedComponent(
+    ElementIndex pointAIndex,
+    ElementIndex pointBIndex)
+{
+    //
+    // Search the connected component from both points at the same pace, one point
+    // at a time; if the searches meet, the points are still connected, otherwise
+    // the side that runs out of points first has split off - and it's the
+    // smaller side, which is the one we relabel
+    //
+
+    // Get two new marks, resetting them all when they wrap around
+    if (mCurrentConnectedComponentSearchMark >= std::numeric_limits<std::uint32_t>::max() - 2)
+    {
+        std::fill(mConnectedComponentSearchMarks.begin(), mConnectedComponentSearchMarks.end(), 0);
+        mCurrentConnectedComponentSearchMark = 0;
+    }
+
+    std::uint32_t const searchMarkA = ++mCurrentConnectedComponentSearchMark;
+    std::uint32_t const searchMarkB = ++mCurrentConnectedComponentSearchMark;
+
+    mConnectedComponentSearchPointsA.clear();
+    mConnectedComponentSearchPointsA.push_back(pointAIndex);
+    mConnectedComponentSearchMarks[pointAIndex] = searchMarkA;
+    size_t searchHeadA = 0;
+
+    mConnectedComponentSearchPointsB.clear();
+    mConnectedComponentSearchPointsB.push_back(pointBIndex);
+    mConnectedComponentSearchMarks[pointBIndex] = searchMarkB;
+    size_t searchHeadB = 0;
+
+    std::vector<ElementIndex> const * splitPoints = nullptr;
+    while (true)
+    {
+        if (searchHeadA == mConnectedComponentSearchPointsA.size())
+        {
+            splitPoints = &mConnectedComponentSearchPointsA;
+            break;
+        }
+
+        if (ExpandConnectedComponentSearch(mConnectedComponentSearchPointsA, searchHeadA, searchMarkA, searchMarkB))
+        {
+            // Still connected
+            return false;
+        }
+
+        if (searchHeadB == mConnectedComponentSearchPointsB.size())
+        {
+            splitPoints = &mConnectedComponentSearchPointsB;
+            break;
+        }
+
+        if (ExpandConnectedComponentSearch(mConnectedComponentSearchPointsB, searchHeadB, searchMarkB, searchMarkA))
+        {
+            // Still connected
+            return false;
+        }
+    }
 
-            // Component of the point's own velocity along the spring
-            float const pointVelocityAlongSpring =
-                oldPointWaterVelocityBufferData[pointIndex]
-                .dot(springNormalizedVector);
+    assert(nullptr != splitPoints);
 
-            //
-            // Calulate Bernoulli's velocity gained along this spring, from this point to 
-            // the other endpoint
-            //
+    //
+    // Move the split-off points to a new connected component
+    //
 
-            // Pressure difference (positive implies point -> other endpoint flow)
-            float const dw = oldPointWaterBufferData[pointIndex] - oldPointWaterBufferData[otherEndpointIndex];
+    ConnectedComponentId const oldConnectedComponentId = mPoints.GetConnectedComponentId(pointAIndex);
+    ConnectedComponentId const newConnectedComponentId = static_cast<ConnectedComponentId>(mConnectedComponentSizes.size() + 1);
 
-            // Gravity potential difference (positive implies point -> other endpoint flow)
-            float const dy = mPoints.GetPosition(pointIndex).y - mPoints.GetPosition(otherEndpointIndex).y;
+    for (auto pointIndex : *splitPoints)
+    {
+        mPoints.SetConnectedComponentId(pointIndex, newConnectedComponentId);
+        mConnectedComponentPoints.push_back(pointIndex);
+    }
 
-            // Calculate gained water velocity along this spring, from point to other endpoint
-            // (Bernoulli, 1738)
-            float bernoulliVelocityAlongSpring;
-            float const dwy = dw + dy;
-            if (dwy >= 0.0f)
-            {
-                // Gained velocity goes from point to other endpoint
-                bernoulliVelocityAlongSpring = sqrtf(2.0f * GameParameters::GravityMagnitude * dwy);
-            }
-            else
-            {
-                // Gained velocity goes from other endpoint to point
-                bernoulliVelocityAlongSpring = -sqrtf(2.0f * GameParameters::GravityMagnitude * -dwy);
-            }
+    // Sizes are upper bounds, as they count points that were deleted since the detection
+    assert(mConnectedComponentSizes[oldConnectedComponentId - 1] >= splitPoints->size());
+    mConnectedComponentSizes[oldConnectedComponentId - 1] -= splitPoints->size();
+    mConnectedComponentSizes.push_back(splitPoints->size());
 
-            // Resultant scalar velocity along spring; outbound only, as
-            // if this were inbound it wouldn't result in any water movement
-            // between these two springs. Morevoer, Bernoulli's velocity injected
-            // along this spring will be picked up later also by the other endpoint,
-            // and at that time it would move water if it agrees with its velocity
-            float const springOutboundScalarWaterVelocity = std::max(
-                pointVelocityAlongSpring + bernoulliVelocityAlongSpring * alphaCrazyness,
-                0.0f);
+    mConnectedComponentPointOffsets.push_back(static_cast<ElementIndex>(mConnectedComponentPoints.size()));
 
-            // Store weight along spring, scaling for the greater distance traveled along
-            // diagonalsprings
-            springOutboundWaterFlowWeights[s] = 
-                springOutboundScalarWaterVelocity
-                / mSprings.GetRestLength(springIndex);
+    // Both parts are on the move
+    WakeUpConnectedComponent(oldConnectedComponentId);
+    mConnectedComponentSleepStates.emplace_back();
 
-            // Resultant outbound velocity along spring
-            springOutboundWaterVelocities[s] =
-                springNormalizedVector
-                * springOutboundScalarWaterVelocity;
+    return true;
+}
 
-            // Update total outbound flow weight
-            totalOutboundWaterFlowWeight += springOutboundWaterFlowWeights[s];
+inline bool Ship::ExpandConnectedComponentSearch(
+    std::vector<ElementIndex> & searchPoints,
+    size_t & searchHead,
+    std::uint32_t searchMark,
+    std::uint32_t otherSearchMark)
+{
+    auto const pointIndex = searchPoints[searchHead++];
 
+    for (auto springIndex : mPoints.GetConnectedSprings(pointIndex))
+    {
+        assert(!mSprings.IsDeleted(springIndex));
 
-            //
-            // Update splash neighbors counts
-            //
+        auto const otherPointIndex = (mSprings.GetPointAIndex(springIndex) == pointIndex)
+            ? mSprings.GetPointBIndex(springIndex)
+            : mSprings.GetPointAIndex(springIndex);
 
-            pointSplashFreeNeighbors +=
-                mSprings.GetWaterPermeability(springIndex)
-                * pointFreenessFactorBufferData[otherEndpointIndex];
+        assert(!mPoints.IsDeleted(otherPointIndex));
 
-            pointSplashNeighbors += mSprings.GetWaterPermeability(springIndex);
+        auto & mark = mConnectedComponentSearchMarks[otherPointIndex];
+        if (mark == otherSearchMark)
+        {
+            // The searches have met
+            return true;
         }
 
+        if (mark != searchMark)
+        {
+            mark = searchMark;
+            searchPoints.push_back(otherPointIndex);
+        }
+    }
 
+    return false;
+}
 
-        //
-        // 2) Calculate normalization factor for water flows:
-        //    the quantity of water along a spring is proportional to the weight of the spring
-        //    (resultant velocity along that spring), and the sum of all outbound water flows must
-        //    match the water currently at the point times the quickness fractio
-        //
+void Ship::UpdateConnectedComponentSleepStates(GameParameters const & gameParameters)
+{
+    float const * restrict cachedWaterSurfaceHeights = mPoints.GetCachedWaterSurfaceHeightBufferAsFloat();
 
-        assert(totalOutboundWaterFlowWeight >= 0.0f);
+    //
+    // Wake up the sleeping connected components that have points crossing the water surface
+    //
 
-        float waterQuantityNormalizationFactor = 0.0f;
-        if (totalOutboundWaterFlowWeight != 0.0f)
-        { 
-            waterQuantityNormalizationFactor =
-                oldPointWaterBufferData[pointIndex]
-                * gameParameters.WaterQuickness
-                / totalOutboundWaterFlowWeight;
+    for (auto pointIndex : mSleepingPoints)
+    {
+        bool const isUnderwater = mPoints.GetPosition(pointIndex).y < cachedWaterSurfaceHeights[pointIndex];
+        if (isUnderwater != mSleepCheckIsUnderwater[pointIndex])
+        {
+            WakeUpConnectedComponent(mPoints.GetConnectedComponentId(pointIndex));
         }
+    }
 
+    //
+    // Accumulate the kinetic energy and max velocity of all awake connected components
+    //
 
-        //
-        // 3) Move water along all springs according to their flows, 
-        //    and update destination's momenta accordingly
-        //
+    float constexpr SquareStepTimeDuration =
+        GameParameters::SimulationStepTimeDuration<float> * GameParameters::SimulationStepTimeDuration<float>;
 
-        for (size_t s = 0; s < mPoints.GetConnectedSprings(pointIndex).size(); ++s)
+    for (auto pointIndex : mAwakePoints)
+    {
+        if (!mPoints.IsDeleted(pointIndex))
         {
-            auto const springIndex = mPoints.GetConnectedSprings(pointIndex)[s];
+            auto & sleepState = mConnectedComponentSleepStates[mPoints.GetConnectedComponentId(pointIndex) - 1];
 
-            auto const otherEndpointIndex = mSprings.GetOtherEndpointIndex(
-                springIndex,
-                pointIndex);
+            vec2f const & position = mPoints.GetPosition(pointIndex);
 
-            // Calculate quantity of water directed outwards
-            float const springOutboundQuantityOfWater =
-                springOutboundWaterFlowWeights[s]
-                * waterQuantityNormalizationFactor;
+            float const squareVelocity = (position - mSleepCheckPositions[pointIndex]).squareLength() / SquareStepTimeDuration;
 
-            assert(springOutboundQuantityOfWater >= 0.0f);
+            mSleepCheckPositions[pointIndex] = position;
+            mSleepCheckIsUnderwater[pointIndex] = position.y < cachedWaterSurfaceHeights[pointIndex];
 
-            if (mSprings.GetWaterPermeability(springIndex) != 0.0f)
-            {
-                //
-                // Water - and momentum - move from point to endpoint
-                //
+            sleepState.KineticEnergy += 0.5f * mPoints.GetMass(pointIndex) * squareVelocity;
+            sleepState.Mass += mPoints.GetMass(pointIndex);
+            sleepState.MaxSquareVelocity = std::max(sleepState.MaxSquareVelocity, squareVelocity);
+        }
+    }
 
-                // Move water quantity
-                newPointWaterBufferData[pointIndex] -= springOutboundQuantityOfWater;
-                newPointWaterBufferData[otherEndpointIndex] += springOutboundQuantityOfWater;
+    //
+    // Put to sleep the connected components that have been quiet for long enough
+    //
 
-                // Remove "old momentum" (old velocity) from point
-                newPointWaterMomentumBufferData[pointIndex] -=
-                    oldPointWaterVelocityBufferData[pointIndex]
-                    * springOutboundQuantityOfWater;
+    for (auto & sleepState : mConnectedComponentSleepStates)
+    {
+        if (!sleepState.IsAsleep)
+        {
+            bool const isQuiet =
+                !sleepState.IsTakingWater
+                && sleepState.MaxSquareVelocity < SleepMaxVelocity * SleepMaxVelocity
+                && sleepState.KineticEnergy <= SleepMaxSpecificKineticEnergy * sleepState.Mass;
 
-                // Add "new momentum" (old velocity + velocity gained) to other endpoint
-                newPointWaterMomentumBufferData[otherEndpointIndex] +=
-                    springOutboundWaterVelocities[s]
-                    * springOutboundQuantityOfWater;
+            if (isQuiet)
+            {
+                ++sleepState.QuietStepsCount;
+                if (sleepState.QuietStepsCount >= SleepQuietStepsCount)
+                {
+                    sleepState.IsAsleep = true;
+                    mAreAwakeElementsDirty = true;
+                }
+            }
+            else
+            {
+                sleepState.QuietStepsCount = 0;
+            }
 
+            sleepState.KineticEnergy = 0.0f;
+            sleepState.Mass = 0.0f;
+            sleepState.MaxSquareVelocity = 0.0f;
+            sleepState.IsTakingWater = false;
+        }
+    }
+}
 
-                //
-                // Update point's kinetic energy loss:
-                // splintered water colliding with whole other endpoint
-                //
+inline bool Ship::IsSubsystemUpdateStep(
+    int updatePeriod,
+    int updatePhase) const
+{
+    assert(updatePeriod >= 1);
 
-                // TODO: get rid of this re-calculation once we pre-calculate all spring normalized vectors
-                vec2f const springNormalizedVector = (mPoints.GetPosition(otherEndpointIndex) - mPoints.GetPosition(pointIndex)).normalise();
+    // Ships are offset by their ID, so that the same subsystem of different
+    // ships runs at different steps
+    return 0 == (mStepCount + static_cast<std::uint64_t>(mId) + static_cast<std::uint64_t>(updatePhase))
+        % static_cast<std::uint64_t>(updatePeriod);
+}
 
-                float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
-                float mb = oldPointWaterBufferData[otherEndpointIndex];
-                float vb = oldPointWaterVelocityBufferData[otherEndpointIndex].dot(springNormalizedVector);
+inline bool Ship::IsConnectedComponentAwake(ConnectedComponentId connectedComponentId) const
+{
+    assert(connectedComponentId > 0 && connectedComponentId <= mConnectedComponentSleepStates.size());
 
-                float vf = 0.0f;
-                if (ma + mb != 0.0f)
-                    vf = (ma * va + mb * vb) / (ma + mb);
+    return !mConnectedComponentSleepStates[connectedComponentId - 1].IsAsleep;
+}
 
-                float deltaKa =
-                    0.5f
-                    * ma
-                    * (va * va - vf * vf);
+void Ship::WakeUpConnectedComponent(ConnectedComponentId connectedComponentId)
+{
+    if (connectedComponentId > 0 && connectedComponentId <= mConnectedComponentSleepStates.size())
+    {
+        auto & sleepState = mConnectedComponentSleepStates[connectedComponentId - 1];
 
-                // Note: deltaKa might be negative, in which case deltaKb would have been
-                // more positive (perfectly inelastic -> deltaK == max); we will pickup
-                // deltaKb later
-                pointKineticEnergyLoss += std::max(deltaKa, 0.0f);
-            }
-            else
-            {
-                // Deleted springs are removed from points' connected springs
-                assert(!mSprings.IsDeleted(springIndex));
+        if (sleepState.IsAsleep)
+        {
+            sleepState.IsAsleep = false;
+            mAreAwakeElementsDirty = true;
+        }
 
-                //
-                // New momentum (old velocity + velocity gained) bounces back
-                // (and zeroes outgoing), assuming perfectly inelastic collision
-                //
-                // No changes to other endpoint
-                //
+        sleepState.QuietStepsCount = 0;
+    }
+}
 
-                newPointWaterMomentumBufferData[pointIndex] -=
-                    springOutboundWaterVelocities[s]
-                    * springOutboundQuantityOfWater;
+void Ship::WakeUpAllConnectedComponents()
+{
+    for (auto & sleepState : mConnectedComponentSleepStates)
+    {
+        if (sleepState.IsAsleep)
+        {
+            sleepState.IsAsleep = false;
+            mAreAwakeElementsDirty = true;
+        }
 
+        sleepState.QuietStepsCount = 0;
+    }
+}
 
-                //
-                // Update point's kinetic energy loss:
-                // entire splintered water
-                //
+void Ship::WakeUpConnectedComponentsTakingWater(GameParameters const & gameParameters)
+{
+    if (mSleepingLeakingPoints.empty())
+        return;
+
+    Algorithms::CalculateLeakingPointWaterInflows(
+        mSleepingLeakingPoints.data(),
+        static_cast<ElementCount>(mSleepingLeakingPoints.size()),
+        mPoints.GetPositionBufferAsVec2(),
+        mPoints.GetCachedWaterSurfaceHeightBufferAsFloat(),
+        mPoints.GetWaterBufferAsFloat(),
+        mCurrentWaterDynamicsSimulationStepTimeDuration,
+        gameParameters.WaterIntakeAdjustment,
+        GameParameters::GravityMagnitude,
+        mSleepingLeakingPointInflows.data(),
+        gameParameters.WaterMathQuality);
+
+    // The water is not taken here: once awake, the leak takes it like any other
+    for (size_t l = 0; l < mSleepingLeakingPoints.size(); ++l)
+    {
+        if (std::abs(mSleepingLeakingPointInflows[l]) > SleepMaxWaterInflow)
+        {
+            WakeUpConnectedComponent(mPoints.GetConnectedComponentId(mSleepingLeakingPoints[l]));
+        }
+    }
+}
 
-                float ma = springOutboundQuantityOfWater;
-                float va = springOutboundWaterVelocities[s].length();
+bool Ship::SleepGameParameters::Update(GameParameters const & gameParameters)
+{
+    bool const isChanged =
+        gameParameters.StiffnessAdjustment != StiffnessAdjustment
+        || gameParameters.StrengthAdjustment != StrengthAdjustment
+        || gameParameters.BuoyancyAdjustment != BuoyancyAdjustment
+        || gameParameters.WaterIntakeAdjustment != WaterIntakeAdjustment
+        || gameParameters.SeaDepth != SeaDepth
+        || gameParameters.UsePositionBasedMechanicalSolver != UsePositionBasedMechanicalSolver;
+
+    StiffnessAdjustment = gameParameters.StiffnessAdjustment;
+    StrengthAdjustment = gameParameters.StrengthAdjustment;
+    BuoyancyAdjustment = gameParameters.BuoyancyAdjustment;
+    WaterIntakeAdjustment = gameParameters.WaterIntakeAdjustment;
+    SeaDepth = gameParameters.SeaDepth;
+    UsePositionBasedMechanicalSolver = gameParameters.UsePositionBasedMechanicalSolver;
+
+    return isChanged;
+}
 
-                float deltaKa =
-                    0.5f
-                    * ma
-                    * va * va;
+void Ship::RebuildAwakeElements()
+{
+    mAwakePoints.clear();
+    mAwakePointRanges.clear();
+    mAwakeSpringRanges.clear();
+    mAwakeLeakingPoints.clear();
+    mSleepingPoints.clear();
+    mSleepingPointRanges.clear();
+    mSleepingLeakingPoints.clear();
+
+    for (auto pointIndex : mPoints.GetActiveElements())
+    {
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            if (IsConnectedComponentAwake(mPoints.GetConnectedComponentId(pointIndex)))
+            {
+                mAwakePoints.push_back(pointIndex);
 
-                assert(deltaKa >= 0.0f);
-                pointKineticEnergyLoss += deltaKa;
+                if (!mAwakePointRanges.empty() && mAwakePointRanges.back().End == pointIndex)
+                    ++(mAwakePointRanges.back().End);
+                else
+                    mAwakePointRanges.emplace_back(pointIndex, pointIndex + 1);
+            }
+            else
+            {
+                mSleepingPoints.push_back(pointIndex);
+
+                if (!mSleepingPointRanges.empty() && mSleepingPointRanges.back().End == pointIndex)
+                    ++(mSleepingPointRanges.back().End);
+                else
+                    mSleepingPointRanges.emplace_back(pointIndex, pointIndex + 1);
             }
         }
+    }
 
-        //
-        // 4) Update water splash
-        //
-        
-        if (pointSplashNeighbors != 0.0f)
+    for (auto springIndex : mSprings.GetActiveElements())
+    {
+        // Both endpoints of a spring belong to the same connected component
+        if (!mSprings.IsDeleted(springIndex)
+            && IsConnectedComponentAwake(mPoints.GetConnectedComponentId(mSprings.GetPointAIndex(springIndex))))
         {
-            // Water splashed is proportional to kinetic energy loss that took
-            // place near free points (i.e. not drowned by water)
-            waterSplashed +=
-                pointKineticEnergyLoss
-                * pointSplashFreeNeighbors
-                / pointSplashNeighbors;
+            if (!mAwakeSpringRanges.empty() && mAwakeSpringRanges.back().End == springIndex)
+                ++(mAwakeSpringRanges.back().End);
+            else
+                mAwakeSpringRanges.emplace_back(springIndex, springIndex + 1);
         }
     }
 
+    for (auto pointIndex : mPoints.GetLeakingPoints())
+    {
+        if (!mPoints.IsDeleted(pointIndex))
+        {
+            if (IsConnectedComponentAwake(mPoints.GetConnectedComponentId(pointIndex)))
+                mAwakeLeakingPoints.push_back(pointIndex);
+            else
+                mSleepingLeakingPoints.push_back(pointIndex);
+        }
+    }
 
+    mAwakeLeakingPointInflows.resize(mAwakeLeakingPoints.size());
+    mSleepingLeakingPointInflows.resize(mSleepingLeakingPoints.size());
 
-    //
-    // Average kinetic energy loss
-    //
+    // The parallel spring forces and the fused mechanical iterations have to follow
+    RebuildSpringForcesColorBatchesAwakeElements();
+    RebuildFusedMechanicalTilesAwakeElements();
 
-    waterSplashed = mWaterSplashedRunningAverage.Update(waterSplashed);
+    mAreAwakeElementsDirty = false;
 
+    // The wet front has to follow
+    mIsAwakeWetFrontDirty = true;
+}
 
+bool Ship::IsParallelSpringForcesWorthIt(
+    ElementCount springCount,
+    size_t parallelism)
+{
+    return parallelism >= 2
+        && springCount >= 2 * MinSpringsPerSpringForcesTask;
+}
 
-    //
-    // Move result values back to point, transforming momenta into velocities
-    //
+void Ship::MakeSpringForcesTasks()
+{
+    size_t const parallelism = mParentWorld.GetTaskThreadPool().GetParallelism();
 
-    mPoints.UpdateWaterBuffer(std::move(newPointWaterBuffer));
-    mPoints.UpdateWaterVelocitiesFromMomenta();
-}
+    mSpringForcesTasks.clear();
 
-///////////////////////////////////////////////////////////////////////////////////
-// Electrical Dynamics
-///////////////////////////////////////////////////////////////////////////////////
+    if (!IsParallelSpringForcesWorthIt(mSprings.GetElementCount(), parallelism)
+        || 0 == mSprings.GetColorBatchCount())
+    {
+        // We'll do it all on the calling thread
+        return;
+    }
 
-void Ship::UpdateElectricalDynamics(
-    VisitSequenceNumber currentVisitSequenceNumber,
-    GameParameters const & gameParameters)
-{
-    // Invoked regardless of dirty elements, as generators might become wet
-    UpdateElectricalConnectivity(currentVisitSequenceNumber);
+    //
+    // Copy the spring parameters that never change into color batch order
+    //
 
-    mElectricalElements.Update(
-        currentVisitSequenceNumber,
-        mPoints,
-        gameParameters);
+    auto & batches = mSpringForcesColorBatches;
 
-    DiffuseLight(gameParameters);
-}
+    batches.SpringIndices = mSprings.GetColorOrderedSpringIndices();
+
+    size_t const springCount = batches.SpringIndices.size();
+    batches.SpringEndpoints.resize(2 * springCount);
+    batches.SpringRestLengths.resize(springCount);
+    batches.SpringStiffnessCoefficients.resize(springCount);
+    batches.SpringDampingCoefficients.resize(springCount);
+
+    for (size_t s = 0; s < springCount; ++s)
+    {
+        batches.SpringEndpoints[2 * s] = mSprings.GetPointAIndex(batches.SpringIndices[s]);
+        batches.SpringEndpoints[2 * s + 1] = mSprings.GetPointBIndex(batches.SpringIndices[s]);
+        batches.SpringRestLengths[s] = mSprings.GetRestLength(batches.SpringIndices[s]);
+    }
 
-void Ship::UpdateElectricalConnectivity(VisitSequenceNumber currentVisitSequenceNumber)
-{
     //
-    // Visit electrical graph starting from (non-wet) generators, and propagate
-    // visit sequence number
+    // Make the tasks
     //
 
-    std::queue<ElementIndex> electricalElementsToVisit;
+    for (size_t b = 0; b < mSprings.GetColorBatchCount(); ++b)
+    {
+        ElementIndex const batchStart = mSprings.GetColorBatchStart(b);
+        ElementIndex const batchEnd = mSprings.GetColorBatchEnd(b);
+        ElementCount const batchSize = batchEnd - batchStart;
 
-    for (auto generatorIndex : mElectricalElements.GetGenerators())
-    {   
-        // Do not visit deleted generators
-        if (!mElectricalElements.IsDeleted(generatorIndex))
+        // The springs of the serial batch share endpoints, hence they all go to one task
+        size_t const taskCount = mSprings.IsColorBatchSerial(b)
+            ? size_t(1)
+            : std::max(
+                size_t(1),
+                std::min(parallelism, static_cast<size_t>(batchSize / MinSpringsPerSpringForcesTask)));
+
+        ElementCount const springsPerTask = batchSize / static_cast<ElementCount>(taskCount);
+
+        std::vector<TaskThreadPool::Task> colorBatchTasks;
+        for (size_t t = 0; t < taskCount; ++t)
         {
-            // Make sure we haven't visited it already
-            if (currentVisitSequenceNumber != mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(generatorIndex))
-            {
-                // Mark it as visited
-                mElectricalElements.SetConnectivityVisitSequenceNumber(
-                    generatorIndex,
-                    currentVisitSequenceNumber);
+            ElementIndex const taskStart = batchStart + static_cast<ElementIndex>(t) * springsPerTask;
+            ElementIndex const taskEnd = (t == taskCount - 1)
+                ? batchEnd
+                : taskStart + springsPerTask;
 
-                // Check if dry enough
-                if (mPoints.GetWater(mElectricalElements.GetPointIndex(generatorIndex)) < 0.3f)
+            colorBatchTasks.emplace_back(
+                [this, taskStart, taskEnd]()
                 {
-                    // Add generator to queue
-                    assert(electricalElementsToVisit.empty());
-                    electricalElementsToVisit.push(generatorIndex);
+                    UpdateColorBatchSpringForces(taskStart, taskEnd);
+                });
+        }
 
-                    // Visit all electrical elements reachable from this generator
-                    while (!electricalElementsToVisit.empty())
-                    {
-                        auto e = electricalElementsToVisit.front();
-                        electricalElementsToVisit.pop();
+        mSpringForcesTasks.push_back(std::move(colorBatchTasks));
+    }
+}
 
-                        assert(currentVisitSequenceNumber == mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(e));
+void Ship::RebuildSpringForcesColorBatchesAwakeElements()
+{
+    auto & batches = mSpringForcesColorBatches;
 
-                        for (auto reachableElectricalElementIndex : mElectricalElements.GetConnectedElectricalElements(e))
-                        {
-                            assert(!mElectricalElements.IsDeleted(reachableElectricalElementIndex));
+    batches.AwakeSpringRanges.clear();
 
-                            // Make sure not visited already
-                            if (currentVisitSequenceNumber != mElectricalElements.GetCurrentConnectivityVisitSequenceNumber(reachableElectricalElementIndex))
-                            {
-                                // Add to queue
-                                electricalElementsToVisit.push(reachableElectricalElementIndex);
+    for (ElementIndex s = 0; s < batches.SpringIndices.size(); ++s)
+    {
+        ElementIndex const springIndex = batches.SpringIndices[s];
 
-                                // Mark it as visited
-                                mElectricalElements.SetConnectivityVisitSequenceNumber(
-                                    reachableElectricalElementIndex,
-                                    currentVisitSequenceNumber);
-                            }
-                        }
-                    }
-                }
-            }
+        // Both endpoints of a spring belong to the same connected component
+        if (!mSprings.IsDeleted(springIndex)
+            && IsConnectedComponentAwake(mPoints.GetConnectedComponentId(mSprings.GetPointAIndex(springIndex))))
+        {
+            if (!batches.AwakeSpringRanges.empty() && batches.AwakeSpringRanges.back().End == s)
+                ++(batches.AwakeSpringRanges.back().End);
+            else
+                batches.AwakeSpringRanges.emplace_back(s, s + 1);
         }
     }
 }
 
-void Ship::DiffuseLight(GameParameters const & gameParameters)
+void Ship::MakeFusedMechanicalTiles()
 {
+    ElementCount const pointCount = mPoints.GetElementCount();
+    ElementCount const springCount = mSprings.GetElementCount();
+    size_t const tileCount = (pointCount + FusedMechanicalTileSize - 1) / FusedMechanicalTileSize;
+
     //
-    // Diffuse light from each lamp to the closest adjacent (i.e. spring-connected) points,
-    // inversely-proportional to the square of the distance
+    // Assign each spring to the tile of its highest endpoint, and each point
+    // to the last tile owning any of its springs.
+    //
+    // We do this for all springs, including those that might get deleted later,
+    // as a deleted spring has no effect and thus any order is still valid for it.
     //
 
-    // Greater adjustment => underrated distance => wider diffusion
-    float const adjustmentCoefficient = powf(1.0f - gameParameters.LightDiffusionAdjustment, 2.0f);
+    std::vector<size_t> springTiles(springCount);
+    std::vector<size_t> pointTiles(pointCount);
 
-    // Zero-out light at all points first
-    for (auto pointIndex : mPoints)
+    for (ElementIndex p = 0; p < pointCount; ++p)
     {
-        // Zero its light
-        mPoints.GetLight(pointIndex) = 0.0f;
+        pointTiles[p] = p / FusedMechanicalTileSize;
     }
 
-    // Go through all lamps;
-    // can safely visit deleted lamps as their current will always be zero
-    for (auto lampIndex : mElectricalElements.GetLamps())
+    for (ElementIndex s = 0; s < springCount; ++s)
     {
-        float const lampLight = mElectricalElements.GetAvailableCurrent(lampIndex);
-        auto const lampPointIndex = mElectricalElements.GetPointIndex(lampIndex);
-        vec2f const & lampPosition = mPoints.GetPosition(lampPointIndex);
-        ConnectedComponentId const lampConnectedComponentId = mPoints.GetConnectedComponentId(lampPointIndex);        
+        ElementIndex const pointAIndex = mSprings.GetPointAIndex(s);
+        ElementIndex const pointBIndex = mSprings.GetPointBIndex(s);
 
-        // Visit all points (including deleted ones) in the same connected component
-        for (auto pointIndex : mPoints)
-        {
-            if (mPoints.GetConnectedComponentId(pointIndex) == lampConnectedComponentId)
-            {
-                float squareDistance = std::max(
-                    1.0f,
-                    (mPoints.GetPosition(pointIndex) - lampPosition).squareLength() * adjustmentCoefficient);
+        size_t const tile = std::max(pointAIndex, pointBIndex) / FusedMechanicalTileSize;
 
-                assert(squareDistance >= 1.0f);
-
-                float newLight = lampLight / squareDistance;
-                if (newLight > mPoints.GetLight(pointIndex))
-                    mPoints.GetLight(pointIndex) = newLight;
-            }
-        }
+        springTiles[s] = tile;
+        pointTiles[pointAIndex] = std::max(pointTiles[pointAIndex], tile);
+        pointTiles[pointBIndex] = std::max(pointTiles[pointBIndex], tile);
     }
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////
-// Private helpers
-///////////////////////////////////////////////////////////////////////////////////////////////
 
-void Ship::DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNumber)
-{
-    mConnectedComponentSizes.clear();
+    //
+    // Counting-sort springs and points by tile, keeping their original relative order
+    // within each tile
+    //
 
-    ConnectedComponentId currentConnectedComponentId = 0;
-    std::queue<ElementIndex> pointsToVisitForConnectedComponents;
+    auto & tiles = mFusedMechanicalTiles;
 
-    // Visit all points
-    for (auto pointIndex : mPoints)
+    auto const sortByTile = [tileCount](
+        std::vector<size_t> const & elementTiles,
+        std::vector<ElementIndex> & sortedElementIndices,
+        std::vector<ElementIndex> & tileEnds)
     {
-        // Don't visit destroyed points, or we run the risk of creating a zillion connected components
-        if (!mPoints.IsDeleted(pointIndex))
+        tileEnds.assign(tileCount, 0);
+        for (size_t tile : elementTiles)
         {
-            // Check if visited
-            if (mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(pointIndex) != currentVisitSequenceNumber)
-            {
-                // This node has not been visited, hence it's the beginning of a new connected component
-                ++currentConnectedComponentId;
-                size_t pointsInCurrentConnectedComponent = 0;
+            ++tileEnds[tile];
+        }
 
-                //
-                // Propagate the connected component ID to all points reachable from this point
-                //
+        std::vector<ElementIndex> tileStarts(tileCount, 0);
+        ElementIndex end = 0;
+        for (size_t t = 0; t < tileCount; ++t)
+        {
+            tileStarts[t] = end;
+            end += tileEnds[t];
+            tileEnds[t] = end;
+        }
 
-                // Add point to queue
-                assert(pointsToVisitForConnectedComponents.empty());
-                pointsToVisitForConnectedComponents.push(pointIndex);
+        sortedElementIndices.resize(elementTiles.size());
+        for (size_t e = 0; e < elementTiles.size(); ++e)
+        {
+            sortedElementIndices[tileStarts[elementTiles[e]]++] = static_cast<ElementIndex>(e);
+        }
+    };
 
-                // Mark as visited
-                mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(
-                    pointIndex,
-                    currentVisitSequenceNumber);
+    sortByTile(springTiles, tiles.SpringIndices, tiles.SpringTileEnds);
+    sortByTile(pointTiles, tiles.PointIndices, tiles.PointTileEnds);
 
-                // Visit all points reachable from this point via springs
-                while (!pointsToVisitForConnectedComponents.empty())
-                {
-                    auto currentPointIndex = pointsToVisitForConnectedComponents.front();
-                    pointsToVisitForConnectedComponents.pop();
+    //
+    // Copy the spring parameters that never change
+    //
 
-                    assert(currentVisitSequenceNumber == mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(currentPointIndex));
+    tiles.SpringEndpoints.resize(2 * springCount);
+    tiles.SpringRestLengths.resize(springCount);
+    tiles.SpringStiffnessCoefficients.resize(springCount);
+    tiles.SpringDampingCoefficients.resize(springCount);
 
-                    // Assign the connected component ID
-                    mPoints.SetConnectedComponentId(currentPointIndex, currentConnectedComponentId);
-                    ++pointsInCurrentConnectedComponent;
+    for (size_t s = 0; s < springCount; ++s)
+    {
+        tiles.SpringEndpoints[2 * s] = mSprings.GetPointAIndex(tiles.SpringIndices[s]);
+        tiles.SpringEndpoints[2 * s + 1] = mSprings.GetPointBIndex(tiles.SpringIndices[s]);
+        tiles.SpringRestLengths[s] = mSprings.GetRestLength(tiles.SpringIndices[s]);
+    }
+}
 
-                    // Go through this point's adjacents
-                    for (auto adjacentSpringElementIndex : mPoints.GetConnectedSprings(currentPointIndex))
-                    {
-                        assert(!mSprings.IsDeleted(adjacentSpringElementIndex));
+void Ship::RebuildFusedMechanicalTilesAwakeElements()
+{
+    auto & tiles = mFusedMechanicalTiles;
 
-                        auto pointAIndex = mSprings.GetPointAIndex(adjacentSpringElementIndex);
-                        assert(!mPoints.IsDeleted(pointAIndex));
-                        if (currentVisitSequenceNumber != mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(pointAIndex))
-                        {
-                            mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(pointAIndex, currentVisitSequenceNumber);
-                            pointsToVisitForConnectedComponents.push(pointAIndex);
-                        }
+    tiles.AwakeSpringRanges.clear();
+    tiles.AwakeSpringRangeTileEnds.clear();
+    tiles.AwakePointIndices.clear();
+    tiles.AwakePointTileEnds.clear();
 
-                        auto pointBIndex = mSprings.GetPointBIndex(adjacentSpringElementIndex);
-                        assert(!mPoints.IsDeleted(pointBIndex));
-                        if (currentVisitSequenceNumber != mPoints.GetCurrentConnectedComponentDetectionVisitSequenceNumber(pointBIndex))
-                        {
-                            mPoints.SetCurrentConnectedComponentDetectionVisitSequenceNumber(pointBIndex, currentVisitSequenceNumber);
-                            pointsToVisitForConnectedComponents.push(pointBIndex);
-                        }
-                    }
-                }
+    ElementIndex s = 0;
+    ElementIndex p = 0;
+    for (size_t t = 0; t < tiles.SpringTileEnds.size(); ++t)
+    {
+        // Ranges never span tiles, as each tile runs its springs in one go
+        size_t const tileRangesStart = tiles.AwakeSpringRanges.size();
 
-                // Store number of connected components
-                mConnectedComponentSizes.push_back(pointsInCurrentConnectedComponent);
+        for (; s < tiles.SpringTileEnds[t]; ++s)
+        {
+            ElementIndex const springIndex = tiles.SpringIndices[s];
+
+            // Both endpoints of a spring belong to the same connected component
+            if (!mSprings.IsDeleted(springIndex)
+                && IsConnectedComponentAwake(mPoints.GetConnectedComponentId(mSprings.GetPointAIndex(springIndex))))
+            {
+                if (tiles.AwakeSpringRanges.size() > tileRangesStart && tiles.AwakeSpringRanges.back().End == s)
+                    ++(tiles.AwakeSpringRanges.back().End);
+                else
+                    tiles.AwakeSpringRanges.emplace_back(s, s + 1);
+            }
+        }
+
+        tiles.AwakeSpringRangeTileEnds.push_back(tiles.AwakeSpringRanges.size());
+
+        for (; p < tiles.PointTileEnds[t]; ++p)
+        {
+            ElementIndex const pointIndex = tiles.PointIndices[p];
+
+            if (!mPoints.IsDeleted(pointIndex)
+                && IsConnectedComponentAwake(mPoints.GetConnectedComponentId(pointIndex)))
+            {
+                tiles.AwakePointIndices.push_back(pointIndex);
             }
         }
+
+        tiles.AwakePointTileEnds.push_back(static_cast<ElementIndex>(tiles.AwakePointIndices.size()));
     }
 }
 
@@ -1277,15 +3752,194 @@ void Ship::DestroyConnectedTriangles(
     }
 }
 
+void Ship::DestroyPoints(std::vector<ElementIndex> const & pointIndices)
+{
+    //
+    // Destroy the points together with their springs, triangles, and electrical elements,
+    // like destroying them one by one would; the network is cleaned up, bombs and pinned
+    // points are notified, and events are fired once for the whole batch
+    //
+
+    if (pointIndices.empty())
+        return;
+
+    mBatchDestroyedSprings.clear();
+    mBatchDestroyedTriangles.clear();
+
+    auto const markTrianglesDestroyed = [this](ElementIndex pointIndex)
+    {
+        for (auto triangleIndex : mPoints.GetConnectedTriangles(pointIndex))
+        {
+            if (!mTriangles.IsDeleted(triangleIndex))
+            {
+                mTriangles.MarkDestroyed(triangleIndex);
+                mBatchDestroyedTriangles.push_back(triangleIndex);
+            }
+        }
+    };
+
+    //
+    // Flag the springs and triangles as deleted - the springs' triangles include the triangles
+    // of their other endpoints - and disconnect their electrical elements
+    //
+
+    for (auto pointIndex : pointIndices)
+    {
+        assert(!mPoints.IsDeleted(pointIndex));
+
+        for (auto springIndex : mPoints.GetConnectedSprings(pointIndex))
+        {
+            auto const neighborIndex = (mSprings.GetPointAIndex(springIndex) == pointIndex)
+                ? mSprings.GetPointBIndex(springIndex)
+                : mSprings.GetPointAIndex(springIndex);
+
+            // Remember that this point's neighbors might get disconnected from each other
+            mConnectedComponentSplitCandidates.push_back(neighborIndex);
+
+            // Springs among two points of the batch are visited twice
+            if (!mSprings.IsDeleted(springIndex))
+            {
+                mSprings.MarkDestroyed(springIndex);
+                mBatchDestroyedSprings.push_back(springIndex);
+
+                markTrianglesDestroyed(neighborIndex);
+
+                auto const electricalElementIndex = mPoints.GetElectricalElement(pointIndex);
+                auto const neighborElectricalElementIndex = mPoints.GetElectricalElement(neighborIndex);
+                if (NoneElementIndex != electricalElementIndex
+                    && NoneElementIndex != neighborElectricalElementIndex)
+                {
+                    mElectricalElements.RemoveConnectedElectricalElement(
+                        electricalElementIndex,
+                        neighborElectricalElementIndex);
+
+                    mElectricalElements.RemoveConnectedElectricalElement(
+                        neighborElectricalElementIndex,
+                        electricalElementIndex);
+
+                    // What is powered might have changed
+                    mIsElectricalConnectivityDirty = true;
+                }
+            }
+        }
+
+        markTrianglesDestroyed(pointIndex);
+    }
+
+    //
+    // Notify bombs, while the points are still where they were
+    //
+
+    mBombs.OnElementsDestroyed(pointIndices, mBatchDestroyedSprings);
+
+    //
+    // Fire point destroy events, one per material and being underwater
+    //
+
+    mBatchDestroyEvents.clear();
+    for (auto pointIndex : pointIndices)
+    {
+        Material const * const material = mPoints.GetMaterial(pointIndex);
+        bool const isUnderwater = mParentWorld.IsUnderwater(mPoints.GetPosition(pointIndex));
+
+        auto it = std::find_if(
+            mBatchDestroyEvents.begin(),
+            mBatchDestroyEvents.end(),
+            [material, isUnderwater](BatchDestroyEvent const & destroyEvent)
+            {
+                return destroyEvent.PointMaterial == material && destroyEvent.IsUnderwater == isUnderwater;
+            });
+
+        if (it != mBatchDestroyEvents.end())
+            ++(it->Size);
+        else
+            mBatchDestroyEvents.push_back({ material, isUnderwater, 1u });
+    }
+
+    for (auto const & destroyEvent : mBatchDestroyEvents)
+    {
+        mGameEventHandler->OnDestroy(
+            destroyEvent.PointMaterial,
+            destroyEvent.IsUnderwater,
+            destroyEvent.Size);
+    }
+
+    //
+    // Remove the springs and triangles from their endpoints
+    //
+
+    for (auto springIndex : mBatchDestroyedSprings)
+    {
+        auto const pointAIndex = mSprings.GetPointAIndex(springIndex);
+        auto const pointBIndex = mSprings.GetPointBIndex(springIndex);
+
+        mPoints.RemoveConnectedSpring(pointAIndex, springIndex);
+        mPoints.RemoveConnectedSpring(pointBIndex, springIndex);
+
+        // Make non-hull endpoints leak
+        if (!mPoints.IsHull(pointAIndex))
+            mPoints.SetLeaking(pointAIndex);
+        if (!mPoints.IsHull(pointBIndex))
+            mPoints.SetLeaking(pointBIndex);
+    }
+
+    for (auto triangleIndex : mBatchDestroyedTriangles)
+    {
+        mPoints.RemoveConnectedTriangle(mTriangles.GetPointAIndex(triangleIndex), triangleIndex);
+        mPoints.RemoveConnectedTriangle(mTriangles.GetPointBIndex(triangleIndex), triangleIndex);
+        mPoints.RemoveConnectedTriangle(mTriangles.GetPointCIndex(triangleIndex), triangleIndex);
+    }
+
+    // Notify pinned points, now that the points have lost their springs
+    mPinnedPoints.OnElementsDestroyed(pointIndices, mBatchDestroyedSprings);
+
+    //
+    // Destroy the electrical elements - which are now disconnected - and the points
+    //
+
+    for (auto pointIndex : pointIndices)
+    {
+        assert(mPoints.GetConnectedSprings(pointIndex).empty());
+        assert(mPoints.GetConnectedTriangles(pointIndex).empty());
+
+        if (NoneElementIndex != mPoints.GetElectricalElement(pointIndex))
+        {
+            assert(!mElectricalElements.IsDeleted(mPoints.GetElectricalElement(pointIndex)));
+
+            mElectricalElements.Destroy(mPoints.GetElectricalElement(pointIndex));
+        }
+
+        mPoints.MarkDestroyed(pointIndex);
+    }
+
+    // Remember our elements are now dirty
+    mAreElementsDirty = true;
+}
+
 void Ship::PointDestroyHandler(ElementIndex pointElementIndex)
 {
+    //
+    // Remember that this point's neighbors might get disconnected from each other
+    //
+
+    auto & connectedSprings = mPoints.GetConnectedSprings(pointElementIndex);
+
+    for (auto springIndex : connectedSprings)
+    {
+        auto const neighborIndex = (mSprings.GetPointAIndex(springIndex) == pointElementIndex)
+            ? mSprings.GetPointBIndex(springIndex)
+            : mSprings.GetPointAIndex(springIndex);
+
+        mConnectedComponentSplitCandidates.push_back(neighborIndex);
+    }
+
+
     //
     // Destroy all springs attached to this point
     //
 
     // Note: we can't simply iterate and destroy, as destroying a spring causes
     // that spring to be removed from the vector being iterated
-    auto & connectedSprings = mPoints.GetConnectedSprings(pointElementIndex);
     while (!connectedSprings.empty())
     {
         assert(!mSprings.IsDeleted(connectedSprings.back()));
@@ -1373,6 +4027,10 @@ void Ship::SpringDestroyHandler(
     mPoints.RemoveConnectedSpring(pointAIndex, springElementIndex);
     mPoints.RemoveConnectedSpring(pointBIndex, springElementIndex);
 
+    // Remember that the endpoints might get disconnected from each other
+    mConnectedComponentSplitCandidates.push_back(pointAIndex);
+    mConnectedComponentSplitCandidates.push_back(pointBIndex);
+
 
     //
     // Make non-hull endpoints leak
@@ -1403,6 +4061,9 @@ void Ship::SpringDestroyHandler(
             mElectricalElements.RemoveConnectedElectricalElement(
                 electricalElementBIndex,
                 electricalElementAIndex);
+
+            // What is powered might have changed
+            mIsElectricalConnectivityDirty = true;
         }
     }
 
@@ -1431,6 +4092,9 @@ void Ship::ElectricalElementDestroyHandler(ElementIndex /*electricalElementIndex
 {
     // Remember our elements are now dirty
     mAreElementsDirty = true;
+
+    // What is powered might have changed
+    mIsElectricalConnectivityDirty = true;
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -1457,8 +4121,14 @@ void Ship::DoBombExplosion(
     float closestPointSquareDistance = std::numeric_limits<float>::max();
     ElementIndex closestPointIndex = NoneElementIndex;
 
-    for (auto pointIndex : mPoints)
+    WakeUpConnectedComponent(connectedComponentId);
+
+    // Visit the points of the connected component only
+    assert(connectedComponentId > 0 && connectedComponentId < mConnectedComponentPointOffsets.size());
+    for (ElementIndex cp = mConnectedComponentPointOffsets[connectedComponentId - 1]; cp < mConnectedComponentPointOffsets[connectedComponentId]; ++cp)
     {
+        auto const pointIndex = mConnectedComponentPoints[cp];
+
         if (!mPoints.IsDeleted(pointIndex)
             && mPoints.GetConnectedComponentId(pointIndex) == connectedComponentId)
         {
@@ -1476,7 +4146,7 @@ void Ship::DoBombExplosion(
                 // Flip the point
                 vec2f flippedRadius = pointRadius.normalise() * (blastRadius + (blastRadius - pointRadius.length()));
                 vec2f newPosition = blastPosition + flippedRadius;
-                mPoints.GetVelocity(pointIndex) = (newPosition - mPoints.GetPosition(pointIndex)) / GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;
+                mPoints.GetVelocity(pointIndex) = (newPosition - mPoints.GetPosition(pointIndex)) / mPoints.GetCurrentMechanicalDynamicsSimulationStepTimeDuration();
                 mPoints.GetPosition(pointIndex) = newPosition;
             }
         }
@@ -1501,7 +4171,7 @@ void Ship::DoAntiMatterBombPreimplosion(
 {
     // Store the force field
     mCurrentForceFields.emplace_back(
-        new RadialSpaceWarpForceField(
+        RadialSpaceWarpForceField(
             centerPosition,
             7.0f + sequenceProgress * 100.0f,
             10.0f,
@@ -1517,7 +4187,7 @@ void Ship::DoAntiMatterBombImplosion(
 {
     // Store the force field
     mCurrentForceFields.emplace_back(
-        new ImplosionForceField(
+        ImplosionForceField(
             centerPosition,
             (sequenceProgress * sequenceProgress) * 30000.0f));
 
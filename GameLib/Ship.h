@@ -5,6 +5,7 @@
  ***************************************************************************************/
 #pragma once
 
+#include "AABB.h"
 #include "GameParameters.h"
 #include "GameTypes.h"
 #include "MaterialDatabase.h"
@@ -12,8 +13,10 @@
 #include "RenderContext.h"
 #include "RunningAverage.h"
 #include "ShipDefinition.h"
+#include "TaskThreadPool.h"
 #include "Vectors.h"
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -92,6 +95,15 @@ public:
 
     void DetonateAntiMatterBombs();
 
+    /*
+     * Whether the forces of this many springs are accumulated in parallel, over batches
+     * of springs that share no endpoints; only then springs need to be grouped into
+     * such batches.
+     */
+    static bool IsParallelSpringForcesWorthIt(
+        ElementCount springCount,
+        size_t parallelism);
+
     ElementIndex GetNearestPointIndexAt(
         vec2f const & targetPos,
         float radius) const;
@@ -112,16 +124,46 @@ public:
 
     // Mechanical
 
+    void UpdateMechanicalIterationsCount(GameParameters const & gameParameters);
+
     void UpdateMechanicalDynamics(GameParameters const & gameParameters);
 
+    void UpdateMechanicalDynamicsFused(GameParameters const & gameParameters);
+
+    void UpdateMechanicalDynamicsPositionBased(GameParameters const & gameParameters);
+
+    void CullForceFields();
+
+    void ApplyForceFields();
+
     void UpdatePointForces(GameParameters const & gameParameters);
 
-    void UpdateSpringForces(GameParameters const & gameParameters);    
+    inline void UpdatePointForces(
+        ElementIndex pointIndex,
+        float buoyancyAdjustedWaterMass);
+
+    void UpdateSpringForces(GameParameters const & gameParameters);
+
+    void UpdateSpringForces(
+        ElementIndex startSpringIndex,
+        ElementIndex endSpringIndex);
+
+    void UpdateColorBatchSpringForces(
+        ElementIndex startSlot,
+        ElementIndex endSlot);
 
     void IntegrateAndResetPointForces();
 
+    inline void IntegrateAndResetPointForces(ElementIndex pointIndex);
+
     void HandleCollisionsWithSeaFloor();
 
+    void DetectSeaFloorCollisionCandidates();
+
+    inline void HandleCollisionsWithSeaFloor(
+        ElementIndex pointIndex,
+        float floorheight);
+
     // Water
 
     void UpdateWaterDynamics(GameParameters const & gameParameters);
@@ -134,6 +176,45 @@ public:
         GameParameters const & gameParameters,
         float & waterSplashed);
 
+    void UpdateWaterVelocitiesEdgeCentric(
+        GameParameters const & gameParameters,
+        float & waterSplashed);
+
+    void UpdateWaterVelocitiesParallel(
+        GameParameters const & gameParameters,
+        float & waterSplashed);
+
+    void ResetWetFront();
+
+    void ExpandWetFront(ElementIndex pointIndex);
+
+    void AddToWetFront(ElementIndex pointIndex);
+
+    void RebuildAwakeWetFront();
+
+    static void MergeUnsortedTail(
+        std::vector<ElementIndex> & elements,
+        size_t sortedCount,
+        std::vector<ElementIndex> & mergeBuffer);
+
+    bool IsParallelWaterFlowUsed(GameParameters const & gameParameters) const;
+
+    template<typename TPass>
+    void RunWaterFlowPass(
+        std::vector<TaskThreadPool::Task> const & tasks,
+        TPass const & pass);
+
+    static inline float CalculateWaterKineticEnergyLoss(
+        float ma,
+        float va,
+        float mb,
+        float vb,
+        float waterPermeability);
+
+    static inline float CalculateWaterFreenessFactor(
+        float water,
+        MathQuality mathQuality);
+
     // Electrical 
 
     void UpdateElectricalDynamics(
@@ -148,12 +229,50 @@ private:
 
     void DetectConnectedComponents(VisitSequenceNumber currentVisitSequenceNumber);
 
+    void UpdateConnectedComponents();
+
+    bool SplitConnectedComponent(
+        ElementIndex pointAIndex,
+        ElementIndex pointBIndex);
+
+    inline bool ExpandConnectedComponentSearch(
+        std::vector<ElementIndex> & searchPoints,
+        size_t & searchHead,
+        std::uint32_t searchMark,
+        std::uint32_t otherSearchMark);
+
+    inline bool IsSubsystemUpdateStep(
+        int updatePeriod,
+        int updatePhase) const;
+
+    void UpdateConnectedComponentSleepStates(GameParameters const & gameParameters);
+
+    inline bool IsConnectedComponentAwake(ConnectedComponentId connectedComponentId) const;
+
+    void WakeUpConnectedComponent(ConnectedComponentId connectedComponentId);
+
+    void WakeUpAllConnectedComponents();
+
+    void WakeUpConnectedComponentsTakingWater(GameParameters const & gameParameters);
+
+    void RebuildAwakeElements();
+
+    void MakeSpringForcesTasks();
+
+    void RebuildSpringForcesColorBatchesAwakeElements();
+
+    void MakeFusedMechanicalTiles();
+
+    void RebuildFusedMechanicalTilesAwakeElements();
+
     void DestroyConnectedTriangles(ElementIndex pointElementIndex);
 
     void DestroyConnectedTriangles(
         ElementIndex pointAElementIndex,
         ElementIndex pointBElementIndex);
 
+    void DestroyPoints(std::vector<ElementIndex> const & pointIndices);
+
     void PointDestroyHandler(ElementIndex pointElementIndex);
 
     void SpringDestroyHandler(
@@ -191,6 +310,58 @@ private:
         float sequenceProgress,
         GameParameters const & gameParameters) override;
 
+private:
+
+    // Water mass = 1000Kg
+    static constexpr float WaterMass = 1000.0f;
+
+    // Global damp - lowers velocity uniformly, damping oscillations originating between gravity and buoyancy
+    // Note: it's extremely sensitive, big difference between 0.9995 and 0.9998
+    // Note: technically it's not a drag force, it's just a dimensionless deceleration
+    static constexpr float GlobalDampCoefficient = 0.9996f;
+
+    // A connected component falls asleep once it has been quiet for this many consecutive steps;
+    // it's quiet when no point is faster than the max velocity, its kinetic energy per unit of mass
+    // is below the max, and none of its points is taking water in
+    static constexpr unsigned int SleepQuietStepsCount = 100; // 2 seconds
+    static constexpr float SleepMaxVelocity = 0.1f;
+    static constexpr float SleepMaxSpecificKineticEnergy = 0.00125f; // RMS velocity of 0.05m/s
+    static constexpr float SleepMaxWaterInflow = 0.0001f;
+
+    // Points are culled against force fields once per step, hence give or take
+    // the distance they may travel during the step; force fields fade out at their
+    // boundaries, so points that get there in the middle of a step lose little
+    static constexpr float ForceFieldCullingMargin = 1.0f;
+
+    // Generators only work with less water than this
+    static constexpr float GeneratorMaxWater = 0.3f;
+
+    // Light below this is invisible, hence lamps don't diffuse light to points
+    // farther than the distance at which their light falls below it
+    static constexpr float LightVisibilityEpsilon = 0.01f;
+
+    // The max number of cells along each side of the light diffusion grid; caps
+    // the size of the grid when parts of the ship end up far apart
+    static constexpr size_t MaxLightDiffusionGridCellsPerSide = 256;
+
+    // The number of points in a tile of the fused mechanical iterations; chosen so that
+    // the points of a tile and their springs fit comfortably in L2
+    static constexpr ElementCount FusedMechanicalTileSize = 512;
+
+    // Below this number of springs a spring forces task costs more in synchronization
+    // than it saves
+    static constexpr ElementCount MinSpringsPerSpringForcesTask = 2048;
+
+    // The number of awake points visited by each task of the parallel water flow; fixed,
+    // so that the water splashed - summed up by chunk - does not depend on the number
+    // of threads
+    static constexpr size_t WaterFlowChunkSize = 1024;
+
+    // The offsets of the steps at which the subsystems that don't run at every step
+    // run; with even periods, water and electrical dynamics never share a step
+    static constexpr int WaterDynamicsUpdatePhase = 0;
+    static constexpr int ElectricalDynamicsUpdatePhase = 1;
+
 private:
 
     unsigned int const mId;
@@ -206,6 +377,134 @@ private:
     // Connected components metadata
     std::vector<std::size_t> mConnectedComponentSizes;
 
+    // The non-deleted points of each connected component at the time of its detection,
+    // in CSR form: the points of connected component c are at
+    // [mConnectedComponentPointOffsets[c - 1], mConnectedComponentPointOffsets[c])
+    // in mConnectedComponentPoints; points might have been deleted or moved to
+    // a split-off connected component since then
+    std::vector<ElementIndex> mConnectedComponentPointOffsets;
+    std::vector<ElementIndex> mConnectedComponentPoints;
+
+    // The points that might have been disconnected from each other during the current
+    // step, i.e. the endpoints of destroyed springs and the neighbors of destroyed points;
+    // connected components are only split where the survivors among these points are no
+    // longer connected to each other
+    std::vector<ElementIndex> mConnectedComponentSplitCandidates;
+
+    // The split candidates known to be in distinct parts of the connected components,
+    // while checking the split candidates
+    std::vector<ElementIndex> mConnectedComponentSplitRepresentatives;
+
+    // The state of the bidirectional searches that decide whether a connected component
+    // has split: the points visited by either side, and the mark of the search
+    // that last visited each point
+    std::vector<ElementIndex> mConnectedComponentSearchPointsA;
+    std::vector<ElementIndex> mConnectedComponentSearchPointsB;
+    std::vector<std::uint32_t> mConnectedComponentSearchMarks;
+    std::uint32_t mCurrentConnectedComponentSearchMark;
+
+    // The elements destroyed by the current batch destruction
+    std::vector<ElementIndex> mBatchDestroyedPoints;
+    std::vector<ElementIndex> mBatchDestroyedSprings;
+    std::vector<ElementIndex> mBatchDestroyedTriangles;
+
+    // The destroy events fired by the current batch destruction, one per point
+    // material and being underwater
+    struct BatchDestroyEvent
+    {
+        Material const * PointMaterial;
+        bool IsUnderwater;
+        unsigned int Size;
+    };
+
+    std::vector<BatchDestroyEvent> mBatchDestroyEvents;
+
+    /*
+     * The sleep tracking state of a connected component.
+     *
+     * Sleeping connected components are skipped by mechanical and water dynamics.
+     */
+    struct ConnectedComponentSleepState
+    {
+        bool IsAsleep;
+        unsigned int QuietStepsCount;
+
+        // Accumulated during each step
+        float KineticEnergy;
+        float Mass;
+        float MaxSquareVelocity;
+        bool IsTakingWater;
+
+        ConnectedComponentSleepState()
+            : IsAsleep(false)
+            , QuietStepsCount(0)
+            , KineticEnergy(0.0f)
+            , Mass(0.0f)
+            , MaxSquareVelocity(0.0f)
+            , IsTakingWater(false)
+        {}
+    };
+
+    // Indexed by connected component ID - 1
+    std::vector<ConnectedComponentSleepState> mConnectedComponentSleepStates;
+
+    // The position of each point as of the last sleep check; the velocity of a point
+    // over a whole step is measured from its displacement since then, as the integrated
+    // velocity is kept inflated by the sea floor collisions of a body at rest on the floor
+    std::vector<vec2f> mSleepCheckPositions;
+
+    // Whether each point was underwater as of the last sleep check; a sleeping connected
+    // component wakes up when any of its points crosses the water surface
+    std::vector<bool> mSleepCheckIsUnderwater;
+
+    /*
+     * The game parameters that the equilibrium of a connected component at rest depends on;
+     * a change in any of these wakes up all connected components.
+     */
+    struct SleepGameParameters
+    {
+        float StiffnessAdjustment;
+        float StrengthAdjustment;
+        float BuoyancyAdjustment;
+        float WaterIntakeAdjustment;
+        float SeaDepth;
+        bool UsePositionBasedMechanicalSolver;
+
+        SleepGameParameters()
+            : StiffnessAdjustment(0.0f)
+            , StrengthAdjustment(0.0f)
+            , BuoyancyAdjustment(0.0f)
+            , WaterIntakeAdjustment(0.0f)
+            , SeaDepth(0.0f)
+            , UsePositionBasedMechanicalSolver(false)
+        {}
+
+        bool Update(GameParameters const & gameParameters);
+    };
+
+    SleepGameParameters mSleepGameParameters;
+
+    // The non-deleted points and the ranges of non-deleted springs belonging to
+    // awake connected components; rebuilt whenever a connected component falls asleep
+    // or wakes up
+    std::vector<ElementIndex> mAwakePoints;
+    std::vector<ElementContainer::ElementRange> mAwakePointRanges;
+    std::vector<ElementContainer::ElementRange> mAwakeSpringRanges;
+    bool mAreAwakeElementsDirty;
+
+    // The awake, non-deleted leaking points, rebuilt together with the awake elements,
+    // and the water they take in at each water iteration
+    std::vector<ElementIndex> mAwakeLeakingPoints;
+    std::vector<float> mAwakeLeakingPointInflows;
+
+    // The complement of the above, i.e. the non-deleted points and leaking points
+    // belonging to sleeping connected components; these are watched for the changes
+    // that should wake up their connected components
+    std::vector<ElementIndex> mSleepingPoints;
+    std::vector<ElementContainer::ElementRange> mSleepingPointRanges;
+    std::vector<ElementIndex> mSleepingLeakingPoints;
+    std::vector<float> mSleepingLeakingPointInflows;
+
     // Flag remembering whether points (elements) and/or springs (incl. ropes) and/or triangles have changed
     // since the last step.
     // When this flag is set, we'll re-detect connected components and re-upload elements
@@ -219,6 +518,44 @@ private:
     float mTotalWater;
     RunningAverage<30> mWaterSplashedRunningAverage;
 
+    // The dt and the quickness of the current water dynamics update, which
+    // stands for as many steps as the water dynamics update period
+    float mCurrentWaterDynamicsSimulationStepTimeDuration;
+    float mCurrentWaterQuickness;
+
+    // The number of steps run so far, which paces the subsystems that don't
+    // run at every step
+    std::uint64_t mStepCount;
+
+    // The electrical graph is only visited when what is powered might have changed,
+    // i.e. when electrical elements or their connections get destroyed, or when
+    // generators get wet or dry; powered elements are those carrying the visit
+    // sequence number of the last visit
+    bool mIsElectricalConnectivityDirty;
+    VisitSequenceNumber mElectricalConnectivityVisitSequenceNumber;
+
+    // Indexed like the generators
+    std::vector<bool> mAreGeneratorsDry;
+
+    // The queue of the electrical connectivity visit
+    std::vector<ElementIndex> mElectricalElementsToVisit;
+
+    // Light is only diffused again when what it depends on might have changed, i.e.
+    // when lamp currents, connected components, or the diffusion adjustment change;
+    // lamp currents are indexed like the lamps
+    bool mIsLightDirty;
+    std::vector<float> mLampLights;
+    float mLightDiffusionAdjustment;
+
+    // The uniform grid of non-deleted points used to diffuse light, in CSR form:
+    // the points of cell c are at [mLightDiffusionGridCellStarts[c], mLightDiffusionGridCellStarts[c + 1])
+    // in mLightDiffusionGridPoints; cells are row-major
+    std::vector<ElementIndex> mLightDiffusionGridPoints;
+    std::vector<ElementIndex> mLightDiffusionGridCellStarts;
+
+    // Indexed by connected component ID - 1
+    std::vector<float> mConnectedComponentLights;
+
     // Pinned points
     PinnedPoints mPinnedPoints;
 
@@ -226,7 +563,154 @@ private:
     Bombs mBombs;
 
     // Force fields to apply at next iteration
-    std::vector<std::unique_ptr<ForceField>> mCurrentForceFields;
+    std::vector<ForceField> mCurrentForceFields;
+
+    // The runs of awake points that each of the current force fields may reach during
+    // the current step, in CSR form: the runs of force field f are at
+    // [mForceFieldPointRangeOffsets[f], mForceFieldPointRangeOffsets[f + 1])
+    std::vector<ElementContainer::ElementRange> mForceFieldPointRanges;
+    std::vector<size_t> mForceFieldPointRangeOffsets;
+
+    // The number of mechanical iterations we currently run at each step, and 
+    // the global damp coefficient for each of those iterations
+    int mMechanicalIterationsCount;
+    unsigned int mStepsSinceMechanicalIterationsCountChange;
+    float mCurrentGlobalDampCoefficient;
+
+    // The work buffers of the position-based solver: the positions of points at the 
+    // start of the current substep, and the Lagrange multipliers of springs
+    std::vector<vec2f> mPositionBasedPreviousPositions;
+    std::vector<float> mPositionBasedSpringLambdas;
+
+    /*
+     * The layout for accumulating spring forces in parallel.
+     *
+     * The springs keep the order that suits rendering, while the solver visits them
+     * by color batch; each batch is a run of consecutive slots, hence the springs'
+     * physical parameters are copied in this order.
+     */
+    struct SpringForcesColorBatches
+    {
+        // The springs, sorted by color batch, and their physical parameters; the coefficients
+        // are gathered from the springs at each step, as they might change at any time
+        std::vector<ElementIndex> SpringIndices;
+        std::vector<ElementIndex> SpringEndpoints;
+        std::vector<float> SpringRestLengths;
+        std::vector<float> SpringStiffnessCoefficients;
+        std::vector<float> SpringDampingCoefficients;
+
+        // The ranges of the awake, non-deleted springs in the order above; rebuilt together
+        // with the awake elements
+        std::vector<ElementContainer::ElementRange> AwakeSpringRanges;
+    };
+
+    SpringForcesColorBatches mSpringForcesColorBatches;
+
+    // The tasks for accumulating spring forces in parallel, one set of tasks
+    // for each color batch of springs; empty when we run on the calling thread only
+    std::vector<std::vector<TaskThreadPool::Task>> mSpringForcesTasks;
+
+    /*
+     * The wet front, i.e. the points that water dynamics visit: the points that have water,
+     * and their neighbors - the only points water may flow into. All other points have no
+     * water and would not get any, hence visiting them would be a waste.
+     *
+     * The wet front only grows, as points get water - from leaks or from their neighbors -
+     * and it is rebuilt from scratch whenever elements are deleted.
+     */
+    enum class WetFrontState : std::uint8_t
+    {
+        Dry,    // Not in the wet front
+        Front,  // In the wet front, but had no water when last checked; its neighbors might not be
+        Wet     // In the wet front, and so are all of its neighbors
+    };
+
+    // Indexed by point index
+    std::vector<WetFrontState> mPointWetFrontStates;
+
+    std::vector<ElementIndex> mWetFrontPoints;
+
+    // The springs whose endpoints are both in the wet front; springs towards dry
+    // points would not move any water
+    std::vector<ElementIndex> mWetFrontSprings;
+
+    // The wet front is kept sorted up to these counts; what joined it after the
+    // last rebuild is sorted and merged in at the next one
+    size_t mSortedWetFrontPointsCount;
+    size_t mSortedWetFrontSpringsCount;
+    std::vector<ElementIndex> mWetFrontMergeBuffer;
+
+    // The awake subset of the wet front, sorted, which is what water dynamics visit;
+    // dirty whenever the wet front or the awake elements change
+    std::vector<ElementIndex> mAwakeWetFrontPoints;
+    std::vector<ElementContainer::ElementRange> mAwakeWetFrontSpringRanges;
+    bool mIsAwakeWetFrontDirty;
+
+    // The tasks of the parallel water flow, made whenever the awake wet front is rebuilt:
+    // one for each chunk of awake wet front springs, and one for each chunk of awake wet
+    // front points; each task runs the current pass on its chunk
+    std::vector<ElementContainer::ElementRange> mWaterFlowSpringChunks;
+    std::vector<TaskThreadPool::Task> mWaterFlowSpringTasks;
+    std::vector<TaskThreadPool::Task> mWaterFlowPointTasks;
+
+    // The current pass of the parallel water flow, and how to run it on a chunk; 
+    // the pass is only alive while its tasks run
+    void const * mCurrentWaterFlowPass;
+    void (*mCurrentWaterFlowPassRunner)(void const * pass, size_t chunkIndex);
+
+    // The water splashed in each chunk of awake wet front points
+    std::vector<float> mWaterSplashedChunkSums;
+
+    /*
+     * The layout for fused mechanical iterations.
+     *
+     * Points are partitioned in tiles of consecutive points, and each spring belongs
+     * to the tile of its highest endpoint. A point may only be integrated once the forces
+     * of all of its springs have been accumulated, hence each point is integrated at the end
+     * of the last tile owning any of its springs.
+     */
+    struct FusedMechanicalTiles
+    {
+        // The springs, sorted by tile, and their physical parameters; the coefficients
+        // are gathered from the springs at each step, as they might change at any time
+        std::vector<ElementIndex> SpringIndices;
+        std::vector<ElementIndex> SpringEndpoints;
+        std::vector<float> SpringRestLengths;
+        std::vector<float> SpringStiffnessCoefficients;
+        std::vector<float> SpringDampingCoefficients;
+
+        // The (exclusive) end of the springs of each tile
+        std::vector<ElementIndex> SpringTileEnds;
+
+        // The points, sorted by the tile at the end of which they're integrated
+        std::vector<ElementIndex> PointIndices;
+
+        // The (exclusive) end of the points of each tile
+        std::vector<ElementIndex> PointTileEnds;
+
+        // The ranges of the awake, non-deleted springs in the order above, split at tile
+        // boundaries, and the (exclusive) end of the ranges of each tile; rebuilt together
+        // with the awake elements
+        std::vector<ElementContainer::ElementRange> AwakeSpringRanges;
+        std::vector<size_t> AwakeSpringRangeTileEnds;
+
+        // The awake, non-deleted points in the order above, and the (exclusive) end
+        // of the points of each tile; rebuilt together with the awake elements
+        std::vector<ElementIndex> AwakePointIndices;
+        std::vector<ElementIndex> AwakePointTileEnds;
+    };
+
+    FusedMechanicalTiles mFusedMechanicalTiles;
+
+    // The boxes around the awake connected components and the max velocities of their points, 
+    // and whether they might hit the sea floor; indexed by connected component ID - 1, and 
+    // calculated at the beginning of each step
+    std::vector<Geometry::AABB> mConnectedComponentAABBs;
+    std::vector<float> mConnectedComponentMaxSquareVelocities;
+    std::vector<bool> mIsConnectedComponentNearSeaFloor;
+
+    // The awake points that might hit the sea floor during the current step
+    std::vector<ElementContainer::ElementRange> mSeaFloorCollisionCandidatePointRanges;
 };
 
 }
\ No newline at end of file
@@ -207,6 +207,31 @@ std::unique_ptr<Ship> ShipBuilder::Create(
     LogMessage("Spring ACMR: original=", originalSpringACMR, ", optimized=", optimizedSpringACMR);
 
 
+    //
+    // Group springs into conflict-free batches, so that spring forces may be
+    // accumulated in parallel; the springs keep the order above, which rendering
+    // wants, while the solver visits them in batch order, hence we only do it 
+    // when the forces will actually be accumulated in parallel
+    //
+
+    std::vector<ElementIndex> colorOrderedSpringIndices;
+    std::vector<ElementIndex> springColorBatchEnds;
+    bool isLastSpringColorBatchSerial = false;
+
+    if (Ship::IsParallelSpringForcesWorthIt(
+        static_cast<ElementCount>(springInfos.size()),
+        parentWorld.GetTaskThreadPool().GetParallelism()))
+    {
+        isLastSpringColorBatchSerial = ColorSprings(
+            springInfos, 
+            pointInfos.size(), 
+            colorOrderedSpringIndices, 
+            springColorBatchEnds);
+
+        LogMessage("Spring colors: ", springColorBatchEnds.size(), (isLastSpringColorBatchSerial ? " (last one serial)" : ""));
+    }
+
+
     // Note: we don't optimize triangles, as tests indicate that performance gets (marginally) worse,
     // and at the same time, it makes sense to use the natural order of the triangles as it ensures
     // that higher elements in the ship cover lower elements when they are semi-detached
@@ -222,6 +247,11 @@ std::unique_ptr<Ship> ShipBuilder::Create(
         parentWorld,
         gameEventHandler);
 
+    springs.SetColorBatches(
+        std::move(colorOrderedSpringIndices),
+        std::move(springColorBatchEnds),
+        isLastSpringColorBatchSerial);
+
 
     //
     // Create Triangles for all TriangleInfo's except those whose vertices
@@ -760,6 +790,89 @@ ElectricalElements ShipBuilder::CreateElectricalElements(
     return electricalElements;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Spring coloring
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ShipBuilder::ColorSprings(
+    std::vector<SpringInfo> const & springInfos,
+    size_t vertexCount,
+    std::vector<ElementIndex> & colorOrderedSpringIndices,
+    std::vector<ElementIndex> & colorBatchEnds)
+{
+    //
+    // Greedy coloring: visit springs in their current order and assign to each spring
+    // the lowest color not yet taken by any other spring at either of its endpoints.
+    //
+    // A spring conflicts with the other springs of its endpoints, and greedy coloring
+    // needs at most one color more than the conflicts of any spring; with eight
+    // neighbors per point that's seventeen colors, but rope endpoints may have
+    // more springs, hence we allow for as many colors as our masks can hold, and
+    // springs that find none of them free go to a serial batch.
+    //
+
+    static constexpr size_t MaxColorCount = 32;
+    static constexpr size_t SerialColor = MaxColorCount;
+
+    std::vector<uint32_t> vertexUsedColors(vertexCount, 0u);
+    std::vector<size_t> springColors(springInfos.size());
+    size_t colorCount = 0;
+    bool hasSerialSprings = false;
+
+    for (size_t s = 0; s < springInfos.size(); ++s)
+    {
+        uint32_t const usedColors =
+            vertexUsedColors[springInfos[s].PointAIndex]
+            | vertexUsedColors[springInfos[s].PointBIndex];
+
+        size_t color = 0;
+        while (color < MaxColorCount && 0 != (usedColors & (1u << color)))
+        {
+            ++color;
+        }
+
+        if (color < MaxColorCount)
+        {
+            vertexUsedColors[springInfos[s].PointAIndex] |= (1u << color);
+            vertexUsedColors[springInfos[s].PointBIndex] |= (1u << color);
+
+            colorCount = std::max(colorCount, color + 1);
+        }
+        else
+        {
+            hasSerialSprings = true;
+        }
+
+        springColors[s] = color;
+    }
+
+    //
+    // Build color batches, keeping the cache-optimized order within each batch
+    //
+
+    colorOrderedSpringIndices.clear();
+    colorOrderedSpringIndices.reserve(springInfos.size());
+
+    colorBatchEnds.clear();
+
+    for (size_t c = 0; c < colorCount + (hasSerialSprings ? 1 : 0); ++c)
+    {
+        size_t const color = (c < colorCount) ? c : SerialColor;
+
+        for (size_t s = 0; s < springInfos.size(); ++s)
+        {
+            if (springColors[s] == color)
+            {
+                colorOrderedSpringIndices.push_back(static_cast<ElementIndex>(s));
+            }
+        }
+
+        colorBatchEnds.push_back(static_cast<ElementIndex>(colorOrderedSpringIndices.size()));
+    }
+
+    return hasSerialSprings;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // Vertex cache optimization
 //////////////////////////////////////////////////////////////////////////////////////////////////
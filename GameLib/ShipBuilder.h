@@ -142,6 +142,24 @@ private:
         Physics::World & parentWorld,
         std::shared_ptr<IGameEventHandler> gameEventHandler);
 
+private:
+
+    /////////////////////////////////////////////////////////////////
+    // Spring coloring
+    /////////////////////////////////////////////////////////////////
+
+    /*
+     * Partitions the springs in batches of springs sharing no endpoints, returning the
+     * spring indices sorted by batch and the (exclusive) end of each batch; the springs
+     * themselves keep their order. Springs that fit in no batch end up in a last batch
+     * that does share endpoints, in which case returns true.
+     */
+    static bool ColorSprings(
+        std::vector<SpringInfo> const & springInfos,
+        size_t vertexCount,
+        std::vector<ElementIndex> & colorOrderedSpringIndices,
+        std::vector<ElementIndex> & colorBatchEnds);
+
 private:
 
     /////////////////////////////////////////////////////////////////
@@ -5,7 +5,11 @@
  ***************************************************************************************/
 #include "Physics.h"
 
+#include "Algorithms.h"
+
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace Physics {
 
@@ -26,10 +30,14 @@ void Springs::Add(
     float stiffness = (points.GetMaterial(pointAIndex)->Stiffness + points.GetMaterial(pointBIndex)->Stiffness) / 2.0f;
     mStiffnessBuffer.emplace_back(stiffness);
 
-    mRestLengthBuffer.emplace_back((points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length());
-    mCoefficientsBuffer.emplace_back(
-        CalculateStiffnessCoefficient(pointAIndex, pointBIndex, stiffness, 1.0f, points),
-        CalculateDampingCoefficient(pointAIndex, pointBIndex, points));
+    float const restLength = (points.GetPosition(pointAIndex) - points.GetPosition(pointBIndex)).length();
+    mRestLengthBuffer.emplace_back(restLength);
+    mStiffnessCoefficientBuffer.emplace_back(CalculateStiffnessCoefficient(pointAIndex, pointBIndex, stiffness, 1.0f, mCurrentMechanicalDynamicsSimulationStepTimeDuration, points));
+    float const dampingCoefficient = CalculateDampingCoefficient(pointAIndex, pointBIndex, mCurrentMechanicalDynamicsSimulationStepTimeDuration, points);
+    mDampingCoefficientBuffer.emplace_back(dampingCoefficient);
+    mPositionBasedDampingFractionBuffer.emplace_back(CalculatePositionBasedDampingFraction(pointAIndex, pointBIndex, dampingCoefficient, mCurrentMechanicalDynamicsSimulationStepTimeDuration, points));
+    mCurrentLengthBuffer.emplace_back(restLength);
+    mCurrentNormalizedVectorBuffer.emplace_back((points.GetPosition(pointBIndex) - points.GetPosition(pointAIndex)).normalise());
     mCharacteristicsBuffer.emplace_back(characteristics);
 
     // Base material is arbitrarily the weakest of the two;
@@ -72,12 +80,19 @@ void Springs::Destroy(
             1);
     }
 
+    MarkDestroyed(springElementIndex);
+}
+
+void Springs::MarkDestroyed(ElementIndex springElementIndex)
+{
+    assert(springElementIndex < mElementCount);
+    assert(!IsDeleted(springElementIndex));
 
     // Zero out our coefficients, so that we can still calculate Hooke's 
     // and damping forces for this spring without running the risk of 
     // affecting non-deleted points
-    mCoefficientsBuffer[springElementIndex].StiffnessCoefficient = 0.0f;
-    mCoefficientsBuffer[springElementIndex].DampingCoefficient = 0.0f;
+    mStiffnessCoefficientBuffer[springElementIndex] = 0.0f;
+    mDampingCoefficientBuffer[springElementIndex] = 0.0f;
 
     // Flag ourselves as deleted
     mIsDeletedBuffer[springElementIndex] = true;
@@ -87,24 +102,44 @@ void Springs::UpdateGameParameters(
     GameParameters const & gameParameters,
     Points const & points)
 {
-    if (gameParameters.StiffnessAdjustment != mCurrentStiffnessAdjustment)
+    // The dt of each mechanical iteration is chosen by the ship, and it's
+    // the one the points calculate their integration factors with
+    float const mechanicalDynamicsSimulationStepTimeDuration = points.GetCurrentMechanicalDynamicsSimulationStepTimeDuration();
+
+    if (gameParameters.StiffnessAdjustment != mCurrentStiffnessAdjustment
+        || mechanicalDynamicsSimulationStepTimeDuration != mCurrentMechanicalDynamicsSimulationStepTimeDuration)
     {       
         // Recalc coefficients
-        for (ElementIndex i : *this)
+        for (ElementIndex i : GetActiveElements())
         {
             if (!IsDeleted(i))
             {
-                mCoefficientsBuffer[i].StiffnessCoefficient = CalculateStiffnessCoefficient(
+                mStiffnessCoefficientBuffer[i] = CalculateStiffnessCoefficient(
                     GetPointAIndex(i),
                     GetPointBIndex(i),
                     GetStiffness(i),
                     gameParameters.StiffnessAdjustment,
+                    mechanicalDynamicsSimulationStepTimeDuration,
+                    points);
+
+                mDampingCoefficientBuffer[i] = CalculateDampingCoefficient(
+                    GetPointAIndex(i),
+                    GetPointBIndex(i),
+                    mechanicalDynamicsSimulationStepTimeDuration,
+                    points);
+
+                mPositionBasedDampingFractionBuffer[i] = CalculatePositionBasedDampingFraction(
+                    GetPointAIndex(i),
+                    GetPointBIndex(i),
+                    mDampingCoefficientBuffer[i],
+                    mechanicalDynamicsSimulationStepTimeDuration,
                     points);
             }
         }
 
-        // Remember the new stiffness
+        // Remember the new stiffness and dt
         mCurrentStiffnessAdjustment = gameParameters.StiffnessAdjustment;
+        mCurrentMechanicalDynamicsSimulationStepTimeDuration = mechanicalDynamicsSimulationStepTimeDuration;
     }
 }
 
@@ -113,7 +148,7 @@ void Springs::UploadElements(
     Render::RenderContext & renderContext,
     Points const & points) const
 {
-    for (ElementIndex i : *this)
+    for (ElementIndex i : GetActiveElements())
     {
         if (!mIsDeletedBuffer[i])
         {
@@ -144,7 +179,7 @@ void Springs::UploadStressedSpringElements(
     Render::RenderContext & renderContext,
     Points const & points) const
 {
-    for (ElementIndex i : *this)
+    for (ElementIndex i : GetActiveElements())
     {
         if (!mIsDeletedBuffer[i])
         {
@@ -162,59 +197,90 @@ void Springs::UploadStressedSpringElements(
     }
 }
 
-bool Springs::UpdateStrains(
+bool Springs::UpdateCurrentGeometryAndStrains(
     GameParameters const & gameParameters,
     Points & points)
 {
-    bool isAtLeastOneBroken = false;
-    
-    for (ElementIndex i : *this)
+    //
+    // Calculate geometry and strains in one pass, collecting the springs
+    // that break and those that are stressed
+    //
+
+    mMaxRelativeStrain = 0.0f;
+
+    ElementCount brokenSpringCount = 0;
+    ElementCount newStressedSpringCount = 0;
+
+    for (auto const & range : GetActiveElementRanges())
     {
-        // Avoid breaking deleted springs
-        if (!mIsDeletedBuffer[i])
-        {
-            // Calculate strain
-            float dx = (points.GetPosition(mEndpointsBuffer[i].PointAIndex) - points.GetPosition(mEndpointsBuffer[i].PointBIndex)).length();
-            float const strain = fabs(mRestLengthBuffer[i] - dx) / mRestLengthBuffer[i];
+        Algorithms::CalculateSpringGeometryAndStrains(
+            range.Start,
+            range.End,
+            GetEndpointsBufferAsElementIndex(),
+            mRestLengthBuffer.data(),
+            mStrengthBuffer.data(),
+            mIsDeletedBuffer.data(),
+            gameParameters.StrengthAdjustment,
+            points.GetPositionBufferAsVec2(),
+            mCurrentLengthBuffer.data(),
+            mCurrentNormalizedVectorBuffer.data(),
+            mBrokenSpringIndices.data(),
+            brokenSpringCount,
+            mNewStressedSpringIndices.data(),
+            newStressedSpringCount,
+            mMaxRelativeStrain,
+            gameParameters.SpringGeometryMathQuality);
+    }
 
-            // Check against strength
-            float const effectiveStrength = gameParameters.StrengthAdjustment * mStrengthBuffer[i];
-            if (strain > effectiveStrength)
-            {
-                // It's broken!
 
-                // Destroy this spring
-                this->Destroy(
-                    i,
-                    DestroyOptions::FireBreakEvent // Notify Break
-                    | DestroyOptions::DestroyAllTriangles,
-                    points);
+    //
+    // Notify stress for the springs that have just entered the stressed state,
+    // and then update the state of the springs that were or are stressed
+    //
 
-                isAtLeastOneBroken = true;
-            }
-            else if (strain > 0.5f * effectiveStrength)
-            {
-                // It's stressed!
-                if (!mIsStressedBuffer[i])
-                {
-                    mIsStressedBuffer[i] = true;
-
-                    // Notify stress
-                    mGameEventHandler->OnStress(
-                        mBaseMaterialBuffer[i],
-                        mParentWorld.IsUnderwater(points.GetPosition(mEndpointsBuffer[i].PointAIndex)),
-                        1);
-                }
-            }
-            else
-            {
-                // Just fine
-                mIsStressedBuffer[i] = false;
-            }
+    for (ElementCount s = 0; s < newStressedSpringCount; ++s)
+    {
+        ElementIndex const springIndex = mNewStressedSpringIndices[s];
+        if (!mIsStressedBuffer[springIndex])
+        {
+            mGameEventHandler->OnStress(
+                mBaseMaterialBuffer[springIndex],
+                mParentWorld.IsUnderwater(points.GetPosition(mEndpointsBuffer[springIndex].PointAIndex)),
+                1);
         }
     }
 
-    return isAtLeastOneBroken;
+    for (ElementCount s = 0; s < mStressedSpringCount; ++s)
+    {
+        mIsStressedBuffer[mStressedSpringIndices[s]] = false;
+    }
+
+    for (ElementCount s = 0; s < newStressedSpringCount; ++s)
+    {
+        mIsStressedBuffer[mNewStressedSpringIndices[s]] = true;
+    }
+
+    std::swap(mStressedSpringIndices, mNewStressedSpringIndices);
+    mStressedSpringCount = newStressedSpringCount;
+
+
+    //
+    // Destroy the broken springs; this does not destroy other springs,
+    // hence none of the collected ones is deleted in the meantime
+    //
+
+    for (ElementCount s = 0; s < brokenSpringCount; ++s)
+    {
+        assert(!mIsDeletedBuffer[mBrokenSpringIndices[s]]);
+
+        this->Destroy(
+            mBrokenSpringIndices[s],
+            DestroyOptions::FireBreakEvent // Notify Break
+            | DestroyOptions::DestroyAllTriangles,
+            points);
+    }
+
+    return brokenSpringCount > 0;
 }
 
 float Springs::CalculateStiffnessCoefficient(    
@@ -222,6 +288,7 @@ float Springs::CalculateStiffnessCoefficient(
     ElementIndex pointBIndex,
     float springStiffness,
     float stiffnessAdjustment,
+    float mechanicalDynamicsSimulationStepTimeDuration,
     Points const & points)
 {
     //
@@ -240,9 +307,9 @@ float Springs::CalculateStiffnessCoefficient(
         (points.GetMass(pointAIndex) * points.GetMass(pointBIndex)) 
         / (points.GetMass(pointAIndex) + points.GetMass(pointBIndex));
 
-    static constexpr float dtSquared = 
-        GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float> 
-        * GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;    
+    float const dtSquared = 
+        mechanicalDynamicsSimulationStepTimeDuration
+        * mechanicalDynamicsSimulationStepTimeDuration;    
 
     return C * springStiffness * stiffnessAdjustment * massFactor / dtSquared;
 }
@@ -250,6 +317,7 @@ float Springs::CalculateStiffnessCoefficient(
 float Springs::CalculateDampingCoefficient(    
     ElementIndex pointAIndex,
     ElementIndex pointBIndex,
+    float mechanicalDynamicsSimulationStepTimeDuration,
     Points const & points)
 {
     // The empirically-determined constant for the spring damping
@@ -263,9 +331,31 @@ float Springs::CalculateDampingCoefficient(
         (points.GetMass(pointAIndex) * points.GetMass(pointBIndex)) 
         / (points.GetMass(pointAIndex) + points.GetMass(pointBIndex));
 
-    static constexpr float dt = GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;
+    float const dt = mechanicalDynamicsSimulationStepTimeDuration;
 
     return C * massFactor / dt;
 }
 
+float Springs::CalculatePositionBasedDampingFraction(
+    ElementIndex pointAIndex,
+    ElementIndex pointBIndex,
+    float dampingCoefficient,
+    float mechanicalDynamicsSimulationStepTimeDuration,
+    Points const & points)
+{
+    float const dt = mechanicalDynamicsSimulationStepTimeDuration;
+
+    float const inverseMassSum = 1.0f / points.GetMass(pointAIndex) + 1.0f / points.GetMass(pointBIndex);
+
+    // The fraction removed by one explicit iteration, with the coefficient current for this dt...
+    float const explicitDampingFraction = std::min(
+        dampingCoefficient * dt * inverseMassSum,
+        1.0f);
+
+    // ...compounded over the explicit iterations that fit in a substep of this dt
+    float const explicitIterationsPerSubstep = dt / GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;
+
+    return 1.0f - std::pow(1.0f - explicitDampingFraction, explicitIterationsPerSubstep);
+}
+
 }
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <cassert>
 #include <functional>
 #include <limits>
+#include <vector>
 
 namespace Physics
 {
@@ -62,21 +63,8 @@ private:
         {}
     };
 
-    /*
-     * The coefficients used for the spring dynamics.
-     */
-    struct Coefficients
-    {
-        float StiffnessCoefficient;
-        float DampingCoefficient;
-        
-        Coefficients(
-            float stiffnessCoefficient,
-            float dampingCoefficient)
-            : StiffnessCoefficient(stiffnessCoefficient)
-            , DampingCoefficient(dampingCoefficient)
-        {}
-    };
+    // The vectorized kernels see the endpoints as a flat array of indices
+    static_assert(sizeof(Endpoints) == 2 * sizeof(ElementIndex));
 
 public:
 
@@ -95,7 +83,11 @@ public:
         , mStrengthBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mStiffnessBuffer(mBufferElementCount, mElementCount, 0.0f)
         , mRestLengthBuffer(mBufferElementCount, mElementCount, 1.0f)
-        , mCoefficientsBuffer(mBufferElementCount, mElementCount, Coefficients(0.0f, 0.0f))
+        , mStiffnessCoefficientBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mDampingCoefficientBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mPositionBasedDampingFractionBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mCurrentLengthBuffer(mBufferElementCount, mElementCount, 0.0f)
+        , mCurrentNormalizedVectorBuffer(mBufferElementCount, mElementCount, vec2f::zero())
         , mCharacteristicsBuffer(mBufferElementCount, mElementCount, Characteristics::None)
         , mBaseMaterialBuffer(mBufferElementCount, mElementCount, nullptr)
         // Water
@@ -111,6 +103,15 @@ public:
         , mGameEventHandler(std::move(gameEventHandler))
         , mDestroyHandler()
         , mCurrentStiffnessAdjustment(std::numeric_limits<float>::lowest())
+        , mCurrentMechanicalDynamicsSimulationStepTimeDuration(GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>)
+        , mMaxRelativeStrain(0.0f)
+        , mBrokenSpringIndices(elementCount)
+        , mStressedSpringIndices(elementCount)
+        , mNewStressedSpringIndices(elementCount)
+        , mStressedSpringCount(0)
+        , mColorOrderedSpringIndices()
+        , mColorBatchEnds()
+        , mIsLastColorBatchSerial(false)
         , mFloatBufferAllocator(mBufferElementCount)
         , mVec2fBufferAllocator(mBufferElementCount)
     {
@@ -147,6 +148,12 @@ public:
         DestroyOptions destroyOptions,
         Points const & points);
 
+    /*
+     * Flags a spring as deleted, without invoking the destroy handler and without
+     * firing events; batch destructions take care of both themselves.
+     */
+    void MarkDestroyed(ElementIndex springElementIndex);
+
     void UpdateGameParameters(
         GameParameters const & gameParameters,
         Points const & points);
@@ -157,14 +164,50 @@ public:
     {
         assert(springElementIndex < mElementCount);
 
-        CalculateStiffnessCoefficient(
+        mStiffnessCoefficientBuffer[springElementIndex] = CalculateStiffnessCoefficient(
             mEndpointsBuffer[springElementIndex].PointAIndex,
             mEndpointsBuffer[springElementIndex].PointBIndex,
             mStiffnessBuffer[springElementIndex],
             mCurrentStiffnessAdjustment,
+            mCurrentMechanicalDynamicsSimulationStepTimeDuration,
+            points);
+
+        mDampingCoefficientBuffer[springElementIndex] = CalculateDampingCoefficient(
+            mEndpointsBuffer[springElementIndex].PointAIndex,
+            mEndpointsBuffer[springElementIndex].PointBIndex,
+            mCurrentMechanicalDynamicsSimulationStepTimeDuration,
+            points);
+
+        mPositionBasedDampingFractionBuffer[springElementIndex] = CalculatePositionBasedDampingFraction(
+            mEndpointsBuffer[springElementIndex].PointAIndex,
+            mEndpointsBuffer[springElementIndex].PointBIndex,
+            mDampingCoefficientBuffer[springElementIndex],
+            mCurrentMechanicalDynamicsSimulationStepTimeDuration,
             points);
     }
 
+    /*
+     * Sets the color batches, i.e. the groups of springs that do not share any endpoints 
+     * among themselves, and whose forces may thus be accumulated concurrently: the spring
+     * indices sorted by batch, and the (exclusive) end of each batch among them. 
+     *
+     * The last batch may be serial, i.e. made of the springs that fit in no other batch,
+     * whose forces must then be accumulated one spring at a time.
+     */
+    void SetColorBatches(
+        std::vector<ElementIndex> colorOrderedSpringIndices,
+        std::vector<ElementIndex> colorBatchEnds,
+        bool isLastColorBatchSerial)
+    {
+        assert(colorBatchEnds.empty() || colorBatchEnds.back() == mElementCount);
+        assert(colorOrderedSpringIndices.size() == (colorBatchEnds.empty() ? 0 : mElementCount));
+        assert(!isLastColorBatchSerial || !colorBatchEnds.empty());
+
+        mColorOrderedSpringIndices = std::move(colorOrderedSpringIndices);
+        mColorBatchEnds = std::move(colorBatchEnds);
+        mIsLastColorBatchSerial = isLastColorBatchSerial;
+    }
+
     //
     // Render
     //
@@ -182,14 +225,29 @@ public:
 public:
 
     /*
-     * Calculates the current strain - due to tension or compression - and acts depending on it.
+     * Calculates the current length and normalized vector of all springs, from the
+     * current positions of their endpoints, and in the same pass calculates their
+     * strain - due to tension or compression - and acts depending on it.
+     *
+     * Invoked once per step, after the positions have been integrated; all the
+     * passes that follow in the same step use these values instead of calculating
+     * them again. Springs that break are destroyed after the pass, in one batch.
      *
-     * Returns true if the spring got broken.
+     * Returns true if at least one spring got broken.
      */
-    bool UpdateStrains(
+    bool UpdateCurrentGeometryAndStrains(
         GameParameters const & gameParameters,
         Points & points);
 
+    /*
+     * Gets the max ratio between the strain and the effective strength of all springs,
+     * as of the last strain update.
+     */
+    float GetMaxRelativeStrain() const
+    {
+        return mMaxRelativeStrain;
+    }
+
 public:
 
     //
@@ -201,10 +259,21 @@ public:
         return mIsDeletedBuffer[springElementIndex];
     }
 
+    // Drops the elements deleted since the last rebuild from the active elements
+    void RebuildActiveElements()
+    {
+        ElementContainer::RebuildActiveElements(mIsDeletedBuffer);
+    }
+
     //
     // Endpoints
     //
 
+    ElementIndex const * restrict GetEndpointsBufferAsElementIndex() const
+    {
+        return reinterpret_cast<ElementIndex const *>(mEndpointsBuffer.data());
+    }
+
     ElementIndex GetPointAIndex(ElementIndex springElementIndex) const
     {
         return mEndpointsBuffer[springElementIndex].PointAIndex;
@@ -262,6 +331,41 @@ public:
             + GetPointBPosition(springElementIndex, points)) / 2.0f;
     }
 
+    //
+    // Color batches
+    //
+
+    std::vector<ElementIndex> const & GetColorOrderedSpringIndices() const
+    {
+        return mColorOrderedSpringIndices;
+    }
+
+    size_t GetColorBatchCount() const
+    {
+        return mColorBatchEnds.size();
+    }
+
+    ElementIndex GetColorBatchStart(size_t colorBatchIndex) const
+    {
+        assert(colorBatchIndex < mColorBatchEnds.size());
+
+        return colorBatchIndex == 0 ? 0 : mColorBatchEnds[colorBatchIndex - 1];
+    }
+
+    ElementIndex GetColorBatchEnd(size_t colorBatchIndex) const
+    {
+        assert(colorBatchIndex < mColorBatchEnds.size());
+
+        return mColorBatchEnds[colorBatchIndex];
+    }
+
+    bool IsColorBatchSerial(size_t colorBatchIndex) const
+    {
+        assert(colorBatchIndex < mColorBatchEnds.size());
+
+        return mIsLastColorBatchSerial && colorBatchIndex == mColorBatchEnds.size() - 1;
+    }
+
     //
     // Physical
     //
@@ -281,14 +385,55 @@ public:
         return mRestLengthBuffer[springElementIndex];
     }
 
+    float const * restrict GetRestLengthBufferAsFloat() const
+    {
+        return mRestLengthBuffer.data();
+    }
+
+    // As of the last UpdateCurrentGeometryAndStrains()
+    float GetCurrentLength(ElementIndex springElementIndex) const
+    {
+        return mCurrentLengthBuffer[springElementIndex];
+    }
+
+    // Oriented from point A to point B, as of the last UpdateCurrentGeometryAndStrains()
+    vec2f const & GetCurrentNormalizedVector(ElementIndex springElementIndex) const
+    {
+        return mCurrentNormalizedVectorBuffer[springElementIndex];
+    }
+
+    vec2f const * restrict GetCurrentNormalizedVectorBufferAsVec2() const
+    {
+        return mCurrentNormalizedVectorBuffer.data();
+    }
+
     float GetStiffnessCoefficient(ElementIndex springElementIndex) const
     {
-        return mCoefficientsBuffer[springElementIndex].StiffnessCoefficient;
+        return mStiffnessCoefficientBuffer[springElementIndex];
+    }
+
+    float const * restrict GetStiffnessCoefficientBufferAsFloat() const
+    {
+        return mStiffnessCoefficientBuffer.data();
     }
 
     float GetDampingCoefficient(ElementIndex springElementIndex) const
     {
-        return mCoefficientsBuffer[springElementIndex].DampingCoefficient;
+        return mDampingCoefficientBuffer[springElementIndex];
+    }
+
+    float const * restrict GetDampingCoefficientBufferAsFloat() const
+    {
+        return mDampingCoefficientBuffer.data();
+    }
+
+    /*
+     * The fraction of relative velocity that the position-based solver removes from
+     * a spring at each substep, i.e. what the explicit damping removes in the same time.
+     */
+    float const * restrict GetPositionBasedDampingFractionBufferAsFloat() const
+    {
+        return mPositionBasedDampingFractionBuffer.data();
     }
 
     Material const * GetBaseMaterial(ElementIndex springElementIndex) const
@@ -356,12 +501,12 @@ public:
     // Temporary buffer
     //
 
-    std::shared_ptr<Buffer<float>> AllocateWorkBufferFloat()
+    BufferAllocator<float>::BufferPtr AllocateWorkBufferFloat()
     {
         return mFloatBufferAllocator.Allocate();
     }
 
-    std::shared_ptr<Buffer<vec2f>> AllocateWorkBufferVec2f()
+    BufferAllocator<vec2f>::BufferPtr AllocateWorkBufferVec2f()
     {
         return mVec2fBufferAllocator.Allocate();
     }
@@ -373,11 +518,20 @@ private:
         ElementIndex pointBIndex,
         float springStiffness,
         float stiffnessAdjustment,
+        float mechanicalDynamicsSimulationStepTimeDuration,
         Points const & points);
 
     static float CalculateDampingCoefficient(        
         ElementIndex pointAIndex,
         ElementIndex pointBIndex,
+        float mechanicalDynamicsSimulationStepTimeDuration,
+        Points const & points);
+
+    static float CalculatePositionBasedDampingFraction(
+        ElementIndex pointAIndex,
+        ElementIndex pointBIndex,
+        float dampingCoefficient,
+        float mechanicalDynamicsSimulationStepTimeDuration,
         Points const & points);
 
 private:
@@ -399,7 +553,14 @@ private:
     Buffer<float> mStrengthBuffer;
     Buffer<float> mStiffnessBuffer;
     Buffer<float> mRestLengthBuffer;
-    Buffer<Coefficients> mCoefficientsBuffer;
+    Buffer<float> mStiffnessCoefficientBuffer;
+    Buffer<float> mDampingCoefficientBuffer;
+    Buffer<float> mPositionBasedDampingFractionBuffer;
+
+    // Calculated once per step
+    Buffer<float> mCurrentLengthBuffer;
+    Buffer<vec2f> mCurrentNormalizedVectorBuffer;
+
     Buffer<Characteristics> mCharacteristicsBuffer;
     Buffer<Material const *> mBaseMaterialBuffer;
 
@@ -436,6 +597,24 @@ private:
 
     // The current stiffness adjustment
     float mCurrentStiffnessAdjustment;
+    float mCurrentMechanicalDynamicsSimulationStepTimeDuration;
+
+    // The max ratio between strain and strength, as of the last strain update
+    float mMaxRelativeStrain;
+
+    // Scratch lists filled by the strain update, sized for all springs; the stressed
+    // springs are kept until the next update, so that only their state needs resetting
+    std::vector<ElementIndex> mBrokenSpringIndices;
+    std::vector<ElementIndex> mStressedSpringIndices;
+    std::vector<ElementIndex> mNewStressedSpringIndices;
+    ElementCount mStressedSpringCount;
+
+    // The spring indices sorted by color batch, the (exclusive) end of each color 
+    // batch among them, and whether the last batch is serial; empty when the springs
+    // have not been colored
+    std::vector<ElementIndex> mColorOrderedSpringIndices;
+    std::vector<ElementIndex> mColorBatchEnds;
+    bool mIsLastColorBatchSerial;
 
     // Allocators for work buffers
     BufferAllocator<float> mFloatBufferAllocator;
@@ -0,0 +1,108 @@
+/***************************************************************************************
+* Original Author:      agent
+* Created:              2026-10-17
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "SysSpecifics.h"
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace /* anonymous */ {
+
+    void CpuId(
+        int leaf,
+        int subleaf,
+        uint32_t registers[4])
+    {
+#ifdef _MSC_VER
+        int r[4];
+        __cpuidex(r, leaf, subleaf);
+        for (int i = 0; i < 4; ++i)
+            registers[i] = static_cast<uint32_t>(r[i]);
+#else
+        __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    }
+
+    uint64_t GetXCR0()
+    {
+#ifdef _MSC_VER
+        return _xgetbv(0);
+#else
+        uint32_t eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+    }
+
+    InstructionSet DetectInstructionSet()
+    {
+        uint32_t registers[4]; // EAX, EBX, ECX, EDX
+
+        CpuId(0, 0, registers);
+        uint32_t const maxLeaf = registers[0];
+        if (maxLeaf < 1)
+            return InstructionSet::Scalar;
+
+        CpuId(1, 0, registers);
+
+        bool const hasSSE2 = !!(registers[3] & (1u << 26));
+        if (!hasSSE2)
+            return InstructionSet::Scalar;
+
+        // Anything wider than SSE needs the OS to save the wider registers
+        // on context switches
+        bool const hasOSXSAVE = !!(registers[2] & (1u << 27));
+        bool const hasAVX = !!(registers[2] & (1u << 28));
+        if (!hasOSXSAVE || !hasAVX || maxLeaf < 7)
+            return InstructionSet::SSE2;
+
+        uint64_t const xcr0 = GetXCR0();
+        bool const osSavesYmm = (xcr0 & 0x06) == 0x06;
+        bool const osSavesZmm = (xcr0 & 0xE6) == 0xE6;
+
+        CpuId(7, 0, registers);
+        bool const hasAVX2 = !!(registers[1] & (1u << 5));
+        bool const hasAVX512F = !!(registers[1] & (1u << 16));
+
+        // AVX-512 code uses AVX2 instructions as well, and CPUs or VMs may report
+        // AVX-512F without AVX2
+        if (hasAVX512F && osSavesZmm && hasAVX2 && osSavesYmm)
+            return InstructionSet::AVX512;
+
+        if (hasAVX2 && osSavesYmm)
+            return InstructionSet::AVX2;
+
+        return InstructionSet::SSE2;
+    }
+}
+
+InstructionSet GetInstructionSet()
+{
+    static InstructionSet const instructionSet = DetectInstructionSet();
+
+    return instructionSet;
+}
+
+char const * InstructionSetToStr(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+        case InstructionSet::Scalar:
+            return "Scalar";
+        case InstructionSet::SSE2:
+            return "SSE2";
+        case InstructionSet::AVX2:
+            return "AVX2";
+        case InstructionSet::AVX512:
+            return "AVX-512";
+    }
+
+    return "Unknown";
+}
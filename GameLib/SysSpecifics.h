@@ -43,6 +43,41 @@ inline void aligned_free(void * ptr)
 
 #endif
 
+//
+// Instruction sets
+//
+
+/*
+ * The SIMD instruction sets for which we have hand-vectorized kernels,
+ * in increasing order of capability.
+ */
+enum class InstructionSet
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+/*
+ * Detects - once - the best instruction set supported by both the CPU and the OS.
+ */
+InstructionSet GetInstructionSet();
+
+char const * InstructionSetToStr(InstructionSet instructionSet);
+
+/*
+ * Decorations for functions using intrinsics beyond the compiler's baseline;
+ * MSVC allows any intrinsic anywhere, while gcc and clang need to be told.
+ */
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#define TARGET_AVX512
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
 // Targeting AVX-512
 static constexpr size_t VectorizationWordSize = 8;
 
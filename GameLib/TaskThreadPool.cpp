@@ -0,0 +1,135 @@
+/***************************************************************************************
+* Original Author:      agent
+* Created:              2026-10-17
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#include "TaskThreadPool.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <cassert>
+
+TaskThreadPool::TaskThreadPool()
+    : TaskThreadPool(std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+TaskThreadPool::TaskThreadPool(size_t parallelism)
+    : mThreads()
+    , mLock()
+    , mWorkAvailableSignal()
+    , mWorkCompletedSignal()
+    , mCurrentTasks(nullptr)
+    , mNextTaskIndex(0)
+    , mRemainingTasksCount(0)
+    , mIsStop(false)
+{
+    assert(parallelism >= 1);
+
+    // The calling thread is one of the runners
+    for (size_t t = 1; t < parallelism; ++t)
+    {
+        mThreads.emplace_back(&TaskThreadPool::ThreadLoop, this);
+    }
+
+    LogMessage("TaskThreadPool: started ", mThreads.size(), " worker threads");
+}
+
+TaskThreadPool::~TaskThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+
+        mIsStop = true;
+    }
+
+    mWorkAvailableSignal.notify_all();
+
+    for (auto & thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void TaskThreadPool::Run(std::vector<Task> const & tasks)
+{
+    if (tasks.size() == 1 || mThreads.empty())
+    {
+        // No point in waking up anyone
+        for (auto const & task : tasks)
+        {
+            task();
+        }
+
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mLock);
+
+    assert(nullptr == mCurrentTasks);
+
+    mCurrentTasks = &tasks;
+    mNextTaskIndex = 0;
+    mRemainingTasksCount = tasks.size();
+
+    mWorkAvailableSignal.notify_all();
+
+    // Run tasks ourselves too, as long as there are any left
+    while (mNextTaskIndex < tasks.size())
+    {
+        Task const & task = tasks[mNextTaskIndex++];
+
+        lock.unlock();
+
+        task();
+
+        lock.lock();
+
+        --mRemainingTasksCount;
+    }
+
+    // Wait for the tasks taken by the workers to complete
+    mWorkCompletedSignal.wait(
+        lock,
+        [this]()
+        {
+            return 0 == mRemainingTasksCount;
+        });
+
+    mCurrentTasks = nullptr;
+}
+
+void TaskThreadPool::ThreadLoop()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+
+    while (true)
+    {
+        mWorkAvailableSignal.wait(
+            lock,
+            [this]()
+            {
+                return mIsStop
+                    || (nullptr != mCurrentTasks && mNextTaskIndex < mCurrentTasks->size());
+            });
+
+        if (mIsStop)
+            break;
+
+        Task const & task = (*mCurrentTasks)[mNextTaskIndex++];
+
+        lock.unlock();
+
+        task();
+
+        lock.lock();
+
+        assert(mRemainingTasksCount > 0);
+        --mRemainingTasksCount;
+        if (0 == mRemainingTasksCount)
+        {
+            mWorkCompletedSignal.notify_one();
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/***************************************************************************************
+* Original Author:      agent
+* Created:              2026-10-17
+* Copyright:            Gabriele Giuseppini  (https://github.com/GabrieleGiuseppini)
+***************************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * A fixed set of worker threads that run batches of tasks on behalf of a (single) caller.
+ *
+ * The calling thread takes part in running the tasks, hence a pool with a parallelism of N
+ * spawns N-1 threads.
+ */
+class TaskThreadPool
+{
+public:
+
+    /*
+     * A task: a callable that is stored within the task itself, so that making,
+     * copying, and running tasks never allocates.
+     *
+     * The callable must be trivially copyable - e.g. a lambda capturing a few
+     * pointers and indices by value - and must fit in the task's storage.
+     */
+    class Task
+    {
+    public:
+
+        static constexpr size_t MaxCallableSize = 4 * sizeof(void *);
+
+        template<
+            typename TCallable,
+            typename = std::enable_if_t<!std::is_same<std::decay_t<TCallable>, Task>::value>>
+        Task(TCallable const & callable)
+            : mStorage()
+            , mInvoker(&Invoke<TCallable>)
+        {
+            static_assert(std::is_trivially_copyable<TCallable>::value, "Task callables must be trivially copyable");
+            static_assert(sizeof(TCallable) <= MaxCallableSize, "Task callable is too large");
+            static_assert(alignof(TCallable) <= alignof(std::max_align_t), "Task callable is over-aligned");
+
+            new (&mStorage) TCallable(callable);
+        }
+
+        void operator()() const
+        {
+            mInvoker(&mStorage);
+        }
+
+    private:
+
+        template<typename TCallable>
+        static void Invoke(void const * storage)
+        {
+            (*static_cast<TCallable const *>(storage))();
+        }
+
+    private:
+
+        std::aligned_storage_t<MaxCallableSize, alignof(std::max_align_t)> mStorage;
+        void (*mInvoker)(void const * storage);
+    };
+
+public:
+
+    // Uses as many threads as there are hardware threads
+    TaskThreadPool();
+
+    explicit TaskThreadPool(size_t parallelism);
+
+    ~TaskThreadPool();
+
+    TaskThreadPool(TaskThreadPool const & other) = delete;
+    TaskThreadPool(TaskThreadPool && other) = delete;
+    TaskThreadPool & operator=(TaskThreadPool const & other) = delete;
+    TaskThreadPool & operator=(TaskThreadPool && other) = delete;
+
+    size_t GetParallelism() const
+    {
+        return mThreads.size() + 1;
+    }
+
+    /*
+     * Runs all the specified tasks, returning only once all of them have completed.
+     *
+     * Tasks are not expected to throw.
+     */
+    void Run(std::vector<Task> const & tasks);
+
+private:
+
+    void ThreadLoop();
+
+private:
+
+    std::vector<std::thread> mThreads;
+
+    // Protects all of the state below
+    std::mutex mLock;
+
+    // Signalled when there are tasks to run, or when we're stopping
+    std::condition_variable mWorkAvailableSignal;
+
+    // Signalled when the last task of the current batch has completed
+    std::condition_variable mWorkCompletedSignal;
+
+    // The current batch of tasks, or nullptr when we're idle
+    std::vector<Task> const * mCurrentTasks;
+    size_t mNextTaskIndex;
+    size_t mRemainingTasksCount;
+
+    bool mIsStop;
+};
@@ -28,6 +28,14 @@ void Triangles::Destroy(ElementIndex triangleElementIndex)
         mDestroyHandler(triangleElementIndex);
     }
 
+    MarkDestroyed(triangleElementIndex);
+}
+
+void Triangles::MarkDestroyed(ElementIndex triangleElementIndex)
+{
+    assert(triangleElementIndex < mElementCount);
+    assert(!IsDeleted(triangleElementIndex));
+
     // Flag ourselves as deleted
     mIsDeletedBuffer[triangleElementIndex] = true;
 }
@@ -37,7 +45,7 @@ void Triangles::UploadElements(
     Render::RenderContext & renderContext,
     Points const & points) const
 {
-    for (ElementIndex i : *this)
+    for (ElementIndex i : GetActiveElements())
     {
         if (!mIsDeletedBuffer[i])
         {
@@ -90,6 +90,12 @@ public:
 
     void Destroy(ElementIndex triangleElementIndex);
 
+    /*
+     * Flags a triangle as deleted, without invoking the destroy handler; batch
+     * destructions take care of it themselves.
+     */
+    void MarkDestroyed(ElementIndex triangleElementIndex);
+
     //
     // Render
     //
@@ -110,6 +116,12 @@ public:
         return mIsDeletedBuffer[triangleElementIndex];
     }
 
+    // Drops the elements deleted since the last rebuild from the active elements
+    void RebuildActiveElements()
+    {
+        ElementContainer::RebuildActiveElements(mIsDeletedBuffer);
+    }
+
     //
     // Endpoints
     //
@@ -5,6 +5,7 @@
 ***************************************************************************************/
 #pragma once
 
+#include "Algorithms.h"
 #include "GameMath.h"
 #include "GameParameters.h"
 #include "Physics.h"
@@ -38,6 +39,26 @@ public:
             + (mSamples[index + 1] - mSamples[index]) * ((x / Dx) - absoluteSampleIndex);
     }
 
+    /*
+     * Calculates the water height at the x coordinates of all the specified points,
+     * in one go.
+     */
+    void GetWaterHeightsAt(
+        ElementIndex pointStart,
+        ElementIndex pointEnd,
+        vec2f const * restrict pointPositionBuffer,
+        float * restrict heightBuffer) const
+    {
+        Algorithms::SampleHeightField(
+            mSamples.get(),
+            static_cast<ElementCount>(SamplesCount),
+            Dx,
+            pointStart,
+            pointEnd,
+            pointPositionBuffer,
+            heightBuffer);
+    }
+
 private:
 
     // Frequencies of the wave components
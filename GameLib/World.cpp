@@ -10,12 +10,24 @@
 
 #include <algorithm>
 #include <cassert>
+#include <thread>
 
 namespace Physics {
 
 World::World(
     std::shared_ptr<IGameEventHandler> gameEventHandler,
     GameParameters const & gameParameters)
+    : World(
+        std::move(gameEventHandler),
+        gameParameters,
+        std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+World::World(
+    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    GameParameters const & gameParameters,
+    size_t parallelism)
     : mAllShips()
     , mAllClouds()
     , mWaterSurface()
@@ -23,6 +35,8 @@ World::World(
     , mCurrentTime(0.0f)
     , mCurrentVisitSequenceNumber(1u)
     , mGameEventHandler(std::move(gameEventHandler))
+    , mTaskThreadPool(parallelism)
+    , mMechanicalIterationsBudget(1.0f)
 {
     // Initialize clouds
     UpdateClouds(gameParameters);
@@ -233,6 +247,7 @@ void World::Update(GameParameters const & gameParameters)
     mOceanFloor.Update(gameParameters);
 
     // Update all ships
+    auto const shipsUpdateStartTimestamp = std::chrono::steady_clock::now();
     for (auto & ship : mAllShips)
     {
         ship->Update(
@@ -240,6 +255,10 @@ void World::Update(GameParameters const & gameParameters)
             gameParameters);
     }
 
+    UpdateMechanicalIterationsBudget(
+        std::chrono::steady_clock::now() - shipsUpdateStartTimestamp,
+        gameParameters);
+
     // Update clouds
     UpdateClouds(gameParameters);
 }
@@ -286,6 +305,35 @@ void World::Render(
 // Private Helpers
 ///////////////////////////////////////////////////////////////////////////////////
 
+void World::UpdateMechanicalIterationsBudget(
+    std::chrono::steady_clock::duration shipsUpdateDuration,
+    GameParameters const & gameParameters)
+{
+    static constexpr float MinBudget =
+        static_cast<float>(GameParameters::MinNumMechanicalDynamicsIterations)
+        / GameParameters::NumMechanicalDynamicsIterations<float>;
+
+    if (!gameParameters.DoAdaptMechanicalIterations)
+    {
+        mMechanicalIterationsBudget = 1.0f;
+        return;
+    }
+
+    //
+    // Trade stiffness for time quickly when we're over budget, 
+    // and give it back slowly when we're comfortably within it
+    //
+
+    if (shipsUpdateDuration > gameParameters.ShipsUpdateTimeBudget)
+    {
+        mMechanicalIterationsBudget = std::max(mMechanicalIterationsBudget * 0.9f, MinBudget);
+    }
+    else if (shipsUpdateDuration < gameParameters.ShipsUpdateTimeBudget * 3 / 4)
+    {
+        mMechanicalIterationsBudget = std::min(mMechanicalIterationsBudget * 1.02f, 1.0f);
+    }
+}
+
 void World::UpdateClouds(GameParameters const & gameParameters)
 {
     // Resize clouds vector
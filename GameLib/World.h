@@ -12,8 +12,10 @@
 #include "Physics.h"
 #include "RenderContext.h"
 #include "ShipDefinition.h"
+#include "TaskThreadPool.h"
 #include "Vectors.h"
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <set>
@@ -30,6 +32,13 @@ public:
         std::shared_ptr<IGameEventHandler> gameEventHandler,
         GameParameters const & gameParameters);
 
+    // Runs the tasks of ships on the specified number of threads, rather than
+    // on as many as there are hardware threads
+    World(
+        std::shared_ptr<IGameEventHandler> gameEventHandler,
+        GameParameters const & gameParameters,
+        size_t parallelism);
+
     int AddShip(
         ShipDefinition const & shipDefinition,
         MaterialDatabase const & materials,
@@ -47,11 +56,50 @@ public:
         return position.y < GetWaterHeightAt(position.x);
     }
     
+    inline void GetWaterHeightsAt(
+        ElementIndex pointStart,
+        ElementIndex pointEnd,
+        vec2f const * restrict pointPositionBuffer,
+        float * restrict heightBuffer) const
+    {
+        mWaterSurface.GetWaterHeightsAt(pointStart, pointEnd, pointPositionBuffer, heightBuffer);
+    }
+
     inline float GetOceanFloorHeightAt(float x) const
     {
         return mOceanFloor.GetFloorHeightAt(x);
     }
 
+    inline void GetOceanFloorHeightsAt(
+        ElementIndex pointStart,
+        ElementIndex pointEnd,
+        vec2f const * restrict pointPositionBuffer,
+        float * restrict heightBuffer) const
+    {
+        mOceanFloor.GetFloorHeightsAt(pointStart, pointEnd, pointPositionBuffer, heightBuffer);
+    }
+
+    inline float GetMaxOceanFloorHeightIn(
+        float minX,
+        float maxX) const
+    {
+        return mOceanFloor.GetMaxFloorHeightIn(minX, maxX);
+    }
+
+    inline TaskThreadPool & GetTaskThreadPool()
+    {
+        return mTaskThreadPool;
+    }
+
+    /*
+     * Gets the fraction of the nominal number of mechanical iterations that ships may run, 
+     * as governed by the time budget for updating all ships.
+     */
+    inline float GetMechanicalIterationsBudget() const
+    {
+        return mMechanicalIterationsBudget;
+    }
+
     void DestroyAt(
         vec2f const & targetPos, 
         float radius);
@@ -102,6 +150,10 @@ private:
 
     void UpdateClouds(GameParameters const & gameParameters);
 
+    void UpdateMechanicalIterationsBudget(
+        std::chrono::steady_clock::duration shipsUpdateDuration,
+        GameParameters const & gameParameters);
+
     void RenderClouds(Render::RenderContext & renderContext) const;
 
     void UploadLandAndWater(
@@ -125,6 +177,12 @@ private:
 
     // The game event handler
     std::shared_ptr<IGameEventHandler> mGameEventHandler;
+
+    // The pool of threads shared by all ships
+    TaskThreadPool mTaskThreadPool;
+
+    // The fraction of the nominal number of mechanical iterations that ships may run
+    float mMechanicalIterationsBudget;
 };
 
 }
@@ -0,0 +1,756 @@
+#include <GameLib/Algorithms.h>
+#include <GameLib/SysSpecifics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// Base of the tests that run a kernel with each of the instruction sets
+// they are parameterized with; skips the instruction sets this CPU does
+// not support
+class InstructionSetTest : public testing::TestWithParam<InstructionSet>
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        if (GetParam() > GetInstructionSet())
+        {
+            GTEST_SKIP() << InstructionSetToStr(GetParam()) << " is not supported by this CPU";
+        }
+    }
+};
+
+class UpdateSpringForcesTest : public InstructionSetTest
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        InstructionSetTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        std::mt19937 randomEngine(42);
+        std::uniform_real_distribution<float> positionDistribution(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> velocityDistribution(-5.0f, 5.0f);
+        std::uniform_real_distribution<float> coefficientDistribution(0.0f, 1000.0f);
+        std::uniform_int_distribution<ElementIndex> pointDistribution(0, PointCount - 1);
+
+        for (size_t p = 0; p < PointCount; ++p)
+        {
+            PointPositions.emplace_back(positionDistribution(randomEngine), positionDistribution(randomEngine));
+            PointVelocities.emplace_back(velocityDistribution(randomEngine), velocityDistribution(randomEngine));
+        }
+
+        // Make a coincident pair of points, to exercise zero-length springs
+        PointPositions[1] = PointPositions[0];
+
+        for (size_t s = 0; s < SpringCount; ++s)
+        {
+            ElementIndex const pointAIndex = (s == 3) ? 0 : pointDistribution(randomEngine);
+            ElementIndex const pointBIndex = (s == 3) ? 1 : pointDistribution(randomEngine);
+
+            SpringEndpoints.push_back(pointAIndex);
+            SpringEndpoints.push_back(pointBIndex);
+            SpringRestLengths.push_back((PointPositions[pointBIndex] - PointPositions[pointAIndex]).length() * 0.9f);
+            SpringStiffnessCoefficients.push_back(coefficientDistribution(randomEngine));
+            SpringDampingCoefficients.push_back(coefficientDistribution(randomEngine));
+        }
+    }
+
+    std::vector<vec2f> Run(
+        InstructionSet instructionSet,
+        ElementIndex springStart,
+        ElementIndex springEnd) const
+    {
+        std::vector<vec2f> pointForces(PointCount, vec2f::zero());
+
+        Algorithms::UpdateSpringForces(
+            instructionSet,
+            springStart,
+            springEnd,
+            SpringEndpoints.data(),
+            SpringRestLengths.data(),
+            SpringStiffnessCoefficients.data(),
+            SpringDampingCoefficients.data(),
+            PointPositions.data(),
+            PointVelocities.data(),
+            pointForces.data());
+
+        return pointForces;
+    }
+
+    // Not a multiple of any packet size, so that we exercise remainders
+    static constexpr size_t PointCount = 300;
+    static constexpr ElementIndex SpringCount = 1003;
+
+    std::vector<vec2f> PointPositions;
+    std::vector<vec2f> PointVelocities;
+    std::vector<ElementIndex> SpringEndpoints;
+    std::vector<float> SpringRestLengths;
+    std::vector<float> SpringStiffnessCoefficients;
+    std::vector<float> SpringDampingCoefficients;
+};
+
+INSTANTIATE_TEST_CASE_P(
+    AlgorithmsTests,
+    UpdateSpringForcesTest,
+    ::testing::Values(
+        InstructionSet::SSE2,
+        InstructionSet::AVX2,
+        InstructionSet::AVX512
+    ));
+
+TEST_P(UpdateSpringForcesTest, MatchesNaive)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    auto const expected = Run(InstructionSet::Scalar, 0, SpringCount);
+    auto const actual = Run(instructionSet, 0, SpringCount);
+
+    for (size_t p = 0; p < PointCount; ++p)
+    {
+        float const tolerance = 1e-4f * std::max(1.0f, expected[p].length());
+
+        EXPECT_NEAR(expected[p].x, actual[p].x, tolerance);
+        EXPECT_NEAR(expected[p].y, actual[p].y, tolerance);
+    }
+}
+
+TEST_P(UpdateSpringForcesTest, MatchesNaive_SubRange)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    auto const expected = Run(InstructionSet::Scalar, 5, 531);
+    auto const actual = Run(instructionSet, 5, 531);
+
+    for (size_t p = 0; p < PointCount; ++p)
+    {
+        float const tolerance = 1e-4f * std::max(1.0f, expected[p].length());
+
+        EXPECT_NEAR(expected[p].x, actual[p].x, tolerance);
+        EXPECT_NEAR(expected[p].y, actual[p].y, tolerance);
+    }
+}
+
+TEST(AlgorithmsTests, UpdateSpringForces_ZeroLengthSpringHasNoEffect)
+{
+    std::vector<vec2f> pointPositions(2, vec2f(3.0f, 4.0f));
+    std::vector<vec2f> pointVelocities = { vec2f(1.0f, 0.0f), vec2f(-1.0f, 2.0f) };
+    std::vector<vec2f> pointForces(2, vec2f::zero());
+
+    // Pad to a full packet for all instruction sets
+    std::vector<ElementIndex> springEndpoints;
+    for (int s = 0; s < 16; ++s)
+    {
+        springEndpoints.push_back(0);
+        springEndpoints.push_back(1);
+    }
+
+    std::vector<float> springRestLengths(16, 1.0f);
+    std::vector<float> springCoefficients(16, 100.0f);
+
+    Algorithms::UpdateSpringForces(
+        0,
+        16,
+        springEndpoints.data(),
+        springRestLengths.data(),
+        springCoefficients.data(),
+        springCoefficients.data(),
+        pointPositions.data(),
+        pointVelocities.data(),
+        pointForces.data());
+
+    EXPECT_EQ(vec2f::zero(), pointForces[0]);
+    EXPECT_EQ(vec2f::zero(), pointForces[1]);
+}
+
+class CalculateSpringGeometryTest : public InstructionSetTest
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        InstructionSetTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        std::mt19937 randomEngine(42);
+        std::uniform_real_distribution<float> positionDistribution(-10.0f, 10.0f);
+        std::uniform_int_distribution<ElementIndex> pointDistribution(0, PointCount - 1);
+
+        for (size_t p = 0; p < PointCount; ++p)
+        {
+            PointPositions.emplace_back(positionDistribution(randomEngine), positionDistribution(randomEngine));
+        }
+
+        // Make a coincident pair of points, to exercise zero-length springs
+        PointPositions[1] = PointPositions[0];
+
+        for (size_t s = 0; s < SpringCount; ++s)
+        {
+            SpringEndpoints.push_back((s == 3) ? 0 : pointDistribution(randomEngine));
+            SpringEndpoints.push_back((s == 3) ? 1 : pointDistribution(randomEngine));
+        }
+    }
+
+    void Run(
+        InstructionSet instructionSet,
+        std::vector<float> & springLengths,
+        std::vector<vec2f> & springNormalizedVectors,
+        MathQuality mathQuality = MathQuality::Accurate) const
+    {
+        springLengths.assign(SpringCount, -1.0f);
+        springNormalizedVectors.assign(SpringCount, vec2f(-1.0f, -1.0f));
+
+        Algorithms::CalculateSpringGeometry(
+            instructionSet,
+            0,
+            SpringCount,
+            SpringEndpoints.data(),
+            PointPositions.data(),
+            springLengths.data(),
+            springNormalizedVectors.data(),
+            mathQuality);
+    }
+
+    // Not a multiple of any packet size, so that we exercise remainders
+    static constexpr size_t PointCount = 300;
+    static constexpr ElementIndex SpringCount = 1003;
+
+    std::vector<vec2f> PointPositions;
+    std::vector<ElementIndex> SpringEndpoints;
+};
+
+INSTANTIATE_TEST_CASE_P(
+    AlgorithmsTests,
+    CalculateSpringGeometryTest,
+    ::testing::Values(
+        InstructionSet::SSE2,
+        InstructionSet::AVX2
+    ));
+
+TEST_P(CalculateSpringGeometryTest, MatchesNaive)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    std::vector<float> expectedLengths;
+    std::vector<vec2f> expectedNormalizedVectors;
+    Run(InstructionSet::Scalar, expectedLengths, expectedNormalizedVectors);
+
+    std::vector<float> actualLengths;
+    std::vector<vec2f> actualNormalizedVectors;
+    Run(instructionSet, actualLengths, actualNormalizedVectors);
+
+    for (size_t s = 0; s < SpringCount; ++s)
+    {
+        EXPECT_NEAR(expectedLengths[s], actualLengths[s], 1e-4f);
+        EXPECT_NEAR(expectedNormalizedVectors[s].x, actualNormalizedVectors[s].x, 1e-5f);
+        EXPECT_NEAR(expectedNormalizedVectors[s].y, actualNormalizedVectors[s].y, 1e-5f);
+    }
+
+    EXPECT_EQ(0.0f, actualLengths[3]);
+    EXPECT_EQ(vec2f::zero(), actualNormalizedVectors[3]);
+}
+
+TEST_P(CalculateSpringGeometryTest, FastMathIsCloseToAccurate)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    std::vector<float> expectedLengths;
+    std::vector<vec2f> expectedNormalizedVectors;
+    Run(InstructionSet::Scalar, expectedLengths, expectedNormalizedVectors);
+
+    for (InstructionSet fastInstructionSet : { InstructionSet::Scalar, instructionSet })
+    {
+        std::vector<float> actualLengths;
+        std::vector<vec2f> actualNormalizedVectors;
+        Run(fastInstructionSet, actualLengths, actualNormalizedVectors, MathQuality::Fast);
+
+        for (size_t s = 0; s < SpringCount; ++s)
+        {
+            EXPECT_NEAR(expectedLengths[s], actualLengths[s], expectedLengths[s] * 1e-6f);
+            EXPECT_NEAR(expectedNormalizedVectors[s].x, actualNormalizedVectors[s].x, 1e-6f);
+            EXPECT_NEAR(expectedNormalizedVectors[s].y, actualNormalizedVectors[s].y, 1e-6f);
+        }
+
+        EXPECT_EQ(0.0f, actualLengths[3]);
+        EXPECT_EQ(vec2f::zero(), actualNormalizedVectors[3]);
+    }
+}
+
+class CalculateSpringGeometryAndStrainsTest : public InstructionSetTest
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        InstructionSetTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        std::mt19937 randomEngine(42);
+        std::uniform_real_distribution<float> positionDistribution(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> restLengthFactorDistribution(0.5f, 1.5f);
+        std::uniform_real_distribution<float> strengthDistribution(0.01f, 0.8f);
+        std::uniform_int_distribution<ElementIndex> pointDistribution(0, PointCount - 1);
+
+        for (size_t p = 0; p < PointCount; ++p)
+        {
+            PointPositions.emplace_back(positionDistribution(randomEngine), positionDistribution(randomEngine));
+        }
+
+        for (size_t s = 0; s < SpringCount; ++s)
+        {
+            ElementIndex const pointAIndex = pointDistribution(randomEngine);
+            ElementIndex const pointBIndex = pointDistribution(randomEngine);
+
+            SpringEndpoints.push_back(pointAIndex);
+            SpringEndpoints.push_back(pointBIndex);
+            SpringRestLengths.push_back(
+                std::max((PointPositions[pointBIndex] - PointPositions[pointAIndex]).length(), 1.0f)
+                * restLengthFactorDistribution(randomEngine));
+            SpringStrengths.push_back(strengthDistribution(randomEngine));
+            SpringIsDeleted.push_back(s % 7 == 0);
+        }
+    }
+
+    void Run(
+        InstructionSet instructionSet,
+        std::vector<ElementIndex> & brokenSpringIndices,
+        std::vector<ElementIndex> & stressedSpringIndices,
+        float & maxRelativeStrain) const
+    {
+        std::vector<float> springLengths(SpringCount);
+        std::vector<vec2f> springNormalizedVectors(SpringCount);
+
+        brokenSpringIndices.assign(SpringCount, NoneElementIndex);
+        stressedSpringIndices.assign(SpringCount, NoneElementIndex);
+
+        ElementCount brokenSpringCount = 0;
+        ElementCount stressedSpringCount = 0;
+        maxRelativeStrain = 0.0f;
+
+        Algorithms::CalculateSpringGeometryAndStrains(
+            instructionSet,
+            0,
+            SpringCount,
+            SpringEndpoints.data(),
+            SpringRestLengths.data(),
+            SpringStrengths.data(),
+            reinterpret_cast<bool const *>(SpringIsDeleted.data()),
+            StrengthAdjustment,
+            PointPositions.data(),
+            springLengths.data(),
+            springNormalizedVectors.data(),
+            brokenSpringIndices.data(),
+            brokenSpringCount,
+            stressedSpringIndices.data(),
+            stressedSpringCount,
+            maxRelativeStrain);
+
+        brokenSpringIndices.resize(brokenSpringCount);
+        stressedSpringIndices.resize(stressedSpringCount);
+    }
+
+    // Not a multiple of any packet size, so that we exercise remainders
+    static constexpr size_t PointCount = 300;
+    static constexpr ElementIndex SpringCount = 1003;
+    static constexpr float StrengthAdjustment = 0.8f;
+
+    std::vector<vec2f> PointPositions;
+    std::vector<ElementIndex> SpringEndpoints;
+    std::vector<float> SpringRestLengths;
+    std::vector<float> SpringStrengths;
+    std::vector<unsigned char> SpringIsDeleted;
+};
+
+INSTANTIATE_TEST_CASE_P(
+    AlgorithmsTests,
+    CalculateSpringGeometryAndStrainsTest,
+    ::testing::Values(
+        InstructionSet::Scalar,
+        InstructionSet::SSE2,
+        InstructionSet::AVX2
+    ));
+
+TEST_P(CalculateSpringGeometryAndStrainsTest, CollectsBrokenAndStressedSprings)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    std::vector<ElementIndex> actualBrokenSpringIndices;
+    std::vector<ElementIndex> actualStressedSpringIndices;
+    float actualMaxRelativeStrain;
+    Run(instructionSet, actualBrokenSpringIndices, actualStressedSpringIndices, actualMaxRelativeStrain);
+
+    //
+    // Classify the springs ourselves
+    //
+
+    std::vector<ElementIndex> expectedBrokenSpringIndices;
+    std::vector<ElementIndex> expectedStressedSpringIndices;
+    float expectedMaxRelativeStrain = 0.0f;
+    size_t fineSpringCount = 0;
+
+    for (ElementIndex s = 0; s < SpringCount; ++s)
+    {
+        if (SpringIsDeleted[s])
+            continue;
+
+        float const length = (PointPositions[SpringEndpoints[s * 2 + 1]] - PointPositions[SpringEndpoints[s * 2]]).length();
+        float const strain = std::fabs(SpringRestLengths[s] - length) / SpringRestLengths[s];
+        float const effectiveStrength = StrengthAdjustment * SpringStrengths[s];
+
+        expectedMaxRelativeStrain = std::max(expectedMaxRelativeStrain, strain / effectiveStrength);
+
+        if (strain > effectiveStrength)
+            expectedBrokenSpringIndices.push_back(s);
+        else if (strain > 0.5f * effectiveStrength)
+            expectedStressedSpringIndices.push_back(s);
+        else
+            ++fineSpringCount;
+    }
+
+    // Make sure we exercise all cases
+    ASSERT_FALSE(expectedBrokenSpringIndices.empty());
+    ASSERT_FALSE(expectedStressedSpringIndices.empty());
+    ASSERT_GT(fineSpringCount, 0u);
+
+    EXPECT_EQ(expectedBrokenSpringIndices, actualBrokenSpringIndices);
+    EXPECT_EQ(expectedStressedSpringIndices, actualStressedSpringIndices);
+    EXPECT_NEAR(expectedMaxRelativeStrain, actualMaxRelativeStrain, expectedMaxRelativeStrain * 1e-5f);
+}
+
+class CalculateSpringOutboundWaterVelocitiesTest : public InstructionSetTest
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        InstructionSetTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        std::mt19937 randomEngine(42);
+        std::uniform_real_distribution<float> positionDistribution(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> waterDistribution(0.0f, 3.0f);
+        std::uniform_real_distribution<float> velocityDistribution(-5.0f, 5.0f);
+        std::uniform_int_distribution<ElementIndex> pointDistribution(0, PointCount - 1);
+
+        for (size_t p = 0; p < PointCount; ++p)
+        {
+            PointPositions.emplace_back(positionDistribution(randomEngine), positionDistribution(randomEngine));
+            PointWaters.push_back(waterDistribution(randomEngine));
+            PointWaterVelocities.emplace_back(velocityDistribution(randomEngine), velocityDistribution(randomEngine));
+        }
+
+        for (size_t s = 0; s < SpringCount; ++s)
+        {
+            ElementIndex const pointAIndex = pointDistribution(randomEngine);
+            ElementIndex const pointBIndex = pointDistribution(randomEngine);
+
+            SpringEndpoints.push_back(pointAIndex);
+            SpringEndpoints.push_back(pointBIndex);
+            SpringNormalizedVectors.push_back((PointPositions[pointBIndex] - PointPositions[pointAIndex]).normalise());
+        }
+    }
+
+    void Run(
+        InstructionSet instructionSet,
+        std::vector<float> & springOutboundWaterVelocitiesAToB,
+        std::vector<float> & springOutboundWaterVelocitiesBToA) const
+    {
+        springOutboundWaterVelocitiesAToB.assign(SpringCount, -1.0f);
+        springOutboundWaterVelocitiesBToA.assign(SpringCount, -1.0f);
+
+        Algorithms::CalculateSpringOutboundWaterVelocities(
+            instructionSet,
+            0,
+            SpringCount,
+            SpringEndpoints.data(),
+            SpringNormalizedVectors.data(),
+            PointPositions.data(),
+            PointWaters.data(),
+            PointWaterVelocities.data(),
+            0.7f,
+            9.8f,
+            springOutboundWaterVelocitiesAToB.data(),
+            springOutboundWaterVelocitiesBToA.data());
+    }
+
+    // Not a multiple of any packet size, so that we exercise remainders
+    static constexpr size_t PointCount = 300;
+    static constexpr ElementIndex SpringCount = 1003;
+
+    std::vector<vec2f> PointPositions;
+    std::vector<float> PointWaters;
+    std::vector<vec2f> PointWaterVelocities;
+    std::vector<ElementIndex> SpringEndpoints;
+    std::vector<vec2f> SpringNormalizedVectors;
+};
+
+INSTANTIATE_TEST_CASE_P(
+    AlgorithmsTests,
+    CalculateSpringOutboundWaterVelocitiesTest,
+    ::testing::Values(
+        InstructionSet::Scalar,
+        InstructionSet::SSE2,
+        InstructionSet::AVX2
+    ));
+
+TEST_P(CalculateSpringOutboundWaterVelocitiesTest, MatchesPointCentricFormulation)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    std::vector<float> actualAToB;
+    std::vector<float> actualBToA;
+    Run(instructionSet, actualAToB, actualBToA);
+
+    // The velocity leaving a point along a spring, as calculated by visiting the point
+    auto const calculateOutboundVelocity = [this](ElementIndex pointIndex, ElementIndex otherEndpointIndex)
+    {
+        vec2f const springNormalizedVector = (PointPositions[otherEndpointIndex] - PointPositions[pointIndex]).normalise();
+        float const dwy =
+            (PointWaters[pointIndex] - PointWaters[otherEndpointIndex])
+            + (PointPositions[pointIndex].y - PointPositions[otherEndpointIndex].y);
+        float const bernoulliVelocity = (dwy >= 0.0f) ? sqrtf(2.0f * 9.8f * dwy) : -sqrtf(2.0f * 9.8f * -dwy);
+        float const alphaCrazyness = 1.0f + 0.7f * (PointWaters[pointIndex] - 1.0f);
+
+        return std::max(
+            PointWaterVelocities[pointIndex].dot(springNormalizedVector) + bernoulliVelocity * alphaCrazyness,
+            0.0f);
+    };
+
+    for (ElementIndex s = 0; s < SpringCount; ++s)
+    {
+        ElementIndex const pointAIndex = SpringEndpoints[s * 2];
+        ElementIndex const pointBIndex = SpringEndpoints[s * 2 + 1];
+
+        EXPECT_NEAR(calculateOutboundVelocity(pointAIndex, pointBIndex), actualAToB[s], 1e-4f);
+        EXPECT_NEAR(calculateOutboundVelocity(pointBIndex, pointAIndex), actualBToA[s], 1e-4f);
+    }
+}
+
+class CalculateLeakingPointWaterInflowsTest : public InstructionSetTest
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        InstructionSetTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        std::mt19937 randomEngine(42);
+        std::uniform_real_distribution<float> positionDistribution(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> waterDistribution(0.0f, 3.0f);
+        std::uniform_int_distribution<ElementIndex> pointDistribution(0, PointCount - 1);
+
+        for (size_t p = 0; p < PointCount; ++p)
+        {
+            PointPositions.emplace_back(positionDistribution(randomEngine), positionDistribution(randomEngine));
+            PointWaterSurfaceHeights.push_back(positionDistribution(randomEngine));
+            PointWaters.push_back(waterDistribution(randomEngine));
+        }
+
+        // Points that are dry and above the water
+        PointWaters[0] = 0.0f;
+        PointPositions[0].y = PointWaterSurfaceHeights[0] + 1.0f;
+
+        LeakingPoints.push_back(0);
+        for (size_t l = 1; l < LeakingPointCount; ++l)
+        {
+            LeakingPoints.push_back(pointDistribution(randomEngine));
+        }
+    }
+
+    std::vector<float> Run(InstructionSet instructionSet) const
+    {
+        std::vector<float> inflows(LeakingPointCount, -1.0f);
+
+        Algorithms::CalculateLeakingPointWaterInflows(
+            instructionSet,
+            LeakingPoints.data(),
+            static_cast<ElementCount>(LeakingPointCount),
+            PointPositions.data(),
+            PointWaterSurfaceHeights.data(),
+            PointWaters.data(),
+            0.02f,
+            1.5f,
+            9.8f,
+            inflows.data());
+
+        return inflows;
+    }
+
+    static constexpr size_t PointCount = 300;
+
+    // Not a multiple of any packet size, so that we exercise remainders
+    static constexpr size_t LeakingPointCount = 103;
+
+    std::vector<vec2f> PointPositions;
+    std::vector<float> PointWaterSurfaceHeights;
+    std::vector<float> PointWaters;
+    std::vector<ElementIndex> LeakingPoints;
+};
+
+INSTANTIATE_TEST_CASE_P(
+    AlgorithmsTests,
+    CalculateLeakingPointWaterInflowsTest,
+    ::testing::Values(
+        InstructionSet::SSE2,
+        InstructionSet::AVX2
+    ));
+
+TEST_P(CalculateLeakingPointWaterInflowsTest, MatchesNaive)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    auto const expected = Run(InstructionSet::Scalar);
+    auto const actual = Run(instructionSet);
+
+    for (size_t l = 0; l < LeakingPointCount; ++l)
+    {
+        EXPECT_NEAR(expected[l], actual[l], 1e-5f);
+    }
+
+    EXPECT_EQ(0.0f, actual[0]);
+}
+
+TEST(AlgorithmsTests, CalculateLeakingPointWaterInflows_DoesNotOverDrain)
+{
+    // A point full of water, high above the water surface
+    std::vector<vec2f> pointPositions = { vec2f(0.0f, 100.0f) };
+    std::vector<float> pointWaterSurfaceHeights = { 0.0f };
+    std::vector<float> pointWaters = { 0.01f };
+    std::vector<ElementIndex> leakingPoints = { 0 };
+    float inflow = 0.0f;
+
+    Algorithms::CalculateLeakingPointWaterInflows(
+        InstructionSet::Scalar,
+        leakingPoints.data(),
+        1,
+        pointPositions.data(),
+        pointWaterSurfaceHeights.data(),
+        pointWaters.data(),
+        1.0f,
+        1.0f,
+        9.8f,
+        &inflow);
+
+    EXPECT_FLOAT_EQ(-0.01f * 0.95f, inflow);
+}
+
+class SampleHeightFieldTest : public InstructionSetTest
+{
+protected:
+
+    virtual void SetUp() override
+    {
+        InstructionSetTest::SetUp();
+        if (IsSkipped())
+            return;
+
+        for (ElementCount s = 0; s < SamplesCount; ++s)
+        {
+            Samples.push_back(std::sin(static_cast<float>(s) * 0.1f) * 5.0f + static_cast<float>(s % 7));
+        }
+
+        // The extra sample
+        Samples.push_back(Samples[0]);
+
+        std::mt19937 randomEngine(42);
+        std::uniform_real_distribution<float> positionDistribution(-1000.0f, 1000.0f);
+
+        for (size_t p = 0; p < PointCount; ++p)
+        {
+            PointPositions.emplace_back(positionDistribution(randomEngine), positionDistribution(randomEngine));
+        }
+
+        // Exercise the boundaries
+        PointPositions[0] = vec2f(0.0f, 0.0f);
+        PointPositions[1] = vec2f(-Dx, 0.0f);
+        PointPositions[2] = vec2f(Dx * SamplesCount, 0.0f);
+        PointPositions[3] = vec2f(-Dx * SamplesCount, 0.0f);
+        PointPositions[4] = vec2f(-0.5f * Dx, 0.0f);
+    }
+
+    std::vector<float> Run(InstructionSet instructionSet) const
+    {
+        std::vector<float> heights(PointCount, 0.0f);
+
+        Algorithms::SampleHeightField(
+            instructionSet,
+            Samples.data(),
+            SamplesCount,
+            Dx,
+            0,
+            static_cast<ElementIndex>(PointCount),
+            PointPositions.data(),
+            heights.data());
+
+        return heights;
+    }
+
+    static constexpr ElementCount SamplesCount = 512;
+    static constexpr float Dx = 0.7f;
+
+    // Not a multiple of any packet size, so that we exercise remainders
+    static constexpr size_t PointCount = 1003;
+
+    std::vector<float> Samples;
+    std::vector<vec2f> PointPositions;
+};
+
+INSTANTIATE_TEST_CASE_P(
+    AlgorithmsTests,
+    SampleHeightFieldTest,
+    ::testing::Values(
+        InstructionSet::SSE2,
+        InstructionSet::AVX2
+    ));
+
+TEST_P(SampleHeightFieldTest, MatchesNaive)
+{
+    InstructionSet const instructionSet = GetParam();
+
+    auto const expected = Run(InstructionSet::Scalar);
+    auto const actual = Run(instructionSet);
+
+    for (size_t p = 0; p < PointCount; ++p)
+    {
+        EXPECT_NEAR(expected[p], actual[p], 1e-4f);
+    }
+}
+
+TEST(AlgorithmsTests, SampleHeightField_Interpolates)
+{
+    std::vector<float> samples = { 0.0f, 10.0f, 20.0f, 30.0f, 0.0f };
+    std::vector<vec2f> pointPositions = {
+        vec2f(0.0f, 0.0f),
+        vec2f(1.5f, 0.0f),
+        vec2f(3.5f, 0.0f),
+        vec2f(-0.5f, 0.0f),
+        vec2f(4.25f, 0.0f) };
+    std::vector<float> heights(pointPositions.size(), 0.0f);
+
+    Algorithms::SampleHeightField(
+        InstructionSet::Scalar,
+        samples.data(),
+        4,
+        1.0f,
+        0,
+        static_cast<ElementIndex>(pointPositions.size()),
+        pointPositions.data(),
+        heights.data());
+
+    EXPECT_FLOAT_EQ(0.0f, heights[0]);
+    EXPECT_FLOAT_EQ(15.0f, heights[1]);
+    EXPECT_FLOAT_EQ(15.0f, heights[2]);
+    EXPECT_FLOAT_EQ(15.0f, heights[3]);
+    EXPECT_FLOAT_EQ(2.5f, heights[4]);
+}
@@ -0,0 +1,128 @@
+#include <GameLib/FastMath.h>
+#include <GameLib/SysSpecifics.h>
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+    float MakeFloat(std::uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(float));
+        return value;
+    }
+
+    TARGET_AVX2
+    void FastExp_AVX2(float const * x, float * result)
+    {
+        _mm256_storeu_ps(result, FastExp(_mm256_loadu_ps(x)));
+    }
+
+    TARGET_AVX2
+    void FastInverseSqrt_AVX2(float const * x, float * result)
+    {
+        _mm256_storeu_ps(result, FastInverseSqrt(_mm256_loadu_ps(x)));
+    }
+}
+
+TEST(FastMathTests, InverseSqrt_MaxRelativeError)
+{
+    double maxRelativeError = 0.0;
+
+    // Sample the whole range of positive normalized floats
+    for (std::uint32_t bits = 0x00800000u; bits < 0x7f800000u; bits += 997u)
+    {
+        float const x = MakeFloat(bits);
+
+        double const relativeError = std::abs(
+            static_cast<double>(FastInverseSqrt(x)) * std::sqrt(static_cast<double>(x)) - 1.0);
+
+        maxRelativeError = std::max(maxRelativeError, relativeError);
+    }
+
+    EXPECT_LT(maxRelativeError, 5.0e-7);
+}
+
+TEST(FastMathTests, Sqrt_MaxRelativeError)
+{
+    double maxRelativeError = 0.0;
+
+    for (std::uint32_t bits = 0x00800000u; bits < 0x7f800000u; bits += 997u)
+    {
+        float const x = MakeFloat(bits);
+
+        double const relativeError = std::abs(
+            static_cast<double>(FastSqrt(x)) / std::sqrt(static_cast<double>(x)) - 1.0);
+
+        maxRelativeError = std::max(maxRelativeError, relativeError);
+    }
+
+    EXPECT_LT(maxRelativeError, 5.0e-7);
+}
+
+TEST(FastMathTests, Sqrt_Zero)
+{
+    EXPECT_EQ(0.0f, FastSqrt(0.0f));
+}
+
+TEST(FastMathTests, Exp_MaxRelativeError)
+{
+    double maxRelativeError = 0.0;
+
+    for (double x = -87.3; x <= 88.3; x += 0.0001)
+    {
+        float const xf = static_cast<float>(x);
+
+        double const relativeError = std::abs(
+            static_cast<double>(FastExp(xf)) / std::exp(static_cast<double>(xf)) - 1.0);
+
+        maxRelativeError = std::max(maxRelativeError, relativeError);
+    }
+
+    EXPECT_LT(maxRelativeError, 2.0e-7);
+}
+
+TEST(FastMathTests, Exp_Exact)
+{
+    EXPECT_EQ(1.0f, FastExp(0.0f));
+}
+
+TEST(FastMathTests, Exp_ClampsOutOfRangeArguments)
+{
+    float const tiny = FastExp(-1000.0f);
+    EXPECT_GT(tiny, 0.0f);
+    EXPECT_LT(tiny, 1.3e-38f);
+
+    float const huge = FastExp(1000.0f);
+    EXPECT_FALSE(std::isinf(huge));
+    EXPECT_GT(huge, 2.0e+38f);
+}
+
+TEST(FastMathTests, AVX2_MatchesSSE)
+{
+    if (InstructionSet::AVX2 > GetInstructionSet())
+    {
+        // Not supported by this CPU
+        return;
+    }
+
+    float const x[8] = { -50.0f, -3.3f, -0.1f, 0.0f, 0.2f, 1.0f, 7.5f, 60.0f };
+    float const positiveX[8] = { 1.0e-30f, 0.001f, 0.5f, 1.0f, 2.0f, 3.0f, 1000.0f, 1.0e+30f };
+
+    float expResults[8];
+    FastExp_AVX2(x, expResults);
+
+    float inverseSqrtResults[8];
+    FastInverseSqrt_AVX2(positiveX, inverseSqrtResults);
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(FastExp(x[i]), expResults[i]);
+        EXPECT_EQ(FastInverseSqrt(positiveX[i]), inverseSqrtResults[i]);
+    }
+}
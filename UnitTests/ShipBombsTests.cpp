@@ -0,0 +1,106 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ShipBombsTests : public testing::Test
+{
+protected:
+
+    static constexpr float Altitude = 100.0f;
+
+    static GameParameters MakeGameParameters()
+    {
+        GameParameters gameParameters;
+        gameParameters.BombBlastRadius = 4.0f;
+
+        return gameParameters;
+    }
+
+    // Detonates a bomb at the specified position, left of the specified x, and checks that the
+    // explosion moves points left of that x while points right of it move as if nothing happened
+    static void ExpectExplosionOnlyOnLeft(
+        std::vector<std::string> const & rows,
+        std::function<void(TestWorld &, Physics::Ship &)> const & prepareShip,
+        vec2f const & bombPosition,
+        float leftEndX)
+    {
+        auto const gameParameters = MakeGameParameters();
+
+        // The same ship, without bombs
+        TestWorld referenceTestWorld(gameParameters);
+        auto referenceShip = referenceTestWorld.MakeShip(rows, vec2f(0.0f, Altitude));
+        prepareShip(referenceTestWorld, *referenceShip);
+
+        TestWorld testWorld(gameParameters);
+        auto ship = testWorld.MakeShip(rows, vec2f(0.0f, Altitude));
+        prepareShip(testWorld, *ship);
+
+        ASSERT_TRUE(ship->ToggleRCBombAt(bombPosition, gameParameters));
+        ship->DetonateRCBombs();
+
+        // The explosion follows the wall clock; run until well after it has started
+        bool hasExploded = false;
+        int stepsAfterExplosionCount = 0;
+        for (int s = 0; s < 300 && stepsAfterExplosionCount < 25; ++s)
+        {
+            if (hasExploded)
+                ++stepsAfterExplosionCount;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+            referenceTestWorld.UpdateShip(*referenceShip, 1);
+            testWorld.UpdateShip(*ship, 1);
+
+            auto const referencePositions = GetPointPositions(*referenceShip);
+            auto const positions = GetPointPositions(*ship);
+            for (ElementIndex p = 0; p < positions.size(); ++p)
+            {
+                if (referencePositions[p].x > leftEndX)
+                    ASSERT_EQ(referencePositions[p], positions[p]) << "point " << p << " at step " << s;
+                else if (referencePositions[p] != positions[p])
+                    hasExploded = true;
+            }
+        }
+
+        EXPECT_TRUE(hasExploded);
+    }
+};
+
+TEST_F(ShipBombsTests, ExplosionOnlyReachesItsConnectedComponent)
+{
+    // Two blocks with a one point wide gap in between, hence never connected
+    ExpectExplosionOnlyOnLeft(
+        std::vector<std::string>(6, std::string("HHHH.HHHH")),
+        [](TestWorld & /*testWorld*/, Physics::Ship & ship)
+        {
+            ASSERT_EQ(2u, CountConnectedComponentIds(ship));
+        },
+        vec2f(-1.0f, Altitude + 3.0f),
+        0.0f);
+}
+
+TEST_F(ShipBombsTests, ExplosionOnlyReachesItsSplitOffConnectedComponent)
+{
+    // A block cut in two, leaving a smaller block on the left
+    ExpectExplosionOnlyOnLeft(
+        std::vector<std::string>(6, std::string(12, 'H')),
+        [](TestWorld & testWorld, Physics::Ship & ship)
+        {
+            for (int y = 0; y < 6; ++y)
+            {
+                ship.DestroyAt(vec2f(-2.0f, Altitude + static_cast<float>(y)), 0.6f);
+            }
+
+            testWorld.UpdateShip(ship, 1);
+
+            ASSERT_EQ(2u, CountConnectedComponentIds(ship));
+        },
+        vec2f(-3.0f, Altitude + 3.0f),
+        -2.0f);
+}
@@ -0,0 +1,79 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+class ShipConnectedComponentsTests : public testing::Test
+{
+protected:
+
+    static constexpr float Altitude = 50.0f;
+
+    // Two blocks joined by a bridge that is one point high and four points long
+    static std::vector<std::string> MakeBridgedBlocksRows()
+    {
+        return std::vector<std::string>({
+            "HHHH....HHHH",
+            "HHHHHHHHHHHH",
+            "HHHH....HHHH" });
+    }
+
+    // The position of the point at the specified column of the bridge
+    static vec2f GetBridgePosition(float column)
+    {
+        return vec2f(-6.0f + column, Altitude + 1.0f);
+    }
+};
+
+TEST_F(ShipConnectedComponentsTests, SplitsWhenAdjacentPointsAreDestroyedTogether)
+{
+    TestWorld testWorld((GameParameters()));
+
+    auto ship = testWorld.MakeShip(MakeBridgedBlocksRows(), vec2f(0.0f, Altitude));
+
+    ASSERT_EQ(1u, CountConnectedComponents(*ship));
+    ASSERT_EQ(1u, CountConnectedComponentIds(*ship));
+
+    // Between the middle two points of the bridge, reaching neither of its ends
+    ship->DestroyAt(GetBridgePosition(5.5f), 0.6f);
+
+    testWorld.UpdateShip(*ship, 1);
+
+    EXPECT_EQ(2u, CountConnectedComponents(*ship));
+    EXPECT_EQ(2u, CountConnectedComponentIds(*ship));
+}
+
+TEST_F(ShipConnectedComponentsTests, SplitsWhenAdjacentPointsAreDestroyedOneByOne)
+{
+    TestWorld testWorld((GameParameters()));
+
+    auto ship = testWorld.MakeShip(MakeBridgedBlocksRows(), vec2f(0.0f, Altitude));
+
+    ElementIndex const firstPointIndex = FindPointAt(*ship, GetBridgePosition(5.0f));
+    ElementIndex const secondPointIndex = FindPointAt(*ship, GetBridgePosition(6.0f));
+
+    ship->GetPoints().Destroy(firstPointIndex);
+    ship->GetPoints().Destroy(secondPointIndex);
+
+    testWorld.UpdateShip(*ship, 1);
+
+    EXPECT_EQ(2u, CountConnectedComponents(*ship));
+    EXPECT_EQ(2u, CountConnectedComponentIds(*ship));
+}
+
+TEST_F(ShipConnectedComponentsTests, DoesNotSplitWhenPointsStayConnected)
+{
+    TestWorld testWorld((GameParameters()));
+
+    auto ship = testWorld.MakeShip(MakeBridgedBlocksRows(), vec2f(0.0f, Altitude));
+
+    // The middle of the left block
+    ship->DestroyAt(vec2f(-4.5f, Altitude + 1.0f), 0.6f);
+
+    testWorld.UpdateShip(*ship, 1);
+
+    EXPECT_EQ(1u, CountConnectedComponents(*ship));
+    EXPECT_EQ(1u, CountConnectedComponentIds(*ship));
+}
@@ -0,0 +1,110 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class ShipElectricalDynamicsTests : public testing::Test
+{
+protected:
+
+    static GameParameters MakeGameParameters()
+    {
+        GameParameters gameParameters;
+        gameParameters.WaveHeight = 0.0f;
+        gameParameters.ElectricalDynamicsUpdatePeriod = 1;
+
+        return gameParameters;
+    }
+
+    // A generator powering a lamp via a cable, with the cable's
+    // middle at x=0 and the bottom row at the specified altitude
+    static std::unique_ptr<Physics::Ship> MakeWiredShip(
+        TestWorld & testWorld,
+        float altitude)
+    {
+        return testWorld.MakeShip(
+            std::vector<std::string>({
+                "IIIIIIIIIIII",
+                "IIIIIIIIIIII",
+                "IIIIIIIIIIII",
+                "IIIIIIIIIIII",
+                "GCCCCCCCCCCL" }),
+            vec2f(0.0f, altitude));
+    }
+
+    static float GetLampCurrent(Physics::Ship const & ship)
+    {
+        auto const & electricalElements = ship.GetElectricalElements();
+
+        EXPECT_EQ(1u, electricalElements.GetLamps().size());
+
+        return electricalElements.GetAvailableCurrent(electricalElements.GetLamps()[0]);
+    }
+};
+
+TEST_F(ShipElectricalDynamicsTests, LampStaysOnWhileWiringIsIntact)
+{
+    TestWorld testWorld(MakeGameParameters());
+
+    auto ship = MakeWiredShip(testWorld, 100.0f);
+
+    for (int s = 0; s < 50; ++s)
+    {
+        testWorld.UpdateShip(*ship, 1);
+        ASSERT_EQ(1.0f, GetLampCurrent(*ship)) << "at step " << s;
+    }
+
+    // Not part of the wiring
+    ship->DestroyAt(vec2f(0.0f, 104.0f), 0.6f);
+
+    for (int s = 0; s < 50; ++s)
+    {
+        testWorld.UpdateShip(*ship, 1);
+        ASSERT_EQ(1.0f, GetLampCurrent(*ship)) << "at step " << s;
+    }
+}
+
+TEST_F(ShipElectricalDynamicsTests, LampGoesOffWhenCableIsCut)
+{
+    TestWorld testWorld(MakeGameParameters());
+
+    auto ship = MakeWiredShip(testWorld, 100.0f);
+
+    testWorld.UpdateShip(*ship, 10);
+    ASSERT_EQ(1.0f, GetLampCurrent(*ship));
+
+    ship->DestroyAt(vec2f(0.0f, 100.0f), 0.6f);
+
+    testWorld.UpdateShip(*ship, 1);
+    EXPECT_EQ(0.0f, GetLampCurrent(*ship));
+}
+
+TEST_F(ShipElectricalDynamicsTests, LampGoesOffWhenGeneratorGetsWet)
+{
+    TestWorld testWorld(MakeGameParameters());
+
+    // The generator, on the bottom row, is leaking under water
+    auto ship = MakeWiredShip(testWorld, -1.0f);
+
+    testWorld.UpdateShip(*ship, 1);
+    ASSERT_EQ(1.0f, GetLampCurrent(*ship));
+
+    ElementIndex const generatorPointIndex = ship->GetElectricalElements().GetPointIndex(
+        ship->GetElectricalElements().GetGenerators()[0]);
+
+    bool isLampOff = false;
+    for (int s = 0; s < 500 && !isLampOff; ++s)
+    {
+        testWorld.UpdateShip(*ship, 1);
+
+        if (ship->GetPoints().GetWater(generatorPointIndex) < 0.3f)
+            ASSERT_EQ(1.0f, GetLampCurrent(*ship)) << "at step " << s;
+        else
+            isLampOff = (0.0f == GetLampCurrent(*ship));
+    }
+
+    EXPECT_TRUE(isLampOff);
+}
@@ -0,0 +1,82 @@
+#include "ShipTestUtils.h"
+
+#include <GameLib/ForceFields.h>
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+TEST(ShipForceFieldsTests, RadialSpaceWarpOnlyReachesItsRing)
+{
+    Physics::RadialSpaceWarpForceField const field(vec2f(10.0f, 0.0f), 20.0f, 5.0f, 1000.0f);
+
+    EXPECT_FALSE(Physics::RadialSpaceWarpForceField::ReachesEverywhere);
+
+    EXPECT_FALSE(field.MayAffect(vec2f(10.0f, 0.0f), 1.0f));
+    EXPECT_FALSE(field.MayAffect(vec2f(23.0f, 0.0f), 1.0f));
+    EXPECT_TRUE(field.MayAffect(vec2f(24.5f, 0.0f), 1.0f));
+    EXPECT_TRUE(field.MayAffect(vec2f(10.0f, 20.0f), 1.0f));
+    EXPECT_TRUE(field.MayAffect(vec2f(35.5f, 0.0f), 1.0f));
+    EXPECT_FALSE(field.MayAffect(vec2f(36.5f, 0.0f), 1.0f));
+}
+
+TEST(ShipForceFieldsTests, BlastOnlyReachesItsRadius)
+{
+    Physics::BlastForceField const field(vec2f(0.0f, 0.0f), 2.5f, 1000.0f);
+
+    EXPECT_FALSE(Physics::BlastForceField::ReachesEverywhere);
+
+    EXPECT_TRUE(field.MayAffect(vec2f(0.0f, 3.0f), 1.0f));
+    EXPECT_FALSE(field.MayAffect(vec2f(0.0f, 4.0f), 1.0f));
+}
+
+TEST(ShipForceFieldsTests, BlastPushesAwayPointsWithinItsRadius)
+{
+    Physics::BlastForceField const field(vec2f(10.0f, 0.0f), 2.5f, 1000.0f);
+
+    std::vector<vec2f> const positions{
+        vec2f(11.0f, 0.0f),
+        vec2f(10.0f, -2.0f),
+        vec2f(7.0f, 0.0f),
+        vec2f(10.0f, 0.0f) };
+
+    std::vector<vec2f> forces(positions.size(), vec2f::zero());
+
+    field.Apply(0, static_cast<ElementIndex>(positions.size()), positions.data(), forces.data());
+
+    // Away from the center, harder when closer
+    EXPECT_GT(forces[0].x, 0.0f);
+    EXPECT_FLOAT_EQ(0.0f, forces[0].y);
+    EXPECT_FLOAT_EQ(0.0f, forces[1].x);
+    EXPECT_LT(forces[1].y, 0.0f);
+    EXPECT_GT(forces[0].length(), forces[1].length());
+
+    // Nothing beyond the radius, nor at the center
+    EXPECT_EQ(vec2f::zero(), forces[2]);
+    EXPECT_EQ(vec2f::zero(), forces[3]);
+}
+
+TEST(ShipForceFieldsTests, DrawPullsTheWholeShip)
+{
+    GameParameters gameParameters;
+    gameParameters.WaveHeight = 0.0f;
+
+    TestWorld testWorld(gameParameters);
+
+    auto ship = testWorld.MakeShip(
+        std::vector<std::string>(4, std::string(8, 'H')),
+        vec2f(0.0f, 20.0f));
+
+    auto const initialPositions = GetPointPositions(*ship);
+
+    // Draw towards a target far to the right of the ship
+    ship->DrawTo(vec2f(100.0f, 20.0f), 50000.0f);
+    testWorld.UpdateShip(*ship, 1);
+
+    auto const positions = GetPointPositions(*ship);
+    for (size_t p = 0; p < positions.size(); ++p)
+    {
+        EXPECT_GT(positions[p].x, initialPositions[p].x);
+    }
+}
@@ -0,0 +1,160 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ShipLightDiffusionTests : public testing::Test
+{
+protected:
+
+    static constexpr int Width = 64;
+    static constexpr float Altitude = 100.0f;
+
+    static GameParameters MakeGameParameters(float lightDiffusionAdjustment)
+    {
+        GameParameters gameParameters;
+        gameParameters.ElectricalDynamicsUpdatePeriod = 1;
+        gameParameters.LightDiffusionAdjustment = lightDiffusionAdjustment;
+
+        return gameParameters;
+    }
+
+    // A generator powering lamps along a wide ship, farther from each other than
+    // the distance at which their light becomes invisible
+    static std::unique_ptr<Physics::Ship> MakeLitShip(TestWorld & testWorld)
+    {
+        std::string wiring(Width, 'C');
+        wiring[0] = 'G';
+        wiring[2] = 'L';
+        wiring[Width - 1] = 'L';
+
+        std::vector<std::string> rows(8, std::string(Width, 'I'));
+        rows[4] = wiring;
+
+        return testWorld.MakeShip(rows, vec2f(0.0f, Altitude));
+    }
+
+    // The light of each point, calculated by visiting all lamps for each point
+    static std::vector<float> CalculateExpectedLights(
+        Physics::Ship const & ship,
+        float lightDiffusionAdjustment)
+    {
+        auto const & points = ship.GetPoints();
+        auto const & electricalElements = ship.GetElectricalElements();
+
+        float const adjustmentCoefficient = (1.0f - lightDiffusionAdjustment) * (1.0f - lightDiffusionAdjustment);
+
+        std::vector<float> lights(points.GetElementCount(), 0.0f);
+        for (ElementIndex p = 0; p < points.GetElementCount(); ++p)
+        {
+            if (points.IsDeleted(p))
+                continue;
+
+            for (auto lampIndex : electricalElements.GetLamps())
+            {
+                ElementIndex const lampPointIndex = electricalElements.GetPointIndex(lampIndex);
+                if (points.IsDeleted(lampPointIndex)
+                    || points.GetConnectedComponentId(lampPointIndex) != points.GetConnectedComponentId(p))
+                {
+                    continue;
+                }
+
+                float const squareDistance = std::max(
+                    1.0f,
+                    (points.GetPosition(p) - points.GetPosition(lampPointIndex)).squareLength() * adjustmentCoefficient);
+
+                lights[p] = std::max(
+                    lights[p],
+                    electricalElements.GetAvailableCurrent(lampIndex) / squareDistance);
+            }
+        }
+
+        return lights;
+    }
+
+    static void ExpectLights(
+        Physics::Ship const & ship,
+        float lightDiffusionAdjustment)
+    {
+        // The light below which points are left dark
+        static constexpr float VisibilityEpsilon = 0.01f;
+
+        auto const expectedLights = CalculateExpectedLights(ship, lightDiffusionAdjustment);
+
+        size_t litPointsCount = 0;
+        size_t darkPointsCount = 0;
+        for (ElementIndex p = 0; p < expectedLights.size(); ++p)
+        {
+            if (ship.GetPoints().IsDeleted(p))
+                continue;
+
+            float const light = ship.GetPoints().GetLight(p);
+
+            if (expectedLights[p] > VisibilityEpsilon)
+            {
+                // Points have moved slightly since the light was diffused
+                EXPECT_NEAR(expectedLights[p], light, expectedLights[p] * 1e-3f) << "point " << p;
+                ++litPointsCount;
+            }
+            else
+            {
+                EXPECT_LE(light, VisibilityEpsilon) << "point " << p;
+                ++darkPointsCount;
+            }
+        }
+
+        EXPECT_GT(litPointsCount, 0u);
+        EXPECT_GT(darkPointsCount, 0u);
+    }
+};
+
+TEST_F(ShipLightDiffusionTests, MatchesLightFromAllLamps)
+{
+    TestWorld testWorld(MakeGameParameters(0.5f));
+
+    auto ship = MakeLitShip(testWorld);
+
+    testWorld.UpdateShip(*ship, 2);
+
+    ExpectLights(*ship, 0.5f);
+}
+
+TEST_F(ShipLightDiffusionTests, MatchesLightFromAllLampsAfterSplit)
+{
+    TestWorld testWorld(MakeGameParameters(0.5f));
+
+    auto ship = MakeLitShip(testWorld);
+
+    testWorld.UpdateShip(*ship, 2);
+
+    // Cut the ship between the first two lamps, leaving the first one alone
+    // on a small piece, still powered
+    for (int y = 0; y < 8; ++y)
+    {
+        ship->DestroyAt(vec2f(-static_cast<float>(Width / 2) + 6.0f, Altitude + static_cast<float>(y)), 0.6f);
+    }
+
+    testWorld.UpdateShip(*ship, 2);
+
+    ASSERT_EQ(2u, CountConnectedComponentIds(*ship));
+
+    ExpectLights(*ship, 0.5f);
+}
+
+TEST_F(ShipLightDiffusionTests, FullDiffusionLightsWholeConnectedComponents)
+{
+    TestWorld testWorld(MakeGameParameters(1.0f));
+
+    auto ship = MakeLitShip(testWorld);
+
+    testWorld.UpdateShip(*ship, 2);
+
+    for (ElementIndex p = 0; p < ship->GetPoints().GetElementCount(); ++p)
+    {
+        EXPECT_EQ(1.0f, ship->GetPoints().GetLight(p)) << "point " << p;
+    }
+}
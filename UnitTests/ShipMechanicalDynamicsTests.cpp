@@ -0,0 +1,235 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class ShipMechanicalDynamicsTests : public testing::Test
+{
+protected:
+
+    // Makes a beam high above the water, pins its left end, and returns how
+    // much its right end sags on average once it has settled
+    static float CalculateCantileverSag(
+        bool usePositionBasedMechanicalSolver,
+        float stiffnessAdjustment)
+    {
+        static constexpr int Width = 16;
+        static constexpr int Height = 4;
+        static constexpr float Altitude = 50.0f;
+
+        GameParameters gameParameters;
+        gameParameters.WaveHeight = 0.0f;
+        gameParameters.UsePositionBasedMechanicalSolver = usePositionBasedMechanicalSolver;
+        gameParameters.StiffnessAdjustment = stiffnessAdjustment;
+
+        // Small enough that each pin does not see the previous ones
+        gameParameters.ToolSearchRadius = 0.1f;
+
+        TestWorld testWorld(gameParameters);
+
+        auto ship = testWorld.MakeShip(
+            std::vector<std::string>(Height, std::string(Width, 'H')),
+            vec2f(0.0f, Altitude));
+
+        float const leftX = -static_cast<float>(Width / 2);
+        for (int x = 0; x < 2; ++x)
+        {
+            for (int y = 0; y < Height; ++y)
+            {
+                EXPECT_TRUE(ship->TogglePinAt(
+                    vec2f(leftX + static_cast<float>(x), Altitude + static_cast<float>(y)),
+                    gameParameters));
+            }
+        }
+
+        ElementIndex const tipPointIndex = FindPointAt(*ship, vec2f(leftX + static_cast<float>(Width - 1), Altitude));
+
+        testWorld.UpdateShip(*ship, 1000);
+
+        // Average out the residual swinging
+        float totalSag = 0.0f;
+        for (int s = 0; s < 100; ++s)
+        {
+            testWorld.UpdateShip(*ship, 1);
+            totalSag += Altitude - ship->GetPoints().GetPosition(tipPointIndex).y;
+        }
+
+        EXPECT_EQ(1u, CountConnectedComponents(*ship));
+
+        return totalSag / 100.0f;
+    }
+
+    // Makes a block falling from high above the water
+    static std::unique_ptr<Physics::Ship> MakeFallingBlock(TestWorld & testWorld)
+    {
+        return testWorld.MakeShip(
+            std::vector<std::string>(4, std::string(16, 'H')),
+            vec2f(0.0f, 1000.0f));
+    }
+
+    static float GetMechanicalIterationDt(Physics::Ship const & ship)
+    {
+        return ship.GetPoints().GetCurrentMechanicalDynamicsSimulationStepTimeDuration();
+    }
+
+    static constexpr float NominalMechanicalIterationDt = GameParameters::MechanicalDynamicsSimulationStepTimeDuration<float>;
+
+    static constexpr float MinMechanicalIterationsDt =
+        GameParameters::SimulationStepTimeDuration<float> / static_cast<float>(GameParameters::MinNumMechanicalDynamicsIterations);
+};
+
+TEST_F(ShipMechanicalDynamicsTests, PositionBasedMatchesExplicitRigidityAtNominalStiffness)
+{
+    float const explicitSag = CalculateCantileverSag(false, 1.0f);
+    float const positionBasedSag = CalculateCantileverSag(true, 1.0f);
+
+    EXPECT_GT(explicitSag, 0.0f);
+    EXPECT_GT(positionBasedSag, explicitSag * 0.75f);
+    EXPECT_LT(positionBasedSag, explicitSag * 1.25f);
+}
+
+TEST_F(ShipMechanicalDynamicsTests, PositionBasedExceedsExplicitMaxRigidity)
+{
+    float const explicitSag = CalculateCantileverSag(false, GameParameters::MaxStiffnessAdjustment);
+    float const positionBasedSag = CalculateCantileverSag(true, GameParameters::MaxPositionBasedStiffnessAdjustment);
+
+    EXPECT_GT(positionBasedSag, 0.0f);
+    EXPECT_LT(positionBasedSag, explicitSag * 0.75f);
+}
+
+TEST_F(ShipMechanicalDynamicsTests, AdaptiveIterationsDecreaseGraduallyForRelaxedShip)
+{
+    GameParameters gameParameters;
+    gameParameters.DoAdaptMechanicalIterations = true;
+
+    TestWorld testWorld(gameParameters);
+    auto ship = MakeFallingBlock(testWorld);
+
+    // Lowered by one iteration at a time
+    testWorld.UpdateShip(*ship, 30);
+    EXPECT_FLOAT_EQ(
+        GameParameters::SimulationStepTimeDuration<float> / (GameParameters::NumMechanicalDynamicsIterations<float> - 1.0f),
+        GetMechanicalIterationDt(*ship));
+
+    testWorld.UpdateShip(*ship, 500);
+    EXPECT_FLOAT_EQ(MinMechanicalIterationsDt, GetMechanicalIterationDt(*ship));
+}
+
+TEST_F(ShipMechanicalDynamicsTests, AdaptiveIterationsIncreaseAtOnceForStiffShip)
+{
+    GameParameters gameParameters;
+    gameParameters.DoAdaptMechanicalIterations = true;
+
+    TestWorld testWorld(gameParameters);
+    auto ship = MakeFallingBlock(testWorld);
+
+    testWorld.UpdateShip(*ship, 500);
+    ASSERT_FLOAT_EQ(MinMechanicalIterationsDt, GetMechanicalIterationDt(*ship));
+
+    testWorld.GetGameParameters().StiffnessAdjustment = GameParameters::MaxStiffnessAdjustment;
+    testWorld.UpdateShip(*ship, 1);
+
+    EXPECT_FLOAT_EQ(NominalMechanicalIterationDt, GetMechanicalIterationDt(*ship));
+}
+
+TEST_F(ShipMechanicalDynamicsTests, NonAdaptiveIterationsStayNominal)
+{
+    GameParameters gameParameters;
+    gameParameters.DoAdaptMechanicalIterations = false;
+
+    TestWorld testWorld(gameParameters);
+    auto ship = MakeFallingBlock(testWorld);
+
+    testWorld.UpdateShip(*ship, 500);
+
+    EXPECT_FLOAT_EQ(NominalMechanicalIterationDt, GetMechanicalIterationDt(*ship));
+}
+
+TEST_F(ShipMechanicalDynamicsTests, AdaptiveIterationsKeepFallingSpeed)
+{
+    // Gravity and the global damp over a whole step do not depend on the iterations
+    GameParameters gameParameters;
+
+    TestWorld nominalTestWorld(gameParameters);
+    auto nominalShip = MakeFallingBlock(nominalTestWorld);
+    nominalTestWorld.UpdateShip(*nominalShip, 500);
+
+    gameParameters.DoAdaptMechanicalIterations = true;
+
+    TestWorld adaptiveTestWorld(gameParameters);
+    auto adaptiveShip = MakeFallingBlock(adaptiveTestWorld);
+    adaptiveTestWorld.UpdateShip(*adaptiveShip, 500);
+
+    ASSERT_FLOAT_EQ(MinMechanicalIterationsDt, GetMechanicalIterationDt(*adaptiveShip));
+
+    float const nominalDrop = 1000.0f - nominalShip->GetPoints().GetPosition(0).y;
+    float const adaptiveDrop = 1000.0f - adaptiveShip->GetPoints().GetPosition(0).y;
+
+    EXPECT_GT(nominalDrop, 10.0f);
+    EXPECT_NEAR(nominalDrop, adaptiveDrop, nominalDrop * 0.02f);
+}
+
+TEST_F(ShipMechanicalDynamicsTests, FusedIterationsMatchUnfused)
+{
+    // Enough points for several tiles, across the water surface; hull, so that
+    // no water flows in and amplifies the rounding differences
+    auto const rows = std::vector<std::string>(24, std::string(60, 'H'));
+
+    GameParameters gameParameters;
+    gameParameters.DoAdaptMechanicalIterations = false;
+
+    TestWorld unfusedTestWorld(gameParameters);
+    auto unfusedShip = unfusedTestWorld.MakeShip(rows, vec2f(0.0f, -12.0f));
+    unfusedTestWorld.UpdateShip(*unfusedShip, 200);
+
+    gameParameters.UseFusedMechanicalIterations = true;
+
+    TestWorld fusedTestWorld(gameParameters);
+    auto fusedShip = fusedTestWorld.MakeShip(rows, vec2f(0.0f, -12.0f));
+    fusedTestWorld.UpdateShip(*fusedShip, 200);
+
+    auto const unfusedPositions = GetPointPositions(*unfusedShip);
+    auto const fusedPositions = GetPointPositions(*fusedShip);
+    ASSERT_EQ(unfusedPositions.size(), fusedPositions.size());
+    ASSERT_GT(unfusedPositions.size(), 1024u);
+
+    // Springs add up their forces in a different order
+    for (size_t p = 0; p < unfusedPositions.size(); ++p)
+    {
+        EXPECT_NEAR(unfusedPositions[p].x, fusedPositions[p].x, 0.01f);
+        EXPECT_NEAR(unfusedPositions[p].y, fusedPositions[p].y, 0.01f);
+    }
+}
+
+TEST_F(ShipMechanicalDynamicsTests, ParallelSpringForcesMatchSerial)
+{
+    // Enough springs for them to be colored and run in parallel
+    auto const rows = std::vector<std::string>(24, std::string(60, 'H'));
+
+    GameParameters gameParameters;
+    gameParameters.DoAdaptMechanicalIterations = false;
+
+    TestWorld serialTestWorld(gameParameters, std::make_shared<IGameEventHandler>(), 1);
+    auto serialShip = serialTestWorld.MakeShip(rows, vec2f(0.0f, -12.0f));
+    serialTestWorld.UpdateShip(*serialShip, 200);
+
+    TestWorld parallelTestWorld(gameParameters, std::make_shared<IGameEventHandler>(), 4);
+    auto parallelShip = parallelTestWorld.MakeShip(rows, vec2f(0.0f, -12.0f));
+    parallelTestWorld.UpdateShip(*parallelShip, 200);
+
+    ASSERT_GT(parallelShip->GetSprings().GetColorBatchCount(), 0u);
+
+    auto const serialPositions = GetPointPositions(*serialShip);
+    auto const parallelPositions = GetPointPositions(*parallelShip);
+    ASSERT_EQ(serialPositions.size(), parallelPositions.size());
+
+    // Springs add up their forces in a different order
+    for (size_t p = 0; p < serialPositions.size(); ++p)
+    {
+        EXPECT_NEAR(serialPositions[p].x, parallelPositions[p].x, 0.01f);
+        EXPECT_NEAR(serialPositions[p].y, parallelPositions[p].y, 0.01f);
+    }
+}
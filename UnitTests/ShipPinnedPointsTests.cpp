@@ -0,0 +1,64 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+class ShipPinnedPointsTests : public testing::Test
+{
+protected:
+
+    static constexpr float Altitude = 50.0f;
+
+    static GameParameters MakeGameParameters()
+    {
+        GameParameters gameParameters;
+
+        // Small enough that each pin does not see the previous ones
+        gameParameters.ToolSearchRadius = 0.1f;
+
+        return gameParameters;
+    }
+
+    // A lone point, a pair of points, and a block of points
+    static std::vector<std::string> MakeRows()
+    {
+        return std::vector<std::string>({ "H..HH..HHH" });
+    }
+
+    // The position of the point at the specified column
+    static vec2f GetPosition(float column)
+    {
+        return vec2f(-5.0f + column, Altitude);
+    }
+};
+
+TEST_F(ShipPinnedPointsTests, BatchDestructionOnlyUnpinsItsOwnEndpoints)
+{
+    auto const gameParameters = MakeGameParameters();
+    TestWorld testWorld(gameParameters);
+
+    auto ship = testWorld.MakeShip(MakeRows(), vec2f(0.0f, Altitude));
+
+    ElementIndex const lonePointIndex = FindPointAt(*ship, GetPosition(0.0f));
+    ElementIndex const pairPointIndex = FindPointAt(*ship, GetPosition(3.0f));
+    ElementIndex const blockPointIndex = FindPointAt(*ship, GetPosition(9.0f));
+
+    ASSERT_TRUE(ship->GetPoints().GetConnectedSprings(lonePointIndex).empty());
+
+    ASSERT_TRUE(ship->TogglePinAt(GetPosition(0.0f), gameParameters));
+    ASSERT_TRUE(ship->TogglePinAt(GetPosition(3.0f), gameParameters));
+    ASSERT_TRUE(ship->TogglePinAt(GetPosition(9.0f), gameParameters));
+
+    // The other point of the pair, and the first point of the block
+    ship->DestroyAt(GetPosition(4.0f), 0.5f);
+    ship->DestroyAt(GetPosition(7.0f), 0.5f);
+
+    // The pair's point has lost all of its springs
+    EXPECT_FALSE(ship->GetPoints().IsPinned(pairPointIndex));
+
+    // The lone point had no springs already, and the block's point still has springs
+    EXPECT_TRUE(ship->GetPoints().IsPinned(lonePointIndex));
+    EXPECT_TRUE(ship->GetPoints().IsPinned(blockPointIndex));
+}
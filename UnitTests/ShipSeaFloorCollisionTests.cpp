@@ -0,0 +1,108 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+class ShipSeaFloorCollisionTests : public testing::Test
+{
+protected:
+
+    // The x of a valley of the ocean floor, where bodies come to rest rather than sliding away
+    static constexpr float SeaFloorValleyX = -103.7f;
+
+    static GameParameters MakeGameParameters()
+    {
+        GameParameters gameParameters;
+        gameParameters.SeaDepth = 10.0f;
+        gameParameters.WaveHeight = 0.0f;
+
+        return gameParameters;
+    }
+
+    // The lowest height of the ship's points above the floor
+    static float CalculateMinHeightAboveSeaFloor(
+        TestWorld & testWorld,
+        Physics::Ship const & ship)
+    {
+        float minHeight = std::numeric_limits<float>::max();
+        for (auto const & position : GetPointPositions(ship))
+        {
+            minHeight = std::min(
+                minHeight,
+                position.y - testWorld.GetWorld().GetOceanFloorHeightAt(position.x));
+        }
+
+        return minHeight;
+    }
+};
+
+TEST_F(ShipSeaFloorCollisionTests, FastFallingShipLandsOnSeaFloor)
+{
+    TestWorld testWorld(MakeGameParameters());
+
+    // High enough to hit the floor at several points' heights per step
+    auto ship = testWorld.MakeShip(
+        std::vector<std::string>(6, std::string(30, 'H')),
+        vec2f(SeaFloorValleyX, 200.0f));
+
+    bool hasLanded = false;
+    for (int s = 0; s < 1000; ++s)
+    {
+        testWorld.UpdateShip(*ship, 1);
+
+        float const minHeight = CalculateMinHeightAboveSeaFloor(testWorld, *ship);
+        ASSERT_GT(minHeight, -0.5f) << "at step " << s;
+
+        if (minHeight < 0.5f)
+            hasLanded = true;
+    }
+
+    EXPECT_TRUE(hasLanded);
+}
+
+TEST_F(ShipSeaFloorCollisionTests, SplitOffPartsLandOnSeaFloor)
+{
+    TestWorld testWorld(MakeGameParameters());
+
+    auto ship = testWorld.MakeShip(
+        std::vector<std::string>(6, std::string(30, 'H')),
+        vec2f(SeaFloorValleyX, 20.0f));
+
+    // Cut the ship in two halves
+    for (int y = 0; y < 6; ++y)
+    {
+        ship->DestroyAt(vec2f(SeaFloorValleyX, 20.0f + static_cast<float>(y)), 0.6f);
+    }
+
+    for (int s = 0; s < 1000; ++s)
+    {
+        testWorld.UpdateShip(*ship, 1);
+
+        ASSERT_GT(CalculateMinHeightAboveSeaFloor(testWorld, *ship), -0.5f) << "at step " << s;
+    }
+
+    EXPECT_EQ(2u, CountConnectedComponentIds(*ship));
+    EXPECT_LT(CalculateMinHeightAboveSeaFloor(testWorld, *ship), 0.5f);
+}
+
+TEST_F(ShipSeaFloorCollisionTests, MaxSeaFloorHeightIsUpperBound)
+{
+    TestWorld testWorld(MakeGameParameters());
+
+    for (float left = -500.0f; left < 500.0f; left += 37.3f)
+    {
+        for (float width : { 0.1f, 1.0f, 13.0f, 250.0f })
+        {
+            float const maxHeight = testWorld.GetWorld().GetMaxOceanFloorHeightIn(left, left + width);
+
+            for (float x = left; x <= left + width; x += width / 16.0f)
+            {
+                EXPECT_GE(maxHeight, testWorld.GetWorld().GetOceanFloorHeightAt(x));
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+class ShipSleepTests : public testing::Test
+{
+protected:
+
+    // The x of a valley of the ocean floor, where bodies come to rest rather than sliding away
+    static constexpr float SeaFloorValleyX = -103.7f;
+
+    // The height of the floor at the valley, less the sea depth
+    static constexpr float SeaFloorValleyHeight = -6.3f;
+
+    static std::vector<std::string> MakeBlockRows(
+        size_t width,
+        size_t height,
+        char material)
+    {
+        return std::vector<std::string>(height, std::string(width, material));
+    }
+
+    static GameParameters MakeGameParameters(float seaDepth)
+    {
+        GameParameters gameParameters;
+        gameParameters.SeaDepth = seaDepth;
+        gameParameters.WaveHeight = 0.0f;
+
+        return gameParameters;
+    }
+
+    // Updates the ship until none of its points moves during a whole step
+    static bool UpdateUntilAsleep(
+        TestWorld & testWorld,
+        Physics::Ship & ship,
+        int maxStepsCount)
+    {
+        auto previousPositions = GetPointPositions(ship);
+        for (int s = 0; s < maxStepsCount; ++s)
+        {
+            testWorld.UpdateShip(ship, 1);
+
+            auto positions = GetPointPositions(ship);
+            if (positions == previousPositions)
+                return true;
+
+            previousPositions = std::move(positions);
+        }
+
+        return false;
+    }
+};
+
+TEST_F(ShipSleepTests, FallsAsleepOnSeaFloor)
+{
+    TestWorld testWorld(MakeGameParameters(10.0f));
+
+    auto ship = testWorld.MakeShip(
+        MakeBlockRows(30, 6, 'H'),
+        vec2f(SeaFloorValleyX, SeaFloorValleyHeight - 10.0f + 0.5f));
+
+    ASSERT_TRUE(UpdateUntilAsleep(testWorld, *ship, 5000));
+
+    // Stays asleep
+    auto const sleepingPositions = GetPointPositions(*ship);
+    testWorld.UpdateShip(*ship, 100);
+    EXPECT_EQ(sleepingPositions, GetPointPositions(*ship));
+}
+
+TEST_F(ShipSleepTests, FallsAsleepWithFusedMechanicalIterations)
+{
+    auto gameParameters = MakeGameParameters(10.0f);
+    gameParameters.UseFusedMechanicalIterations = true;
+
+    TestWorld testWorld(gameParameters);
+
+    auto ship = testWorld.MakeShip(
+        MakeBlockRows(30, 6, 'H'),
+        vec2f(SeaFloorValleyX, SeaFloorValleyHeight - 10.0f + 0.5f));
+
+    ASSERT_TRUE(UpdateUntilAsleep(testWorld, *ship, 5000));
+}
+
+TEST_F(ShipSleepTests, WakesUpOnGameParameterChange)
+{
+    TestWorld testWorld(MakeGameParameters(10.0f));
+
+    auto ship = testWorld.MakeShip(
+        MakeBlockRows(30, 6, 'H'),
+        vec2f(SeaFloorValleyX, SeaFloorValleyHeight - 10.0f + 0.5f));
+
+    ASSERT_TRUE(UpdateUntilAsleep(testWorld, *ship, 5000));
+
+    auto const sleepingPositions = GetPointPositions(*ship);
+
+    // Lighter water makes the ship heavier
+    testWorld.GetGameParameters().BuoyancyAdjustment = 0.5f;
+    testWorld.UpdateShip(*ship, 2);
+
+    EXPECT_NE(sleepingPositions, GetPointPositions(*ship));
+}
+
+TEST_F(ShipSleepTests, WakesUpWhenPointsCrossWaterSurface)
+{
+    // Shallow enough that the waves reach down to the top of the ship
+    TestWorld testWorld(MakeGameParameters(0.0f));
+
+    auto ship = testWorld.MakeShip(
+        MakeBlockRows(30, 6, 'H'),
+        vec2f(SeaFloorValleyX, SeaFloorValleyHeight + 0.5f));
+
+    ASSERT_TRUE(UpdateUntilAsleep(testWorld, *ship, 5000));
+
+    auto const sleepingPositions = GetPointPositions(*ship);
+
+    // Make waves; the parameter alone does not wake anyone up, but the
+    // moving surface does
+    testWorld.GetGameParameters().WaveHeight = 2.5f;
+    testWorld.UpdateShip(*ship, 2);
+    ASSERT_EQ(sleepingPositions, GetPointPositions(*ship));
+
+    testWorld.UpdateWorld();
+    testWorld.UpdateShip(*ship, 2);
+
+    EXPECT_NE(sleepingPositions, GetPointPositions(*ship));
+}
+
+TEST_F(ShipSleepTests, WakesUpOnDestroy)
+{
+    TestWorld testWorld(MakeGameParameters(10.0f));
+
+    auto ship = testWorld.MakeShip(
+        MakeBlockRows(30, 6, 'H'),
+        vec2f(SeaFloorValleyX, SeaFloorValleyHeight - 10.0f + 0.5f));
+
+    ASSERT_TRUE(UpdateUntilAsleep(testWorld, *ship, 5000));
+
+    auto const sleepingPositions = GetPointPositions(*ship);
+
+    ship->DestroyAt(
+        ship->GetPoints().GetPosition(FindPointAt(*ship, vec2f(SeaFloorValleyX, 0.0f))),
+        1.5f);
+
+    testWorld.UpdateShip(*ship, 2);
+
+    auto const positions = GetPointPositions(*ship);
+    bool isAnySurvivorMoved = false;
+    for (ElementIndex p = 0; p < positions.size(); ++p)
+    {
+        if (!ship->GetPoints().IsDeleted(p) && positions[p] != sleepingPositions[p])
+            isAnySurvivorMoved = true;
+    }
+
+    EXPECT_TRUE(isAnySurvivorMoved);
+}
+
+TEST_F(ShipSleepTests, WakesUpWhenWaterReachesLeaks)
+{
+    // The floor is above the water here, and the leaks of the ship are dry
+    TestWorld testWorld(MakeGameParameters(-7.0f));
+
+    auto ship = testWorld.MakeShip(
+        MakeBlockRows(30, 6, 'I'),
+        vec2f(SeaFloorValleyX, SeaFloorValleyHeight + 7.0f + 0.5f));
+
+    ASSERT_FALSE(ship->GetPoints().GetLeakingPoints().empty());
+
+    ASSERT_TRUE(UpdateUntilAsleep(testWorld, *ship, 5000));
+
+    auto const sleepingWaters = GetPointWaters(*ship);
+
+    // Make waves reaching up to the bottom of the ship
+    testWorld.GetGameParameters().WaveHeight = 2.5f;
+    testWorld.UpdateWorld();
+    testWorld.UpdateShip(*ship, 10);
+
+    EXPECT_NE(sleepingWaters, GetPointWaters(*ship));
+}
@@ -0,0 +1,279 @@
+#include "ShipTestUtils.h"
+
+#include <GameLib/ShipBuilder.h>
+
+#include <picojson/picojson.h>
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <limits>
+#include <set>
+#include <utility>
+
+MaterialDatabase MakeTestMaterials()
+{
+    std::string const materialsJson = R"([
+        {
+            "name": "Iron",
+            "strength": 100.0,
+            "mass": { "nominal_mass": 7950, "density": 0.17 },
+            "structural_colour": "#A0A0A0",
+            "render_colour": "#A0A0A0",
+            "is_hull": false
+        },
+        {
+            "name": "Hull Iron",
+            "strength": 100.0,
+            "mass": { "nominal_mass": 7950, "density": 0.17 },
+            "structural_colour": "#808080",
+            "render_colour": "#808080",
+            "is_hull": true
+        },
+        {
+            "name": "Wood",
+            "strength": 100.0,
+            "mass": { "nominal_mass": 750, "density": 0.5 },
+            "structural_colour": "#C08040",
+            "render_colour": "#C08040",
+            "is_hull": false
+        },
+        {
+            "name": "Rope",
+            "mass": { "nominal_mass": 30, "density": 0.17 },
+            "structural_colour": "#000000",
+            "render_colour": "#000000",
+            "is_hull": true,
+            "is_rope": true
+        },
+        {
+            "name": "Generator",
+            "strength": 100.0,
+            "mass": { "nominal_mass": 900, "density": 0.5 },
+            "structural_colour": "#FC0808",
+            "render_colour": "#FC0808",
+            "is_hull": false,
+            "electrical_properties": { "element_type": "Generator", "is_self_powered": false }
+        },
+        {
+            "name": "Cable",
+            "strength": 100.0,
+            "mass": { "nominal_mass": 30, "density": 0.5 },
+            "structural_colour": "#700000",
+            "render_colour": "#700000",
+            "is_hull": false,
+            "electrical_properties": { "element_type": "Cable", "is_self_powered": false }
+        },
+        {
+            "name": "Lamp",
+            "strength": 100.0,
+            "mass": { "nominal_mass": 30, "density": 0.5 },
+            "structural_colour": "#FFE010",
+            "render_colour": "#404040",
+            "is_hull": false,
+            "electrical_properties": { "element_type": "Lamp", "is_self_powered": false }
+        }
+    ])";
+
+    picojson::value root;
+    std::string const error = picojson::parse(root, materialsJson);
+    EXPECT_TRUE(error.empty());
+
+    return MaterialDatabase::Create(root);
+}
+
+ShipDefinition MakeTestShipDefinition(
+    std::vector<std::string> const & rows,
+    vec2f const & offset)
+{
+    int const width = rows.empty() ? 0 : static_cast<int>(rows[0].size());
+    int const height = static_cast<int>(rows.size());
+
+    auto imageData = std::make_unique<unsigned char[]>(width * height * 3);
+    for (int y = 0; y < height; ++y)
+    {
+        EXPECT_EQ(static_cast<size_t>(width), rows[y].size());
+
+        for (int x = 0; x < width; ++x)
+        {
+            unsigned char const * color;
+            switch (rows[y][x])
+            {
+                case 'I': { static unsigned char const iron[3] = { 0xA0, 0xA0, 0xA0 }; color = iron; break; }
+                case 'H': { static unsigned char const hullIron[3] = { 0x80, 0x80, 0x80 }; color = hullIron; break; }
+                case 'W': { static unsigned char const wood[3] = { 0xC0, 0x80, 0x40 }; color = wood; break; }
+                case 'G': { static unsigned char const generator[3] = { 0xFC, 0x08, 0x08 }; color = generator; break; }
+                case 'C': { static unsigned char const cable[3] = { 0x70, 0x00, 0x00 }; color = cable; break; }
+                case 'L': { static unsigned char const lamp[3] = { 0xFF, 0xE0, 0x10 }; color = lamp; break; }
+                default: { static unsigned char const nothing[3] = { 0xFF, 0xFF, 0xFF }; color = nothing; break; }
+            }
+
+            // Image rows are top row first, like ours
+            std::memcpy(imageData.get() + (y * width + x) * 3, color, 3);
+        }
+    }
+
+    return ShipDefinition(
+        ImageData(width, height, std::unique_ptr<unsigned char const[]>(imageData.release())),
+        std::nullopt,
+        "Test",
+        offset);
+}
+
+TestWorld::TestWorld(
+    GameParameters const & gameParameters,
+    std::shared_ptr<IGameEventHandler> gameEventHandler,
+    std::optional<size_t> parallelism)
+    : mGameParameters(gameParameters)
+    , mMaterials(MakeTestMaterials())
+    , mGameEventHandler(std::move(gameEventHandler))
+    , mWorld(parallelism
+        ? std::make_unique<Physics::World>(mGameEventHandler, mGameParameters, *parallelism)
+        : std::make_unique<Physics::World>(mGameEventHandler, mGameParameters))
+    , mVisitSequenceNumber(1u)
+    , mShipsCount(0)
+{
+}
+
+std::unique_ptr<Physics::Ship> TestWorld::MakeShip(
+    std::vector<std::string> const & rows,
+    vec2f const & offset)
+{
+    return ShipBuilder::Create(
+        mShipsCount++,
+        *mWorld,
+        mGameEventHandler,
+        MakeTestShipDefinition(rows, offset),
+        mMaterials,
+        mGameParameters,
+        mVisitSequenceNumber);
+}
+
+void TestWorld::UpdateShip(
+    Physics::Ship & ship,
+    int stepsCount)
+{
+    for (int s = 0; s < stepsCount; ++s)
+    {
+        ++mVisitSequenceNumber;
+        if (NoneVisitSequenceNumber == mVisitSequenceNumber)
+            mVisitSequenceNumber = 1u;
+
+        ship.Update(mVisitSequenceNumber, mGameParameters);
+    }
+}
+
+void TestWorld::UpdateWorld()
+{
+    // No ships are in the world, hence this only moves the water surface
+    // and the ocean floor
+    mWorld->Update(mGameParameters);
+}
+
+std::vector<vec2f> GetPointPositions(Physics::Ship const & ship)
+{
+    std::vector<vec2f> positions;
+    for (ElementIndex p = 0; p < ship.GetPoints().GetElementCount(); ++p)
+    {
+        positions.push_back(ship.GetPoints().GetPosition(p));
+    }
+
+    return positions;
+}
+
+std::vector<float> GetPointWaters(Physics::Ship const & ship)
+{
+    std::vector<float> waters;
+    for (ElementIndex p = 0; p < ship.GetPoints().GetElementCount(); ++p)
+    {
+        waters.push_back(ship.GetPoints().GetWater(p));
+    }
+
+    return waters;
+}
+
+std::vector<vec2f> GetPointWaterVelocities(Physics::Ship & ship)
+{
+    vec2f const * const waterVelocityBuffer = ship.GetPoints().GetWaterVelocityBufferAsVec2();
+
+    return std::vector<vec2f>(
+        waterVelocityBuffer,
+        waterVelocityBuffer + ship.GetPoints().GetElementCount());
+}
+
+size_t CountConnectedComponentIds(Physics::Ship const & ship)
+{
+    std::set<ConnectedComponentId> connectedComponentIds;
+    for (ElementIndex p = 0; p < ship.GetPoints().GetElementCount(); ++p)
+    {
+        if (!ship.GetPoints().IsDeleted(p))
+        {
+            connectedComponentIds.insert(ship.GetPoints().GetConnectedComponentId(p));
+        }
+    }
+
+    return connectedComponentIds.size();
+}
+
+size_t CountConnectedComponents(Physics::Ship const & ship)
+{
+    auto const & points = ship.GetPoints();
+    auto const & springs = ship.GetSprings();
+
+    std::vector<bool> isVisited(points.GetElementCount(), false);
+    std::vector<ElementIndex> pointsToVisit;
+
+    size_t connectedComponentsCount = 0;
+    for (ElementIndex p = 0; p < points.GetElementCount(); ++p)
+    {
+        if (!points.IsDeleted(p) && !isVisited[p])
+        {
+            ++connectedComponentsCount;
+
+            isVisited[p] = true;
+            pointsToVisit.push_back(p);
+            while (!pointsToVisit.empty())
+            {
+                ElementIndex const pointIndex = pointsToVisit.back();
+                pointsToVisit.pop_back();
+
+                for (auto const springIndex : points.GetConnectedSprings(pointIndex))
+                {
+                    if (!springs.IsDeleted(springIndex))
+                    {
+                        ElementIndex const otherPointIndex = springs.GetOtherEndpointIndex(springIndex, pointIndex);
+                        if (!isVisited[otherPointIndex])
+                        {
+                            isVisited[otherPointIndex] = true;
+                            pointsToVisit.push_back(otherPointIndex);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return connectedComponentsCount;
+}
+
+ElementIndex FindPointAt(
+    Physics::Ship const & ship,
+    vec2f const & position)
+{
+    ElementIndex bestPointIndex = NoneElementIndex;
+    float bestSquareDistance = std::numeric_limits<float>::max();
+    for (ElementIndex p = 0; p < ship.GetPoints().GetElementCount(); ++p)
+    {
+        if (!ship.GetPoints().IsDeleted(p))
+        {
+            float const squareDistance = (ship.GetPoints().GetPosition(p) - position).squareLength();
+            if (squareDistance < bestSquareDistance)
+            {
+                bestPointIndex = p;
+                bestSquareDistance = squareDistance;
+            }
+        }
+    }
+
+    return bestPointIndex;
+}
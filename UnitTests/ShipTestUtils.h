@@ -0,0 +1,104 @@
+#pragma once
+
+#include <GameLib/GameParameters.h>
+#include <GameLib/IGameEventHandler.h>
+#include <GameLib/MaterialDatabase.h>
+#include <GameLib/Physics.h>
+#include <GameLib/ShipDefinition.h>
+#include <GameLib/Vectors.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*
+ * Makes the materials that test ships are made of.
+ */
+MaterialDatabase MakeTestMaterials();
+
+/*
+ * Makes the definition of a test ship out of rows of characters, top row first,
+ * one character per point:
+ *  '.': nothing
+ *  'I': iron, non-hull (leaks once its springs break)
+ *  'H': iron, hull
+ *  'W': wood, non-hull (floats)
+ *  'G': generator
+ *  'C': cable
+ *  'L': lamp
+ *
+ * The bottom row of the ship is at the offset's y, and the ship is centered
+ * around the offset's x.
+ */
+ShipDefinition MakeTestShipDefinition(
+    std::vector<std::string> const & rows,
+    vec2f const & offset);
+
+/*
+ * A world where test ships are built and updated.
+ *
+ * Test ships are not added to the world, so that they may be updated on their own
+ * and inspected via their points; the world is only updated - hence its water surface
+ * only moves - when explicitly requested.
+ */
+class TestWorld
+{
+public:
+
+    // Without a parallelism, ship tasks run on as many threads as there are hardware threads
+    explicit TestWorld(
+        GameParameters const & gameParameters,
+        std::shared_ptr<IGameEventHandler> gameEventHandler = std::make_shared<IGameEventHandler>(),
+        std::optional<size_t> parallelism = std::nullopt);
+
+    std::unique_ptr<Physics::Ship> MakeShip(
+        std::vector<std::string> const & rows,
+        vec2f const & offset);
+
+    void UpdateShip(
+        Physics::Ship & ship,
+        int stepsCount);
+
+    void UpdateWorld();
+
+    GameParameters & GetGameParameters()
+    {
+        return mGameParameters;
+    }
+
+    Physics::World & GetWorld()
+    {
+        return *mWorld;
+    }
+
+private:
+
+    GameParameters mGameParameters;
+    MaterialDatabase mMaterials;
+    std::shared_ptr<IGameEventHandler> mGameEventHandler;
+    std::unique_ptr<Physics::World> mWorld;
+    VisitSequenceNumber mVisitSequenceNumber;
+    int mShipsCount;
+};
+
+//
+// Inspection helpers
+//
+
+std::vector<vec2f> GetPointPositions(Physics::Ship const & ship);
+
+std::vector<float> GetPointWaters(Physics::Ship const & ship);
+
+std::vector<vec2f> GetPointWaterVelocities(Physics::Ship & ship);
+
+// The number of distinct connected component IDs of the non-deleted points
+size_t CountConnectedComponentIds(Physics::Ship const & ship);
+
+// The number of groups of non-deleted points that are connected via non-deleted springs
+size_t CountConnectedComponents(Physics::Ship const & ship);
+
+// The index of the non-deleted point nearest to the specified position
+ElementIndex FindPointAt(
+    Physics::Ship const & ship,
+    vec2f const & position);
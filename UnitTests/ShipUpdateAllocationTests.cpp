@@ -0,0 +1,210 @@
+#include "ShipTestUtils.h"
+
+#include <GameLib/GameEventDispatcher.h>
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+//
+// Counts the allocations made via the operators new while counting is on. The
+// array and nothrow operators new of the standard library end up in the plain
+// one, while the aligned ones do not, hence the latter are replaced too.
+//
+// All blocks, aligned or not, come from the same allocator, which remembers the
+// underlying allocation right before each block; the operators delete thus
+// always free what the operators new have allocated.
+//
+
+static std::atomic<bool> IsCountingAllocations(false);
+static std::atomic<size_t> AllocationsCount(0);
+
+static void * Allocate(
+    std::size_t size,
+    std::size_t alignment)
+{
+    if (IsCountingAllocations)
+        ++AllocationsCount;
+
+    void * const allocation = std::malloc(size + alignment + sizeof(void *));
+    if (nullptr == allocation)
+        throw std::bad_alloc();
+
+    std::uintptr_t const alignedAddress =
+        (reinterpret_cast<std::uintptr_t>(allocation) + sizeof(void *) + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+    void ** const ptr = reinterpret_cast<void **>(alignedAddress);
+    ptr[-1] = allocation;
+
+    return ptr;
+}
+
+static void Deallocate(void * ptr) noexcept
+{
+    if (nullptr != ptr)
+        std::free(static_cast<void **>(ptr)[-1]);
+}
+
+void * operator new(std::size_t size)
+{
+    return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void * operator new[](std::size_t size)
+{
+    return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void * operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void * operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void * ptr) noexcept
+{
+    Deallocate(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+    Deallocate(ptr);
+}
+
+void operator delete(void * ptr, std::size_t /*size*/) noexcept
+{
+    Deallocate(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t /*size*/) noexcept
+{
+    Deallocate(ptr);
+}
+
+void operator delete(void * ptr, std::align_val_t /*alignment*/) noexcept
+{
+    Deallocate(ptr);
+}
+
+void operator delete[](void * ptr, std::align_val_t /*alignment*/) noexcept
+{
+    Deallocate(ptr);
+}
+
+void operator delete(void * ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    Deallocate(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+    Deallocate(ptr);
+}
+
+class ShipUpdateAllocationTests : public testing::Test
+{
+protected:
+
+    static constexpr int Width = 32;
+    static constexpr int Height = 12;
+
+    // Half under water
+    static constexpr float Altitude = -6.0f;
+
+    // A block of iron, with a generator powering a lamp via a cable along one row
+    static std::vector<std::string> MakeRows()
+    {
+        std::vector<std::string> rows(Height, std::string(Width, 'I'));
+        rows[3] = "II" "G" + std::string(Width - 6, 'C') + "L" "II";
+
+        return rows;
+    }
+
+    ShipUpdateAllocationTests()
+        : mGameEventSink()
+        , mGameEventDispatcher(std::make_shared<GameEventDispatcher>())
+        , mTestWorld(GameParameters(), mGameEventDispatcher, 4) // Several threads, so that the water flow runs in parallel tasks
+    {
+        mGameEventDispatcher->RegisterSink(&mGameEventSink);
+    }
+
+    // Updates the ship and flushes its events at each step, as the game does
+    void UpdateShip(
+        Physics::Ship & ship,
+        int stepsCount)
+    {
+        for (int s = 0; s < stepsCount; ++s)
+        {
+            mTestWorld.UpdateShip(ship, 1);
+            mGameEventDispatcher->Flush();
+        }
+    }
+
+    size_t CountAllocations(
+        Physics::Ship & ship,
+        int stepsCount)
+    {
+        AllocationsCount = 0;
+        IsCountingAllocations = true;
+
+        UpdateShip(ship, stepsCount);
+
+        IsCountingAllocations = false;
+
+        return AllocationsCount.load();
+    }
+
+    IGameEventHandler mGameEventSink;
+    std::shared_ptr<GameEventDispatcher> mGameEventDispatcher;
+    TestWorld mTestWorld;
+};
+
+TEST_F(ShipUpdateAllocationTests, UpdateDoesNotAllocateOnceWarmedUp)
+{
+    auto ship = mTestWorld.MakeShip(MakeRows(), vec2f(0.0f, Altitude));
+
+    ASSERT_EQ(4u, mTestWorld.GetWorld().GetTaskThreadPool().GetParallelism());
+
+    // Warm up, running through all update periods a few times
+    UpdateShip(*ship, 100);
+
+    EXPECT_EQ(0u, CountAllocations(*ship, 100));
+}
+
+TEST_F(ShipUpdateAllocationTests, UpdateDoesNotAllocateOnceWarmedUpAfterBreaks)
+{
+    auto ship = mTestWorld.MakeShip(MakeRows(), vec2f(0.0f, Altitude));
+
+    // Cut the ship in two halves, through the cable, making leaks under water
+    for (int y = 0; y < Height; ++y)
+    {
+        ship->DestroyAt(vec2f(0.0f, Altitude + static_cast<float>(y)), 0.6f);
+    }
+
+    // Warm up, letting the water in and running through all update periods a few times
+    UpdateShip(*ship, 300);
+
+    EXPECT_EQ(2u, CountConnectedComponentIds(*ship));
+    EXPECT_FALSE(ship->GetPoints().GetLeakingPoints().empty());
+
+    size_t wetPointsCount = 0;
+    for (auto const water : GetPointWaters(*ship))
+    {
+        if (water > 0.0f)
+            ++wetPointsCount;
+    }
+
+    EXPECT_GT(wetPointsCount, 0u);
+
+    EXPECT_EQ(0u, CountAllocations(*ship, 100));
+}
@@ -0,0 +1,146 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class ShipUpdatePeriodsTests : public testing::Test
+{
+protected:
+
+    static GameParameters MakeGameParameters(
+        int waterDynamicsUpdatePeriod,
+        int electricalDynamicsUpdatePeriod)
+    {
+        GameParameters gameParameters;
+        gameParameters.WaveHeight = 0.0f;
+        gameParameters.WaterDynamicsUpdatePeriod = waterDynamicsUpdatePeriod;
+        gameParameters.ElectricalDynamicsUpdatePeriod = electricalDynamicsUpdatePeriod;
+
+        return gameParameters;
+    }
+
+    // A leaky ship with its bottom rows under water
+    static std::unique_ptr<Physics::Ship> MakeFloodingShip(TestWorld & testWorld)
+    {
+        return testWorld.MakeShip(
+            std::vector<std::string>(8, std::string(16, 'I')),
+            vec2f(0.0f, -2.0f));
+    }
+
+    static float CalculateTotalWater(Physics::Ship const & ship)
+    {
+        float totalWater = 0.0f;
+        for (float water : GetPointWaters(ship))
+            totalWater += water;
+
+        return totalWater;
+    }
+
+    // Updates the ship one step at a time, telling for each step whether its water has changed
+    static std::vector<bool> UpdateAndTrackWaterChanges(
+        TestWorld & testWorld,
+        Physics::Ship & ship,
+        int stepsCount)
+    {
+        std::vector<bool> hasWaterChanged;
+
+        auto previousWaters = GetPointWaters(ship);
+        for (int s = 0; s < stepsCount; ++s)
+        {
+            testWorld.UpdateShip(ship, 1);
+
+            auto waters = GetPointWaters(ship);
+            hasWaterChanged.push_back(waters != previousWaters);
+            previousWaters = std::move(waters);
+        }
+
+        return hasWaterChanged;
+    }
+};
+
+TEST_F(ShipUpdatePeriodsTests, WaterDynamicsRunOncePerPeriod)
+{
+    TestWorld testWorld(MakeGameParameters(3, 1));
+
+    auto ship = MakeFloodingShip(testWorld);
+
+    auto const hasWaterChanged = UpdateAndTrackWaterChanges(testWorld, *ship, 30);
+
+    for (size_t s = 0; s < hasWaterChanged.size(); ++s)
+    {
+        EXPECT_EQ(0 == s % 3, hasWaterChanged[s]) << "at step " << s;
+    }
+}
+
+TEST_F(ShipUpdatePeriodsTests, ShipsRunWaterDynamicsAtDifferentSteps)
+{
+    TestWorld testWorld(MakeGameParameters(2, 1));
+
+    auto ship1 = MakeFloodingShip(testWorld);
+    auto ship2 = MakeFloodingShip(testWorld);
+
+    auto previousWaters1 = GetPointWaters(*ship1);
+    auto previousWaters2 = GetPointWaters(*ship2);
+    for (int s = 0; s < 20; ++s)
+    {
+        testWorld.UpdateShip(*ship1, 1);
+        testWorld.UpdateShip(*ship2, 1);
+
+        auto waters1 = GetPointWaters(*ship1);
+        auto waters2 = GetPointWaters(*ship2);
+
+        // One or the other
+        EXPECT_NE(waters1 != previousWaters1, waters2 != previousWaters2) << "at step " << s;
+
+        previousWaters1 = std::move(waters1);
+        previousWaters2 = std::move(waters2);
+    }
+}
+
+TEST_F(ShipUpdatePeriodsTests, WaterDynamicsTakeInAsMuchWaterAtLongerPeriods)
+{
+    auto const floodShip = [](int waterDynamicsUpdatePeriod)
+    {
+        TestWorld testWorld(MakeGameParameters(waterDynamicsUpdatePeriod, 1));
+
+        auto ship = MakeFloodingShip(testWorld);
+
+        testWorld.UpdateShip(*ship, 40);
+
+        return CalculateTotalWater(*ship);
+    };
+
+    float const everyStepWater = floodShip(1);
+    float const everyFourStepsWater = floodShip(4);
+
+    ASSERT_GT(everyStepWater, 1.0f);
+    EXPECT_NEAR(everyStepWater, everyFourStepsWater, everyStepWater * 0.25f);
+}
+
+TEST_F(ShipUpdatePeriodsTests, ElectricalDynamicsRunOncePerPeriod)
+{
+    TestWorld testWorld(MakeGameParameters(1, 4));
+
+    // A generator powering a lamp, high above the water
+    auto ship = testWorld.MakeShip(
+        std::vector<std::string>({
+            "IIIIIIII",
+            "GCCCCCCL",
+            "IIIIIIII" }),
+        vec2f(0.0f, 100.0f));
+
+    ElementIndex const lampPointIndex = FindPointAt(*ship, vec2f(3.0f, 101.0f));
+
+    // The first electrical update of the first ship is at its fourth step
+    for (int s = 0; s < 3; ++s)
+    {
+        testWorld.UpdateShip(*ship, 1);
+        EXPECT_EQ(0.0f, ship->GetPoints().GetLight(lampPointIndex)) << "at step " << s;
+    }
+
+    testWorld.UpdateShip(*ship, 1);
+    EXPECT_LT(0.0f, ship->GetPoints().GetLight(lampPointIndex));
+}
@@ -0,0 +1,220 @@
+#include "ShipTestUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ShipWaterDynamicsTests : public testing::Test
+{
+protected:
+
+    class WaterSplashRecorder : public IGameEventHandler
+    {
+    public:
+
+        virtual void OnWaterSplashed(float waterSplashed) override
+        {
+            TotalWaterSplashed += waterSplashed;
+        }
+
+        float TotalWaterSplashed = 0.0f;
+    };
+
+    enum class WaterFlow
+    {
+        PointCentric,
+        EdgeCentric,
+        Parallel
+    };
+
+    static void SetWaterFlow(
+        GameParameters & gameParameters,
+        WaterFlow waterFlow)
+    {
+        gameParameters.UseEdgeCentricWaterFlow = (waterFlow != WaterFlow::PointCentric);
+        gameParameters.UseParallelWaterFlow = (waterFlow == WaterFlow::Parallel);
+    }
+
+    struct WaterState
+    {
+        std::vector<float> Waters;
+        std::vector<vec2f> WaterVelocities;
+        float WaterSplashed;
+    };
+
+    // Floods a leaky ship half in the water with the point-centric flow, and then
+    // runs the specified flow for a few steps
+    static WaterState RunFloodedShip(
+        WaterFlow waterFlow,
+        size_t parallelism)
+    {
+        GameParameters gameParameters;
+        gameParameters.WaveHeight = 0.0f;
+        gameParameters.WaterDynamicsUpdatePeriod = 1;
+        SetWaterFlow(gameParameters, WaterFlow::PointCentric);
+
+        auto waterSplashRecorder = std::make_shared<WaterSplashRecorder>();
+        TestWorld testWorld(gameParameters, waterSplashRecorder, parallelism);
+
+        // Non-hull, hence leaking all around; large enough for the parallel flow
+        // to split its points in a few chunks
+        std::vector<std::string> const rows(24, std::string(48, 'I'));
+
+        auto ship = testWorld.MakeShip(rows, vec2f(0.0f, -12.0f));
+
+        testWorld.UpdateShip(*ship, 100);
+
+        SetWaterFlow(testWorld.GetGameParameters(), waterFlow);
+        waterSplashRecorder->TotalWaterSplashed = 0.0f;
+
+        testWorld.UpdateShip(*ship, 3);
+
+        return WaterState{
+            GetPointWaters(*ship),
+            GetPointWaterVelocities(*ship),
+            waterSplashRecorder->TotalWaterSplashed };
+    }
+
+    static void ExpectNear(
+        WaterState const & expected,
+        WaterState const & actual)
+    {
+        ASSERT_EQ(expected.Waters.size(), actual.Waters.size());
+
+        for (size_t p = 0; p < expected.Waters.size(); ++p)
+        {
+            EXPECT_NEAR(expected.Waters[p], actual.Waters[p], 1e-4f * std::max(1.0f, expected.Waters[p]));
+
+            // The momenta each point ends up with, once back to velocities
+            float const velocityTolerance = 1e-3f * std::max(1.0f, expected.WaterVelocities[p].length());
+            EXPECT_NEAR(expected.WaterVelocities[p].x, actual.WaterVelocities[p].x, velocityTolerance);
+            EXPECT_NEAR(expected.WaterVelocities[p].y, actual.WaterVelocities[p].y, velocityTolerance);
+        }
+
+        EXPECT_NEAR(expected.WaterSplashed, actual.WaterSplashed, 1e-3f * std::max(1.0f, expected.WaterSplashed));
+    }
+};
+
+TEST_F(ShipWaterDynamicsTests, WaterFlowsAgree)
+{
+    // The same parallelism for all, as it also drives the mechanical layout of the ship
+    WaterState const pointCentric = RunFloodedShip(WaterFlow::PointCentric, 4);
+    WaterState const edgeCentric = RunFloodedShip(WaterFlow::EdgeCentric, 4);
+    WaterState const parallel = RunFloodedShip(WaterFlow::Parallel, 4);
+
+    // Make sure there's water to move
+    float totalWater = 0.0f;
+    for (float water : pointCentric.Waters)
+        totalWater += water;
+
+    ASSERT_GT(totalWater, 1.0f);
+    ASSERT_GT(pointCentric.WaterSplashed, 0.0f);
+
+    ExpectNear(pointCentric, edgeCentric);
+    ExpectNear(pointCentric, parallel);
+}
+
+TEST_F(ShipWaterDynamicsTests, ParallelFlowFallsBackToEdgeCentricOnOneThread)
+{
+    WaterState const edgeCentric = RunFloodedShip(WaterFlow::EdgeCentric, 1);
+    WaterState const parallel = RunFloodedShip(WaterFlow::Parallel, 1);
+
+    EXPECT_EQ(edgeCentric.Waters, parallel.Waters);
+    EXPECT_EQ(edgeCentric.WaterVelocities, parallel.WaterVelocities);
+    EXPECT_EQ(edgeCentric.WaterSplashed, parallel.WaterSplashed);
+}
+
+TEST_F(ShipWaterDynamicsTests, ParallelFlowDoesNotDependOnThreadCount)
+{
+    WaterState const parallelOnTwoThreads = RunFloodedShip(WaterFlow::Parallel, 2);
+    WaterState const parallelOnFourThreads = RunFloodedShip(WaterFlow::Parallel, 4);
+
+    EXPECT_EQ(parallelOnTwoThreads.Waters, parallelOnFourThreads.Waters);
+    EXPECT_EQ(parallelOnTwoThreads.WaterVelocities, parallelOnFourThreads.WaterVelocities);
+    EXPECT_EQ(parallelOnTwoThreads.WaterSplashed, parallelOnFourThreads.WaterSplashed);
+}
+
+TEST_F(ShipWaterDynamicsTests, WetFrontFlowMatchesFlowOverAllPoints)
+{
+    // Floods a dry ship with both the point-centric flow, which visits all points, 
+    // and the edge-centric flow, which only visits the wet front as it grows
+    auto const floodDryShip = [](WaterFlow waterFlow)
+    {
+        GameParameters gameParameters;
+        gameParameters.WaveHeight = 0.0f;
+        gameParameters.WaterDynamicsUpdatePeriod = 1;
+        SetWaterFlow(gameParameters, waterFlow);
+
+        TestWorld testWorld(gameParameters, std::make_shared<IGameEventHandler>(), 1);
+
+        // Only the bottom rows are under water, and water has to spread up from there
+        std::vector<std::string> const rows(12, std::string(32, 'I'));
+
+        auto ship = testWorld.MakeShip(rows, vec2f(0.0f, -2.0f));
+
+        testWorld.UpdateShip(*ship, 10);
+
+        return GetPointWaters(*ship);
+    };
+
+    auto const allPointsWaters = floodDryShip(WaterFlow::PointCentric);
+    auto const wetFrontWaters = floodDryShip(WaterFlow::EdgeCentric);
+
+    ASSERT_EQ(allPointsWaters.size(), wetFrontWaters.size());
+
+    size_t wetPointsCount = 0;
+    for (size_t p = 0; p < allPointsWaters.size(); ++p)
+    {
+        // The two flows round differently, and differences pile up while flooding
+        EXPECT_NEAR(allPointsWaters[p], wetFrontWaters[p], 1e-3f * std::max(1.0f, allPointsWaters[p]));
+
+        // Water reaches the same points
+        EXPECT_EQ(allPointsWaters[p] != 0.0f, wetFrontWaters[p] != 0.0f);
+
+        if (allPointsWaters[p] != 0.0f)
+            ++wetPointsCount;
+    }
+
+    // The water has reached some points but not all, hence the wet front has grown
+    // without covering the whole ship
+    EXPECT_GT(wetPointsCount, 32u);
+    EXPECT_LT(wetPointsCount, allPointsWaters.size());
+}
+
+TEST_F(ShipWaterDynamicsTests, WaterBuffersStayInSync)
+{
+    for (WaterFlow waterFlow : { WaterFlow::PointCentric, WaterFlow::EdgeCentric, WaterFlow::Parallel })
+    {
+        GameParameters gameParameters;
+        gameParameters.WaveHeight = 0.0f;
+        gameParameters.WaterDynamicsUpdatePeriod = 1;
+        SetWaterFlow(gameParameters, waterFlow);
+
+        TestWorld testWorld(gameParameters, std::make_shared<IGameEventHandler>(), 4);
+
+        // Flooding from the bottom rows up, so that the wet front grows
+        std::vector<std::string> const rows(12, std::string(32, 'I'));
+
+        auto ship = testWorld.MakeShip(rows, vec2f(0.0f, -2.0f));
+
+        for (int s = 0; s < 20; ++s)
+        {
+            testWorld.UpdateShip(*ship, 1);
+
+            // The buffer that the next step writes into starts off with the current water
+            auto const waters = GetPointWaters(*ship);
+            float const * const newWaters = ship->GetPoints().GetNewWaterBufferAsFloat();
+            for (size_t p = 0; p < waters.size(); ++p)
+            {
+                ASSERT_EQ(waters[p], newWaters[p])
+                    << "flow " << static_cast<int>(waterFlow) << ", step " << s << ", point " << p;
+            }
+        }
+
+        auto const waters = GetPointWaters(*ship);
+        EXPECT_GT(std::count_if(waters.begin(), waters.end(), [](float water) { return water > 0.0f; }), 32);
+    }
+}
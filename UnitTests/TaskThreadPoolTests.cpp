@@ -0,0 +1,79 @@
+#include <GameLib/TaskThreadPool.h>
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <vector>
+
+TEST(TaskThreadPoolTests, RunsAllTasks)
+{
+    TaskThreadPool pool(4);
+
+    EXPECT_EQ(4u, pool.GetParallelism());
+
+    std::vector<int> results(17, 0);
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        tasks.emplace_back(
+            [&results, t]()
+            {
+                results[t] = static_cast<int>(t) + 1;
+            });
+    }
+
+    pool.Run(tasks);
+
+    for (size_t t = 0; t < results.size(); ++t)
+    {
+        EXPECT_EQ(static_cast<int>(t) + 1, results[t]);
+    }
+}
+
+TEST(TaskThreadPoolTests, RunsBatchesRepeatedly)
+{
+    TaskThreadPool pool(3);
+
+    std::atomic<int> counter(0);
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (int t = 0; t < 5; ++t)
+    {
+        tasks.emplace_back(
+            [&counter]()
+            {
+                ++counter;
+            });
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        pool.Run(tasks);
+
+        EXPECT_EQ((i + 1) * 5, counter.load());
+    }
+}
+
+TEST(TaskThreadPoolTests, SingleThread)
+{
+    TaskThreadPool pool(1);
+
+    EXPECT_EQ(1u, pool.GetParallelism());
+
+    int counter = 0;
+
+    std::vector<TaskThreadPool::Task> tasks;
+    for (int t = 0; t < 3; ++t)
+    {
+        tasks.emplace_back(
+            [&counter]()
+            {
+                ++counter;
+            });
+    }
+
+    pool.Run(tasks);
+
+    EXPECT_EQ(3, counter);
+}